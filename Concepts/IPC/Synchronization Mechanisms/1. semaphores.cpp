@@ -11,6 +11,8 @@
 #include <chrono>
 #include <vector>
 #include <random>
+#include <atomic>
+#include <cstdint>
 
 // Shared data structure for demonstration
 struct SharedResource {
@@ -271,6 +273,10 @@ private:
     SemaphoreManager* read_count_mutex_; // Protect reader count
     SharedResource* shared_data_;
     int* reader_count_;
+    std::atomic<uint32_t>* sequence_;  // Odd while a writer is mid-update
+    
+    static constexpr size_t kSegmentSize = 
+        sizeof(SharedResource) + sizeof(int) + sizeof(std::atomic<uint32_t>);
 
 public:
     ReadersWriters() {
@@ -279,18 +285,21 @@ public:
         
         // Create shared memory for data and reader count
         int shm_fd = shm_open("/readers_writers_data", O_CREAT | O_RDWR, 0666);
-        ftruncate(shm_fd, sizeof(SharedResource) + sizeof(int));
+        ftruncate(shm_fd, kSegmentSize);
         
-        void* shared_mem = mmap(0, sizeof(SharedResource) + sizeof(int), 
+        void* shared_mem = mmap(0, kSegmentSize, 
                                PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
         
         shared_data_ = static_cast<SharedResource*>(shared_mem);
         reader_count_ = reinterpret_cast<int*>(
             static_cast<char*>(shared_mem) + sizeof(SharedResource));
+        sequence_ = reinterpret_cast<std::atomic<uint32_t>*>(
+            static_cast<char*>(shared_mem) + sizeof(SharedResource) + sizeof(int));
         
         if (shared_data_ != MAP_FAILED) {
             new (shared_data_) SharedResource();
             *reader_count_ = 0;
+            new (sequence_) std::atomic<uint32_t>(0);
         }
     }
     
@@ -299,7 +308,7 @@ public:
         delete read_count_mutex_;
         
         if (shared_data_ && shared_data_ != MAP_FAILED) {
-            munmap(shared_data_, sizeof(SharedResource) + sizeof(int));
+            munmap(shared_data_, kSegmentSize);
         }
         shm_unlink("/readers_writers_data");
     }
@@ -329,15 +338,42 @@ public:
         read_count_mutex_->post();
     }
     
+    // Seqlock reader: copies a snapshot without touching either semaphore or
+    // the shared reader count, so readers never make each other wait or
+    // bounce a cache line. It retries if a writer was active during the copy.
+    void optimisticReader(int reader_id) {
+        SharedResource snapshot;
+        int retries = 0;
+        for (;; ++retries) {
+            uint32_t before = sequence_->load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();  // Writer mid-update
+                continue;
+            }
+            memcpy(&snapshot, shared_data_, sizeof(snapshot));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_->load(std::memory_order_relaxed) == before) break;
+        }
+        
+        std::cout << "Optimistic reader " << reader_id << " read: counter=" 
+                  << snapshot.counter << ", buffer=" << snapshot.buffer 
+                  << " (" << retries << " retries)" << std::endl;
+        
+        std::this_thread::sleep_for(std::chrono::milliseconds(200 + rand() % 300));
+    }
+    
     void writer(int writer_id) {
         // Entry section
         write_mutex_->wait();
         
-        // Critical section - writing
+        // Critical section - writing. The sequence is odd while the data is
+        // half-written, which tells optimistic readers to retry.
+        sequence_->fetch_add(1, std::memory_order_acq_rel);
         shared_data_->counter++;
         snprintf(shared_data_->buffer, sizeof(shared_data_->buffer), 
                 "Data written by writer %d (PID %d)", writer_id, getpid());
         shared_data_->last_writer = getpid();
+        sequence_->fetch_add(1, std::memory_order_release);
         
         std::cout << "Writer " << writer_id << " wrote: " << shared_data_->buffer << std::endl;
         
@@ -475,6 +511,18 @@ void demonstrateReadersWriters() {
         }
     }
     
+    // An optimistic (seqlock) reader alongside the semaphore readers
+    pid_t optimistic = fork();
+    if (optimistic == 0) {
+        for (int j = 0; j < 3; ++j) {
+            rw.optimisticReader(4);
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        }
+        exit(0);
+    } else if (optimistic > 0) {
+        children.push_back(optimistic);
+    }
+    
     for (int i = 0; i < 2; ++i) {
         pid_t pid = fork();
         if (pid == 0) {
@@ -544,6 +592,7 @@ int main() {
     std::cout << "3. POSIX semaphores - named (/name) or unnamed\n";
     std::cout << "4. Operations: wait (P), post (V), try_wait, timed_wait\n";
     std::cout << "5. Perfect for producer-consumer and readers-writers problems\n";
+    std::cout << "6. Read-mostly data: seqlock readers skip the semaphores entirely\n";
     
     return 0;
 }
@@ -12,6 +12,17 @@
 #include <vector>
 #include <random>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <climits>
+#include <cstdint>
+#include <cerrno>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <cstdio>
 
 // Shared data structure for demonstration
 struct SharedResource {
@@ -336,6 +347,348 @@ public:
     }
 };
 
+// =============================================================================
+// FUTEX-BASED SHARED-MEMORY LOCKS
+// =============================================================================
+
+// The classes below are plain words of memory, placement-constructed inside
+// a shared mapping. An uncontended lock/unlock is one atomic each, with no
+// system call; the futex syscall runs only when a thread has to sleep or wake
+// a sleeper. The futexes are not FUTEX_PRIVATE, so the kernel keys them on
+// the physical page and they work across processes.
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Returns false only on timeout; EAGAIN (value changed) and EINTR count as a wake
+inline bool futexWait(std::atomic<uint32_t>* word, uint32_t expected, int timeout_ms) {
+    struct timespec timeout{timeout_ms / 1000, (timeout_ms % 1000) * 1000000L};
+    long result = syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected,
+                          timeout_ms < 0 ? nullptr : &timeout, nullptr, 0);
+    return !(result == -1 && errno == ETIMEDOUT);
+}
+
+inline void futexWake(std::atomic<uint32_t>* word, int count) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, count, nullptr, nullptr, 0);
+}
+
+// Kernel thread id, cached per thread. fork() copies the cache into the
+// child, so the child handler clears it.
+thread_local uint32_t t_cached_tid = 0;
+
+inline uint32_t currentTid() {
+    static const int registered = pthread_atfork(nullptr, nullptr, [] { t_cached_tid = 0; });
+    (void)registered;
+    if (t_cached_tid == 0) t_cached_tid = static_cast<uint32_t>(syscall(SYS_gettid));
+    return t_cached_tid;
+}
+
+// A thread has gone once /proc/<tid> disappears or shows a zombie. This
+// matters because a dead process is a zombie until its parent reaps it.
+inline bool threadAlive(uint32_t tid) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%u/stat", tid);
+    FILE* file = fopen(path, "r");
+    if (!file) return errno != ENOENT;
+    char stat[512];
+    size_t n = fread(stat, 1, sizeof(stat) - 1, file);
+    fclose(file);
+    stat[n] = '\0';
+    const char* end_of_name = strrchr(stat, ')');
+    if (!end_of_name || end_of_name[1] == '\0') return true;
+    char state = end_of_name[2];
+    return state != 'Z' && state != 'X';
+}
+
+// Mutex whose state word holds the owner's TID, plus FUTEX_WAITERS when
+// someone sleeps on it (the same layout the kernel uses for robust and PI
+// futexes).
+// - Lock: CAS 0 -> tid. Under contention it spins for a bounded, adaptive
+//   number of rounds, then sleeps.
+// - Unlock: exchange to 0, and wake one sleeper only if FUTEX_WAITERS was set.
+// - Owner death: sleepers wake every kOwnerProbeMs and check whether the
+//   owner's TID is still alive. The thread that takes over a dead owner's
+//   lock gets EOWNERDEAD, exactly like a PTHREAD_MUTEX_ROBUST mutex. If it
+//   unlocks without calling markConsistent(), later lock() calls fail with
+//   ENOTRECOVERABLE.
+// Polling is used instead of the kernel robust list, because that list
+// belongs to glibc's pthread implementation.
+class FutexMutex {
+public:
+    static constexpr int kMaxSpins = 200;
+    static constexpr int kOwnerProbeMs = 100;
+
+    FutexMutex() : state_(0), spins_(0), inconsistent_(0), sleeps_(0) {}
+
+    FutexMutex(const FutexMutex&) = delete;
+    FutexMutex& operator=(const FutexMutex&) = delete;
+
+    // 0, EOWNERDEAD (lock held, protected data may be inconsistent) or
+    // ENOTRECOVERABLE (lock not held)
+    int lock() {
+        uint32_t tid = currentTid();
+        uint32_t expected = 0;
+        if (state_.compare_exchange_strong(expected, tid, std::memory_order_acquire)) return 0;
+        if (spin(tid)) return 0;
+        return lockSlow(tid);
+    }
+
+    bool tryLock() {
+        uint32_t expected = 0;
+        return state_.compare_exchange_strong(expected, currentTid(), std::memory_order_acquire);
+    }
+
+    // EPERM if the calling thread is not the owner
+    int unlock() {
+        uint32_t tid = currentTid();
+        if ((state_.load(std::memory_order_relaxed) & FUTEX_TID_MASK) != tid) return EPERM;
+
+        uint32_t next = 0;
+        if (inconsistent_.load(std::memory_order_relaxed)) {
+            // Recovered but never repaired: nobody may trust the data again
+            inconsistent_.store(0, std::memory_order_relaxed);
+            next = kNotRecoverable;
+        }
+        uint32_t previous = state_.exchange(next, std::memory_order_release);
+        if (next == kNotRecoverable) {
+            futexWake(&state_, INT_MAX);
+        } else if (previous & FUTEX_WAITERS) {
+            futexWake(&state_, 1);
+        }
+        return 0;
+    }
+
+    // Called by the thread that got EOWNERDEAD, after repairing the data
+    void markConsistent() { inconsistent_.store(0, std::memory_order_relaxed); }
+
+    uint32_t sleeps() const { return sleeps_.load(std::memory_order_relaxed); }
+
+private:
+    friend class FutexCondition;
+
+    // A TID can never be this large, so the value marks the mutex as dead
+    static constexpr uint32_t kNotRecoverable = FUTEX_TID_MASK;
+
+    // Like glibc's PTHREAD_MUTEX_ADAPTIVE_NP: spin up to twice the recent
+    // average it took to get the lock, and keep the average up to date. On a
+    // single CPU the owner cannot run while we spin, so go straight to sleep.
+    bool spin(uint32_t tid) {
+        static const bool single_cpu = sysconf(_SC_NPROCESSORS_ONLN) <= 1;
+        if (single_cpu) return false;
+
+        int32_t average = spins_.load(std::memory_order_relaxed);
+        int max_spins = std::min(kMaxSpins, average * 2 + 10);
+        int count = 0;
+        bool acquired = false;
+        while (count < max_spins) {
+            ++count;
+            cpuRelax();
+            uint32_t expected = state_.load(std::memory_order_relaxed);
+            if (expected == 0 &&
+                state_.compare_exchange_weak(expected, tid, std::memory_order_acquire)) {
+                acquired = true;
+                break;
+            }
+        }
+        spins_.store(average + (count - average) / 8, std::memory_order_relaxed);
+        return acquired;
+    }
+
+    // Always leaves FUTEX_WAITERS set on acquire: another sleeper may still
+    // be queued. Condition-variable waiters come straight here.
+    int lockSlow(uint32_t tid) {
+        for (;;) {
+            uint32_t value = state_.load(std::memory_order_relaxed);
+            uint32_t owner = value & FUTEX_TID_MASK;
+            if (owner == kNotRecoverable) return ENOTRECOVERABLE;
+            if (owner == 0) {
+                if (state_.compare_exchange_weak(value, tid | FUTEX_WAITERS, std::memory_order_acquire)) {
+                    return 0;
+                }
+                continue;
+            }
+            if (!(value & FUTEX_WAITERS)) {
+                if (!state_.compare_exchange_weak(value, value | FUTEX_WAITERS, std::memory_order_relaxed)) {
+                    continue;
+                }
+                value |= FUTEX_WAITERS;
+            }
+
+            sleeps_.fetch_add(1, std::memory_order_relaxed);
+            if (!futexWait(&state_, value, kOwnerProbeMs) && !threadAlive(owner)) {
+                // Take the lock over from the dead owner, unless someone else
+                // got there first
+                if (state_.compare_exchange_strong(value, tid | FUTEX_WAITERS, std::memory_order_acquire)) {
+                    inconsistent_.store(1, std::memory_order_relaxed);
+                    return EOWNERDEAD;
+                }
+            }
+        }
+    }
+
+    std::atomic<uint32_t> state_;        // Owner TID | FUTEX_WAITERS, 0 when free
+    std::atomic<int32_t> spins_;         // Running average of spins to acquire
+    std::atomic<uint32_t> inconsistent_; // Set while an EOWNERDEAD owner repairs
+    std::atomic<uint32_t> sleeps_;       // Futex waits, for the benchmark
+};
+
+// Condition variable for FutexMutex. Waiters sleep on a sequence word that
+// every signal bumps, so a signal between "unlock" and "sleep" is never
+// lost: the futex sees the changed value and returns at once. broadcast()
+// wakes one waiter and requeues the rest onto the mutex word
+// (FUTEX_CMP_REQUEUE). They then wake one at a time as the mutex is
+// released, instead of all at once to fight over it.
+class FutexCondition {
+public:
+    FutexCondition() : seq_(0), waiters_(0) {}
+
+    FutexCondition(const FutexCondition&) = delete;
+    FutexCondition& operator=(const FutexCondition&) = delete;
+
+    // Returns the result of re-acquiring the mutex (0 or EOWNERDEAD etc.)
+    int wait(FutexMutex& mutex) { return waitFor(mutex, -1, nullptr); }
+
+    int waitFor(FutexMutex& mutex, int timeout_ms, bool* timed_out) {
+        uint32_t seq = seq_.load(std::memory_order_relaxed);
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        mutex.unlock();
+        bool woken = futexWait(&seq_, seq, timeout_ms);
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        if (timed_out) *timed_out = !woken;
+        // We may have been requeued and the lock handed over, so take the
+        // contended path, which keeps FUTEX_WAITERS set
+        return mutex.lockSlow(currentTid());
+    }
+
+    void signal() {
+        seq_.fetch_add(1, std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) != 0) futexWake(&seq_, 1);
+    }
+
+    void broadcast(FutexMutex& mutex) {
+        uint32_t seq = seq_.fetch_add(1, std::memory_order_seq_cst) + 1;
+        if (waiters_.load(std::memory_order_seq_cst) == 0) return;
+
+        // Requeued waiters sleep on the mutex word and are woken only by an
+        // unlock that sees FUTEX_WAITERS
+        mutex.state_.fetch_or(FUTEX_WAITERS, std::memory_order_relaxed);
+        long result = syscall(SYS_futex, reinterpret_cast<uint32_t*>(&seq_), FUTEX_CMP_REQUEUE, 1,
+                              reinterpret_cast<void*>(static_cast<uintptr_t>(INT_MAX)),
+                              reinterpret_cast<uint32_t*>(&mutex.state_), seq);
+        if (result == -1) {
+            futexWake(&seq_, INT_MAX);  // Another signal raced us: wake everyone
+        } else if ((mutex.state_.load(std::memory_order_relaxed) & FUTEX_TID_MASK) == 0) {
+            futexWake(&mutex.state_, 1);  // Nobody holds the mutex to pass the wake on
+        }
+    }
+
+private:
+    std::atomic<uint32_t> seq_;
+    std::atomic<uint32_t> waiters_;
+};
+
+// Writer-preferring reader-writer lock. Each reader counts itself in one
+// slot of a table of cache-line-sized counters, picked by TID. Readers on
+// different slots never write the same line, unlike a single reader_count_.
+// - Writer: announces itself in writer_intent_, serializes with other
+//   writers on a FutexMutex, then waits for every slot to drain.
+// - Reader: while any writer has announced itself, readers back out of their
+//   slot and sleep on reader_gate_. This is what makes the lock prefer
+//   writers.
+// Only the writer mutex is robust. A reader that dies holding the lock
+// leaves its slot counted.
+class FutexRWLock {
+public:
+    static constexpr size_t kReaderSlots = 32;
+    static constexpr int kDrainSpins = 1000;
+
+    FutexRWLock() : writer_intent_(0), reader_gate_(0), readers_waiting_(0) {}
+
+    FutexRWLock(const FutexRWLock&) = delete;
+    FutexRWLock& operator=(const FutexRWLock&) = delete;
+
+    void lockShared() {
+        std::atomic<uint32_t>& slot = slotFor(currentTid());
+        for (;;) {
+            // Dekker pair with lock(): count ourselves, then look for writers
+            slot.fetch_add(1, std::memory_order_seq_cst);
+            if (writer_intent_.load(std::memory_order_seq_cst) == 0) return;
+
+            // A writer is waiting (or writing): step aside
+            releaseSlot(slot);
+            uint32_t gate = reader_gate_.load(std::memory_order_acquire);
+            readers_waiting_.fetch_add(1, std::memory_order_seq_cst);
+            if (writer_intent_.load(std::memory_order_seq_cst) != 0) futexWait(&reader_gate_, gate, -1);
+            readers_waiting_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    void unlockShared() { releaseSlot(slotFor(currentTid())); }
+
+    // The writer mutex's result: 0, EOWNERDEAD or ENOTRECOVERABLE
+    int lock() {
+        writer_intent_.fetch_add(1, std::memory_order_seq_cst);
+        int result = writer_mutex_.lock();
+        if (result == ENOTRECOVERABLE) {
+            leave();
+            return result;
+        }
+        for (auto& slot : slots_) {
+            for (int spin = 0;; ++spin) {
+                uint32_t readers = slot.count.load(std::memory_order_seq_cst);
+                if (readers == 0) break;
+                if (spin < kDrainSpins) {
+                    cpuRelax();
+                } else {
+                    futexWait(&slot.count, readers, -1);
+                }
+            }
+        }
+        return result;
+    }
+
+    void unlock() {
+        writer_mutex_.unlock();
+        leave();
+    }
+
+    void markConsistent() { writer_mutex_.markConsistent(); }
+
+private:
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint32_t> count{0};
+    };
+
+    std::atomic<uint32_t>& slotFor(uint32_t tid) { return slots_[tid % kReaderSlots].count; }
+
+    // The last reader out of a slot wakes a writer that may be draining it
+    void releaseSlot(std::atomic<uint32_t>& slot) {
+        if (slot.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+            writer_intent_.load(std::memory_order_seq_cst) != 0) {
+            futexWake(&slot, 1);
+        }
+    }
+
+    // The last writer out opens the gate for readers
+    void leave() {
+        if (writer_intent_.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+            reader_gate_.fetch_add(1, std::memory_order_release);
+            if (readers_waiting_.load(std::memory_order_seq_cst) != 0) futexWake(&reader_gate_, INT_MAX);
+        }
+    }
+
+    alignas(64) std::atomic<uint32_t> writer_intent_;  // Writers waiting or writing
+    std::atomic<uint32_t> reader_gate_;                // Bumped when the last writer leaves
+    std::atomic<uint32_t> readers_waiting_;
+    alignas(64) FutexMutex writer_mutex_;
+    ReaderSlot slots_[kReaderSlots];
+};
+
 void demonstrateBasicMutex() {
     std::cout << "=== Basic Mutex Demonstration ===\n\n";
     
@@ -563,61 +916,413 @@ void demonstratePriorityMutex() {
     std::cout << "Priority mutex demonstration completed\n";
 }
 
-void benchmarkMutex() {
-    std::cout << "\n=== Mutex Performance Benchmark ===\n";
-    
-    const int iterations = 1000000;
-    MutexManager mutex;
-    
-    auto start = std::chrono::high_resolution_clock::now();
-    
-    // Benchmark lock/unlock operations
-    for (int i = 0; i < iterations; ++i) {
-        mutex.lock();
-        mutex.unlock();
+// Shared block for the futex demo: the locks live next to the data they guard
+struct FutexSharedBlock {
+    FutexMutex mutex;
+    FutexCondition ready;
+    int value = 0;
+    bool has_value = false;
+    bool acknowledged = false;
+    int ledger_total = 0;     // Invariant: ledger_total == ledger_entries * 10
+    int ledger_entries = 0;
+};
+
+void demonstrateFutexMutex() {
+    std::cout << "\n=== Futex Mutex, Condition Variable and Owner Death ===\n\n";
+
+    void* memory = mmap(nullptr, sizeof(FutexSharedBlock), PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        perror("mmap");
+        return;
     }
-    
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
-    
-    std::cout << "Performed " << iterations << " lock/unlock cycles in " 
-              << duration.count() << " nanoseconds\n";
-    std::cout << "Average time per cycle: " 
-              << static_cast<double>(duration.count()) / iterations 
-              << " nanoseconds\n";
-    
-    // Benchmark with contention
-    std::cout << "\nBenchmarking with contention...\n";
-    
-    std::atomic<int> counter{0};
-    const int num_threads = 4;
-    const int ops_per_thread = iterations / num_threads;
-    
-    start = std::chrono::high_resolution_clock::now();
-    
-    std::vector<std::thread> threads;
-    for (int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&mutex, &counter, ops_per_thread]() {
-            for (int j = 0; j < ops_per_thread; ++j) {
-                mutex.lock();
-                counter++;
-                mutex.unlock();
-            }
+    auto* block = new (memory) FutexSharedBlock();
+
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Child: hand a value over through the condition variable...
+        block->mutex.lock();
+        block->value = 42;
+        block->has_value = true;
+        block->ready.signal();
+        while (!block->acknowledged) block->ready.wait(block->mutex);
+
+        // ...then die half-way through an update, still holding the lock
+        block->ledger_total += 10;
+        std::cout << "Child: crashing inside the critical section\n";
+        std::cout.flush();
+        _exit(1);
+    } else if (pid < 0) {
+        perror("fork failed");
+        munmap(memory, sizeof(FutexSharedBlock));
+        return;
+    }
+
+    block->mutex.lock();
+    while (!block->has_value) block->ready.wait(block->mutex);
+    std::cout << "Parent: received " << block->value << " via FutexCondition" << std::endl;
+    block->acknowledged = true;
+    block->ready.signal();
+    block->mutex.unlock();
+
+    int status;
+    waitpid(pid, &status, 0);
+
+    auto start = std::chrono::steady_clock::now();
+    // wait() re-locks too, so real code checks its result the same way
+    int result = block->mutex.lock();
+    auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    if (result == EOWNERDEAD) {
+        std::cout << "Parent: lock() returned EOWNERDEAD after " << waited.count()
+                  << " ms; ledger total " << block->ledger_total << " for " << block->ledger_entries
+                  << " entries\n";
+        block->ledger_total = block->ledger_entries * 10;  // Roll back the half-done update
+        block->mutex.markConsistent();
+        std::cout << "Parent: repaired ledger, marked consistent\n";
+    }
+    block->mutex.unlock();
+
+    // The mutex is healthy again
+    result = block->mutex.lock();
+    std::cout << "Parent: next lock() returned " << (result == 0 ? "0" : strerror(result)) << "\n";
+    block->mutex.unlock();
+
+    block->~FutexSharedBlock();
+    munmap(memory, sizeof(FutexSharedBlock));
+}
+
+// ===== LOCK TIMING =====
+
+// Every measurement below is one warmup run plus timedRuns() timed runs;
+// a single run is at the mercy of whatever else the machine is doing. Each
+// result is one line with p50/p90/p99 over the runs, the same line and CSV
+// columns as the thread benchmarks in Multithreading/06_thread_pool.cpp and
+// 07_modern_synchronization.cpp; BenchmarkSuite in
+// Multithreading/08_performance_analysis.cpp is the full harness.
+// BENCH_OUTPUT_DIR=<dir> writes <dir>/<suite>.csv, BENCH_REPEATS overrides
+// the number of timed runs.
+inline int timedRuns() {
+    static const int runs = [] {
+        const char* repeats = std::getenv("BENCH_REPEATS");
+        return repeats ? std::max(1, std::atoi(repeats)) : 5;
+    }();
+    return runs;
+}
+
+class LockTimings {
+private:
+    struct Row {
+        std::string name;
+        int threads;               // Threads, or processes for the cross-process rows
+        uint64_t ops;
+        std::vector<double> ns;    // Per operation, one per timed run, sorted
+    };
+
+    std::string suite_;
+    std::vector<Row> rows_;
+
+    static double percentile(const std::vector<double>& sorted, double p) {
+        double rank = p * static_cast<double>(sorted.size() - 1);
+        size_t low = static_cast<size_t>(rank);
+        size_t high = std::min(low + 1, sorted.size() - 1);
+        return sorted[low] + (sorted[high] - sorted[low]) * (rank - static_cast<double>(low));
+    }
+
+public:
+    explicit LockTimings(std::string suite) : suite_(std::move(suite)) {}
+
+    LockTimings(const LockTimings&) = delete;
+    LockTimings& operator=(const LockTimings&) = delete;
+
+    ~LockTimings() {
+        const char* dir = std::getenv("BENCH_OUTPUT_DIR");
+        if (!dir || rows_.empty()) return;
+        std::string path = std::string(dir) + "/" + suite_ + ".csv";
+        FILE* out = fopen(path.c_str(), "w");
+        if (!out) {
+            perror(path.c_str());
+            return;
+        }
+        fprintf(out, "suite,name,threads,ops,samples,min_ns,median_ns,p90_ns,p99_ns,max_ns,mean_ns,stddev_ns\n");
+        for (const Row& row : rows_) {
+            double mean = 0, squares = 0;
+            for (double ns : row.ns) mean += ns / static_cast<double>(row.ns.size());
+            for (double ns : row.ns) squares += (ns - mean) * (ns - mean);
+            fprintf(out, "%s,\"%s\",%d,%llu,%zu,%g,%g,%g,%g,%g,%g,%g\n", suite_.c_str(), row.name.c_str(),
+                    row.threads, static_cast<unsigned long long>(row.ops), row.ns.size(), row.ns.front(),
+                    percentile(row.ns, 0.5), percentile(row.ns, 0.9), percentile(row.ns, 0.99), row.ns.back(),
+                    mean, std::sqrt(squares / static_cast<double>(row.ns.size())));
+        }
+        fclose(out);
+    }
+
+    // measure() performs `ops` operations and returns ns per operation;
+    // prints the row and returns its p50
+    template <typename Measure>
+    double time(const std::string& name, int threads, uint64_t ops, Measure measure,
+                const char* plural = "threads") {
+        measure();
+        Row row{name, threads, ops, {}};
+        for (int run = 0; run < timedRuns(); ++run) row.ns.push_back(measure());
+        std::sort(row.ns.begin(), row.ns.end());
+        printf("%s [%d %s]: p50 %.2f ns/op, p90 %.2f, p99 %.2f (n=%zu)\n", name.c_str(), threads,
+               threads == 1 ? "thread" : plural, percentile(row.ns, 0.5), percentile(row.ns, 0.9),
+               percentile(row.ns, 0.99), row.ns.size());
+        fflush(stdout);  // The cross-process rows fork
+        rows_.push_back(std::move(row));
+        return percentile(rows_.back().ns, 0.5);
+    }
+};
+
+// Runs body(i) `iterations` times on each of `threads` threads; ns per
+// call for one run. Threads are created before the clock starts and
+// released together, so thread startup is not timed.
+template <typename Body>
+double runThreads(int threads, int iterations, Body& body) {
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (int i = 0; i < iterations; ++i) body(i);
         });
     }
-    
-    for (auto& thread : threads) {
-        thread.join();
+    while (ready.load() < threads) std::this_thread::yield();
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) worker.join();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (static_cast<double>(threads) * iterations);
+}
+
+// 1, 2, 4, ... up to max(4, hardware_concurrency()); 1 thread is the
+// uncontended cost
+std::vector<int> lockThreadCounts() {
+    std::vector<int> counts;
+    const int max_threads = std::max(4, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int n = 1; n < max_threads; n *= 2) counts.push_back(n);
+    counts.push_back(max_threads);
+    return counts;
+}
+
+// `threads` threads bumping a shared counter under the lock, at each
+// thread count; `iterations` lock/unlock pairs per run in total
+template <typename Lock, typename Unlock>
+void benchmarkLockSweep(LockTimings& timings, const char* name, Lock lock, Unlock unlock, int iterations) {
+    for (int threads : lockThreadCounts()) {
+        long counter = 0;
+        int per_thread = iterations / threads;
+        auto body = [&](int) {
+            lock();
+            ++counter;
+            unlock();
+        };
+        timings.time(name, threads, static_cast<uint64_t>(per_thread) * threads,
+                     [&] { return runThreads(threads, per_thread, body); });
+        if (counter != static_cast<long>(timedRuns() + 1) * per_thread * threads) {
+            std::cout << "  [LOST UPDATES]\n";
+        }
+    }
+}
+
+// 1 write per `write_every` operations on a small table, at each thread count
+template <typename ReadLock, typename ReadUnlock, typename WriteLock, typename WriteUnlock>
+void benchmarkReadMostlySweep(LockTimings& timings, const char* name, ReadLock read_lock,
+                              ReadUnlock read_unlock, WriteLock write_lock, WriteUnlock write_unlock,
+                              int iterations, int write_every) {
+    int table[16] = {0};
+    std::atomic<long> checksum{0};
+    auto body = [&](int i) {
+        if (i % write_every == 0) {
+            write_lock();
+            for (int& cell : table) ++cell;
+            write_unlock();
+        } else {
+            read_lock();
+            long sum = 0;
+            for (int cell : table) sum += cell;
+            read_unlock();
+            if (sum < 0) checksum.fetch_add(sum, std::memory_order_relaxed);
+        }
+    };
+    for (int threads : lockThreadCounts()) {
+        int per_thread = iterations / threads;
+        timings.time(name, threads, static_cast<uint64_t>(per_thread) * threads,
+                     [&] { return runThreads(threads, per_thread, body); });
+    }
+}
+
+// Lives in an anonymous shared mapping so a forked child sees the same locks
+struct CrossProcessBench {
+    pthread_mutex_t pthread_mutex;
+    pthread_cond_t pthread_cond;
+    FutexMutex futex_mutex;
+    FutexCondition futex_cond;
+    uint64_t counter = 0;
+    int turn = 0;
+
+    CrossProcessBench() {
+        pthread_mutexattr_t mutex_attr;
+        pthread_mutexattr_init(&mutex_attr);
+        pthread_mutexattr_setpshared(&mutex_attr, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&mutex_attr, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&pthread_mutex, &mutex_attr);
+        pthread_mutexattr_destroy(&mutex_attr);
+
+        pthread_condattr_t cond_attr;
+        pthread_condattr_init(&cond_attr);
+        pthread_condattr_setpshared(&cond_attr, PTHREAD_PROCESS_SHARED);
+        pthread_cond_init(&pthread_cond, &cond_attr);
+        pthread_condattr_destroy(&cond_attr);
+    }
+
+    ~CrossProcessBench() {
+        pthread_cond_destroy(&pthread_cond);
+        pthread_mutex_destroy(&pthread_mutex);
     }
+};
+
+// Parent and child each add `per_process` under the lock; ns per increment
+template <typename Lock, typename Unlock>
+double crossProcessCounter(CrossProcessBench* shared, Lock lock, Unlock unlock, int per_process) {
+    shared->counter = 0;
+    auto run = [&] {
+        for (int i = 0; i < per_process; ++i) {
+            lock();
+            ++shared->counter;
+            unlock();
+        }
+    };
+    std::cout.flush();
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid == 0) {
+        run();
+        _exit(0);
+    }
+    run();
+    int status;
+    waitpid(pid, &status, 0);
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    if (shared->counter != 2ull * per_process) std::cout << "  [LOST UPDATES]\n";
+    return static_cast<double>(elapsed.count()) / (2.0 * per_process);
+}
+
+// Parent sets turn = 1 and waits for the child to hand it back; ns per round trip
+template <typename Lock, typename Unlock, typename Wait, typename Signal>
+double crossProcessPingPong(CrossProcessBench* shared, Lock lock, Unlock unlock, Wait wait, Signal signal,
+                            int round_trips) {
+    shared->turn = 0;
+    std::cout.flush();
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid == 0) {
+        for (int i = 0; i < round_trips; ++i) {
+            lock();
+            while (shared->turn != 1) wait();
+            shared->turn = 0;
+            signal();
+            unlock();
+        }
+        _exit(0);
+    }
+    for (int i = 0; i < round_trips; ++i) {
+        lock();
+        shared->turn = 1;
+        signal();
+        while (shared->turn != 0) wait();
+        unlock();
+    }
+    int status;
+    waitpid(pid, &status, 0);
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return static_cast<double>(elapsed.count()) / round_trips;
+}
+
+void benchmarkMutex() {
+    std::cout << "\n=== Mutex Performance Benchmark ===\n";
     
-    end = std::chrono::high_resolution_clock::now();
-    duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+    const int iterations = 1000000;
     
-    std::cout << "Contended operations: " << counter.load() << " in " 
-              << duration.count() << " nanoseconds\n";
-    std::cout << "Average time per contended operation: " 
-              << static_cast<double>(duration.count()) / counter.load() 
-              << " nanoseconds\n";
+    MutexManager mutex_manager;
+    std::mutex std_mutex;
+    PriorityMutex priority_mutex;
+    ReaderWriterMutex rw_mutex;
+    std::shared_mutex shared_mutex;
+    FutexMutex futex_mutex;
+    FutexRWLock futex_rw;
+    LockTimings timings("mutex");
+    
+    std::cout << "\nExclusive locking, ns per lock/unlock (1 thread = uncontended):\n";
+    benchmarkLockSweep(timings, "MutexManager (pthread errorcheck)", [&] { mutex_manager.lock(); },
+                       [&] { mutex_manager.unlock(); }, iterations);
+    benchmarkLockSweep(timings, "std::mutex", [&] { std_mutex.lock(); }, [&] { std_mutex.unlock(); },
+                       iterations);
+    benchmarkLockSweep(timings, "PriorityMutex (low priority)", [&] { priority_mutex.lockLowPriority(); },
+                       [&] { priority_mutex.unlock(); }, iterations);
+    benchmarkLockSweep(timings, "ReaderWriterMutex (writer)", [&] { rw_mutex.writerLock(); },
+                       [&] { rw_mutex.writerUnlock(); }, iterations);
+    benchmarkLockSweep(timings, "FutexMutex", [&] { futex_mutex.lock(); }, [&] { futex_mutex.unlock(); },
+                       iterations);
+    benchmarkLockSweep(timings, "FutexRWLock (writer)", [&] { futex_rw.lock(); }, [&] { futex_rw.unlock(); },
+                       iterations);
+    std::cout << "FutexMutex slept " << futex_mutex.sleeps() << " times under contention\n";
+    
+    std::cout << "\nRead-mostly, 1 write in 20, ns per operation:\n";
+    benchmarkReadMostlySweep(timings, "ReaderWriterMutex", [&] { rw_mutex.readerLock(); },
+                             [&] { rw_mutex.readerUnlock(); }, [&] { rw_mutex.writerLock(); },
+                             [&] { rw_mutex.writerUnlock(); }, iterations, 20);
+    benchmarkReadMostlySweep(timings, "std::shared_mutex", [&] { shared_mutex.lock_shared(); },
+                             [&] { shared_mutex.unlock_shared(); }, [&] { shared_mutex.lock(); },
+                             [&] { shared_mutex.unlock(); }, iterations, 20);
+    benchmarkReadMostlySweep(timings, "FutexMutex (exclusive for both)", [&] { futex_mutex.lock(); },
+                             [&] { futex_mutex.unlock(); }, [&] { futex_mutex.lock(); },
+                             [&] { futex_mutex.unlock(); }, iterations, 20);
+    benchmarkReadMostlySweep(timings, "FutexRWLock (per-reader slots)", [&] { futex_rw.lockShared(); },
+                             [&] { futex_rw.unlockShared(); }, [&] { futex_rw.lock(); },
+                             [&] { futex_rw.unlock(); }, iterations, 20);
+    
+    std::cout << "\nCross-process, two processes on one shared mapping:\n";
+    void* memory = mmap(nullptr, sizeof(CrossProcessBench), PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        perror("mmap");
+        return;
+    }
+    auto* shared = new (memory) CrossProcessBench();
+    const int per_process = iterations / 2;
+    const int round_trips = 20000;
+    
+    // Each run forks a child; the fork is noise next to the measured loop
+    timings.time("Counter, pthread robust pshared mutex", 2, iterations, [&] {
+        return crossProcessCounter(
+            shared, [&] { pthread_mutex_lock(&shared->pthread_mutex); },
+            [&] { pthread_mutex_unlock(&shared->pthread_mutex); }, per_process);
+    }, "processes");
+    timings.time("Counter, FutexMutex", 2, iterations, [&] {
+        return crossProcessCounter(
+            shared, [&] { shared->futex_mutex.lock(); }, [&] { shared->futex_mutex.unlock(); }, per_process);
+    }, "processes");
+    // One "op" here is a full round trip
+    timings.time("Ping-pong, pthread_cond_t pshared", 2, round_trips, [&] {
+        return crossProcessPingPong(
+            shared, [&] { pthread_mutex_lock(&shared->pthread_mutex); },
+            [&] { pthread_mutex_unlock(&shared->pthread_mutex); },
+            [&] { pthread_cond_wait(&shared->pthread_cond, &shared->pthread_mutex); },
+            [&] { pthread_cond_signal(&shared->pthread_cond); }, round_trips);
+    }, "processes");
+    timings.time("Ping-pong, FutexCondition", 2, round_trips, [&] {
+        return crossProcessPingPong(
+            shared, [&] { shared->futex_mutex.lock(); }, [&] { shared->futex_mutex.unlock(); },
+            [&] { shared->futex_cond.wait(shared->futex_mutex); }, [&] { shared->futex_cond.signal(); },
+            round_trips);
+    }, "processes");
+    
+    shared->~CrossProcessBench();
+    munmap(memory, sizeof(CrossProcessBench));
 }
 
 int main() {
@@ -629,6 +1334,7 @@ int main() {
     demonstrateReaderWriter();
     demonstrateConditionVariable();
     demonstratePriorityMutex();
+    demonstrateFutexMutex();
     benchmarkMutex();
     
     std::cout << "\n=== Key Mutex Concepts ===\n";
@@ -638,6 +1344,8 @@ int main() {
     std::cout << "4. Process-shared mutexes for IPC synchronization\n";
     std::cout << "5. Always use RAII for exception safety\n";
     std::cout << "6. Condition variables for complex synchronization\n";
+    std::cout << "7. Futex locks: one atomic when uncontended, a syscall only to sleep or wake\n";
+    std::cout << "8. Robust locks report EOWNERDEAD so survivors can repair shared state\n";
     
     return 0;
 }
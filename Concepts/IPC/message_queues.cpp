@@ -1,17 +1,213 @@
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <cstring>
+#include <cstddef>
+#include <cstdint>
 #include <mqueue.h>
 #include <unistd.h>
 #include <sys/wait.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/epoll.h>
+#include <poll.h>
 #include <fcntl.h>
 #include <signal.h>
 #include <thread>
 #include <chrono>
 #include <vector>
+#include <map>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
 #include <json/json.h>  // For JSON message serialization (optional)
 
-// Message structure for typed communication
+// Shared-memory arena for payloads too large to go through the queue. The
+// sender copies a payload into a block once, and only the message header
+// with (offset, length) goes through mq_send. The receiver reads the payload
+// in place and gives the block back with release(). Blocks come in a few
+// size classes, each with a lock-free free list of block indices. Indices
+// work in every process; pointers would not.
+class SharedPayloadArena {
+public:
+    static constexpr size_t kClasses = 4;
+    static constexpr size_t kBlockSizes[kClasses] = {4 << 10, 16 << 10, 64 << 10, 256 << 10};
+
+private:
+    static constexpr uint32_t kMagic = 0x4152454E;  // "AREN"
+
+    // Free list head: (ABA tag << 32) | (block index + 1); 0 means empty
+    struct alignas(64) FreeList {
+        std::atomic<uint64_t> head;
+    };
+
+    struct Header {
+        std::atomic<uint32_t> magic;
+        uint32_t blocks_per_class;
+        FreeList free_lists[kClasses];
+    };
+
+    const char* shm_name_;
+    int shm_fd_;
+    char* base_;
+    size_t size_;
+    uint32_t blocks_per_class_;
+    bool is_creator_;
+
+    Header* header() const { return reinterpret_cast<Header*>(base_); }
+
+    // Next-index link of every block, one array per class, after the header
+    std::atomic<uint32_t>* links(size_t cls) const {
+        return reinterpret_cast<std::atomic<uint32_t>*>(base_ + sizeof(Header)) + cls * blocks_per_class_;
+    }
+
+    size_t classStart(size_t cls) const {
+        size_t offset = sizeof(Header) + kClasses * blocks_per_class_ * sizeof(uint32_t);
+        offset = (offset + 4095) & ~size_t(4095);
+        for (size_t c = 0; c < cls; ++c) offset += kBlockSizes[c] * blocks_per_class_;
+        return offset;
+    }
+
+    void push(size_t cls, uint32_t index) {
+        auto& head = header()->free_lists[cls].head;
+        uint64_t old_head = head.load(std::memory_order_relaxed);
+        uint64_t new_head;
+        do {
+            links(cls)[index].store(static_cast<uint32_t>(old_head), std::memory_order_relaxed);
+            new_head = ((old_head >> 32) + 1) << 32 | (index + 1);
+        } while (!head.compare_exchange_weak(old_head, new_head, std::memory_order_release,
+                                             std::memory_order_relaxed));
+    }
+
+    bool pop(size_t cls, uint32_t& index) {
+        auto& head = header()->free_lists[cls].head;
+        uint64_t old_head = head.load(std::memory_order_acquire);
+        uint64_t new_head;
+        do {
+            if (static_cast<uint32_t>(old_head) == 0) return false;
+            index = static_cast<uint32_t>(old_head) - 1;
+            uint32_t next = links(cls)[index].load(std::memory_order_relaxed);
+            new_head = ((old_head >> 32) + 1) << 32 | next;
+        } while (!head.compare_exchange_weak(old_head, new_head, std::memory_order_acquire,
+                                             std::memory_order_acquire));
+        return true;
+    }
+
+public:
+    SharedPayloadArena(const char* shm_name, bool create = false, uint32_t blocks_per_class = 64)
+        : shm_name_(shm_name), shm_fd_(-1), base_(nullptr), size_(0),
+          blocks_per_class_(blocks_per_class), is_creator_(create) {}
+
+    ~SharedPayloadArena() {
+        cleanup();
+    }
+
+    SharedPayloadArena(const SharedPayloadArena&) = delete;
+    SharedPayloadArena& operator=(const SharedPayloadArena&) = delete;
+
+    bool initialize() {
+        if (is_creator_) {
+            shm_unlink(shm_name_);
+            shm_fd_ = shm_open(shm_name_, O_CREAT | O_RDWR, 0666);
+        } else {
+            shm_fd_ = shm_open(shm_name_, O_RDWR, 0666);
+        }
+        if (shm_fd_ == -1) {
+            perror("shm_open (arena)");
+            return false;
+        }
+
+        if (is_creator_) {
+            size_ = classStart(kClasses);
+            if (ftruncate(shm_fd_, size_) == -1) {
+                perror("ftruncate (arena)");
+                return false;
+            }
+        } else {
+            struct stat st{};
+            if (fstat(shm_fd_, &st) == -1 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+                std::cerr << "Arena " << shm_name_ << " is not initialized\n";
+                return false;
+            }
+            size_ = st.st_size;
+        }
+
+        void* addr = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd_, 0);
+        if (addr == MAP_FAILED) {
+            perror("mmap (arena)");
+            return false;
+        }
+        base_ = static_cast<char*>(addr);
+
+        if (is_creator_) {
+            header()->blocks_per_class = blocks_per_class_;
+            for (size_t cls = 0; cls < kClasses; ++cls) {
+                for (uint32_t i = 0; i < blocks_per_class_; ++i) {
+                    links(cls)[i].store(i + 1 < blocks_per_class_ ? i + 2 : 0, std::memory_order_relaxed);
+                }
+                header()->free_lists[cls].head.store(1, std::memory_order_relaxed);
+            }
+            header()->magic.store(kMagic, std::memory_order_release);
+        } else {
+            if (header()->magic.load(std::memory_order_acquire) != kMagic) {
+                std::cerr << "Arena " << shm_name_ << " has no arena header\n";
+                return false;
+            }
+            blocks_per_class_ = header()->blocks_per_class;
+        }
+        return true;
+    }
+
+    static size_t maxPayload() { return kBlockSizes[kClasses - 1]; }
+
+    // Offset of a free block that holds at least size bytes, or false when
+    // the payload is too large or every block of its class is in flight
+    bool allocate(size_t size, uint64_t& offset) {
+        for (size_t cls = 0; cls < kClasses; ++cls) {
+            if (size > kBlockSizes[cls]) continue;
+            uint32_t index;
+            if (!pop(cls, index)) return false;
+            offset = classStart(cls) + uint64_t(index) * kBlockSizes[cls];
+            return true;
+        }
+        return false;
+    }
+
+    void release(uint64_t offset) {
+        for (size_t cls = 0; cls < kClasses; ++cls) {
+            if (offset < classStart(cls + 1)) {
+                push(cls, static_cast<uint32_t>((offset - classStart(cls)) / kBlockSizes[cls]));
+                return;
+            }
+        }
+    }
+
+    char* data(uint64_t offset) const { return base_ + offset; }
+
+    void cleanup() {
+        if (base_) {
+            munmap(base_, size_);
+            base_ = nullptr;
+        }
+        if (shm_fd_ != -1) {
+            close(shm_fd_);
+            shm_fd_ = -1;
+        }
+        if (is_creator_) {
+            shm_unlink(shm_name_);
+            is_creator_ = false;
+        }
+    }
+};
+
+// Message structure for typed communication. Only the header and the used
+// part of data[] go through mq_send. Payloads larger than data[] travel as
+// an (offset, length) descriptor into a SharedPayloadArena.
 struct Message {
     enum Type {
         TEXT = 1,
@@ -20,22 +216,39 @@ struct Message {
         RESPONSE = 4
     };
     
+    enum Storage : uint32_t {
+        INLINE = 0,  // data[0, data_size)
+        ARENA = 1    // arena block at arena_offset
+    };
+    
+    static constexpr size_t kInlineCapacity = 256;
+    
     Type type;
     int sequence_id;
-    size_t data_size;
-    char data[256];
+    uint32_t data_size;
+    Storage storage;
+    uint64_t arena_offset;
+    char data[kInlineCapacity];
+    
+    Message() : type(TEXT), sequence_id(0), data_size(0), storage(INLINE), arena_offset(0) {}
     
-    Message() : type(TEXT), sequence_id(0), data_size(0) {
-        memset(data, 0, sizeof(data));
+    // Inline message; content longer than kInlineCapacity is cut off, use
+    // MessageQueueManager::sendPayload() for larger payloads
+    Message(Type t, int seq, std::string_view content) 
+        : type(t), sequence_id(seq), storage(INLINE), arena_offset(0) {
+        data_size = static_cast<uint32_t>(std::min(content.size(), kInlineCapacity));
+        memcpy(data, content.data(), data_size);
     }
     
-    Message(Type t, int seq, const std::string& content) 
-        : type(t), sequence_id(seq) {
-        strncpy(data, content.c_str(), sizeof(data) - 1);
-        data_size = content.length();
+    // Bytes handed to mq_send
+    size_t wireSize() const {
+        return offsetof(Message, data) + (storage == INLINE ? data_size : 0);
     }
     
     std::string toString() const {
+        if (storage == ARENA) {
+            return "<" + std::to_string(data_size) + " bytes in arena>";
+        }
         return std::string(data, data_size);
     }
 };
@@ -46,14 +259,20 @@ private:
     mqd_t mq_descriptor_;
     struct mq_attr attributes_;
     bool is_creator_;
+    int epoll_fd_;
+    SharedPayloadArena* arena_;
+    bool verbose_;
+    
+    std::chrono::nanoseconds readable_wait_{0};  // Total time asleep in waitReadable()
 
 public:
-    MessageQueueManager(const char* queue_name, bool create = false) 
-        : queue_name_(queue_name), mq_descriptor_(-1), is_creator_(create) {
+    MessageQueueManager(const char* queue_name, bool create = false, long max_messages = 10) 
+        : queue_name_(queue_name), mq_descriptor_(-1), is_creator_(create),
+          epoll_fd_(-1), arena_(nullptr), verbose_(true) {
         
         // Set queue attributes
         attributes_.mq_flags = 0;           // Blocking mode
-        attributes_.mq_maxmsg = 10;         // Maximum messages in queue
+        attributes_.mq_maxmsg = max_messages;  // Maximum messages in queue
         attributes_.mq_msgsize = sizeof(Message);  // Maximum message size
         attributes_.mq_curmsgs = 0;         // Current messages (read-only)
     }
@@ -63,11 +282,26 @@ public:
     }
     
     bool initialize() {
-        if (is_creator_) {
-            return createQueue();
-        } else {
-            return openQueue();
-        }
+        bool ok = is_creator_ ? createQueue() : openQueue();
+        return ok && registerWithEpoll();
+    }
+    
+    // Payloads larger than Message::kInlineCapacity go through this arena;
+    // sender and receiver must attach the same one (by name)
+    void attachArena(SharedPayloadArena* arena) {
+        arena_ = arena;
+    }
+    
+    // The trace is for the step-by-step demos. The pooled server, the
+    // pipelined client and the benchmark senders run quiet.
+    void setVerbose(bool verbose) {
+        verbose_ = verbose;
+    }
+    
+    // On Linux an mqd_t is a file descriptor, so a queue can sit in any
+    // epoll set next to sockets and pipes
+    int fd() const {
+        return mq_descriptor_;
     }
 
 private:
@@ -86,7 +320,7 @@ private:
             return false;
         }
         
-        std::cout << "Message queue created: " << queue_name_ << std::endl;
+        if (verbose_) std::cout << "Message queue created: " << queue_name_ << std::endl;
         return true;
     }
     
@@ -99,7 +333,23 @@ private:
             return false;
         }
         
-        std::cout << "Opened existing message queue: " << queue_name_ << std::endl;
+        if (verbose_) std::cout << "Opened existing message queue: " << queue_name_ << std::endl;
+        return true;
+    }
+    
+    bool registerWithEpoll() {
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd_ == -1) {
+            perror("epoll_create1");
+            return false;
+        }
+        struct epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = mq_descriptor_;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, mq_descriptor_, &ev) == -1) {
+            perror("epoll_ctl (mq)");
+            return false;
+        }
         return true;
     }
 
@@ -110,24 +360,66 @@ public:
             return false;
         }
         
-        if (mq_send(mq_descriptor_, 
-                   reinterpret_cast<const char*>(&msg), 
-                   sizeof(Message), 
-                   priority) == -1) {
+        int result = mq_send(mq_descriptor_, 
+                             reinterpret_cast<const char*>(&msg), 
+                             msg.wireSize(), 
+                             priority);
+        if (result == -1) {
             if (errno == EAGAIN) {
-                std::cerr << "Queue is full\n";
+                if (verbose_) std::cerr << "Queue is full\n";
             } else {
                 perror("mq_send");
             }
             return false;
         }
         
-        std::cout << "Sent message: type=" << msg.type 
-                  << ", seq=" << msg.sequence_id 
-                  << ", data=" << msg.toString() << std::endl;
+        if (verbose_) {
+            std::cout << "Sent message: type=" << msg.type 
+                      << ", seq=" << msg.sequence_id 
+                      << ", data=" << msg.toString() << std::endl;
+        }
         return true;
     }
     
+    // Any size up to SharedPayloadArena::maxPayload(): small payloads are
+    // sent inline, large ones are copied once into the arena and sent as a
+    // descriptor. Fails if the queue or the arena is full.
+    bool sendPayload(Message::Type type, int seq, std::string_view payload, unsigned int priority = 0) {
+        if (payload.size() <= Message::kInlineCapacity) {
+            return sendMessage(Message(type, seq, payload), priority);
+        }
+        
+        Message msg;
+        msg.type = type;
+        msg.sequence_id = seq;
+        msg.data_size = static_cast<uint32_t>(payload.size());
+        msg.storage = Message::ARENA;
+        if (!arena_ || !arena_->allocate(payload.size(), msg.arena_offset)) {
+            if (verbose_) std::cerr << "No arena block for a " << payload.size() << "-byte payload\n";
+            errno = EAGAIN;
+            return false;
+        }
+        memcpy(arena_->data(msg.arena_offset), payload.data(), payload.size());
+        
+        if (!sendMessage(msg, priority)) {
+            int saved = errno;
+            arena_->release(msg.arena_offset);
+            errno = saved;
+            return false;
+        }
+        return true;
+    }
+    
+    // Sends messages in order until the queue fills up; returns how many
+    // went out, so the caller can wait for space and resume from there
+    size_t sendBatch(const Message* messages, size_t count, unsigned int priority = 0) {
+        size_t sent = 0;
+        while (sent < count && sendMessage(messages[sent], priority)) {
+            ++sent;
+        }
+        return sent;
+    }
+    
     bool receiveMessage(Message& msg, unsigned int* priority = nullptr) {
         if (mq_descriptor_ == -1) {
             std::cerr << "Queue not initialized\n";
@@ -154,13 +446,65 @@ public:
             *priority = prio;
         }
         
-        std::cout << "Received message: type=" << msg.type 
-                  << ", seq=" << msg.sequence_id 
-                  << ", data=" << msg.toString() 
-                  << ", priority=" << prio << std::endl;
+        if (verbose_) {
+            std::cout << "Received message: type=" << msg.type 
+                      << ", seq=" << msg.sequence_id 
+                      << ", data=" << msg.toString() 
+                      << ", priority=" << prio << std::endl;
+        }
         return true;
     }
     
+    // Drains up to max_messages without blocking; returns how many arrived
+    size_t receiveBatch(Message* messages, size_t max_messages) {
+        size_t received = 0;
+        while (received < max_messages && receiveMessage(messages[received])) {
+            ++received;
+        }
+        return received;
+    }
+    
+    // Sleeps in epoll_wait until a message is waiting (or timeout_ms passes),
+    // instead of polling mq_receive in a sleep loop
+    bool waitReadable(int timeout_ms) {
+        struct epoll_event ev;
+        int ready;
+        auto started = std::chrono::steady_clock::now();
+        do {
+            ready = epoll_wait(epoll_fd_, &ev, 1, timeout_ms);
+        } while (ready == -1 && errno == EINTR);
+        readable_wait_ += std::chrono::steady_clock::now() - started;
+        return ready > 0;
+    }
+    
+    std::chrono::nanoseconds readableWait() const { return readable_wait_; }
+    
+    // Sleeps until the queue has room for another message
+    bool waitWritable(int timeout_ms) {
+        struct pollfd pfd{mq_descriptor_, POLLOUT, 0};
+        int ready;
+        do {
+            ready = poll(&pfd, 1, timeout_ms);
+        } while (ready == -1 && errno == EINTR);
+        return ready > 0;
+    }
+    
+    // The payload where it lies: in the message, or in the arena block
+    std::string_view payload(const Message& msg) const {
+        if (msg.storage == Message::ARENA) {
+            return arena_ ? std::string_view(arena_->data(msg.arena_offset), msg.data_size) : std::string_view();
+        }
+        return std::string_view(msg.data, msg.data_size);
+    }
+    
+    // Returns an arena-backed payload's block; the view from payload() is
+    // invalid afterwards
+    void release(const Message& msg) {
+        if (msg.storage == Message::ARENA && arena_) {
+            arena_->release(msg.arena_offset);
+        }
+    }
+    
     // Blocking receive with timeout
     bool receiveMessageTimeout(Message& msg, int timeout_seconds) {
         if (mq_descriptor_ == -1) {
@@ -211,6 +555,11 @@ public:
     }
     
     void cleanup() {
+        if (epoll_fd_ != -1) {
+            close(epoll_fd_);
+            epoll_fd_ = -1;
+        }
+        
         if (mq_descriptor_ != -1) {
             mq_close(mq_descriptor_);
             mq_descriptor_ = -1;
@@ -218,93 +567,233 @@ public:
         
         if (is_creator_) {
             mq_unlink(queue_name_);
-            std::cout << "Message queue cleaned up: " << queue_name_ << std::endl;
+            if (verbose_) std::cout << "Message queue cleaned up: " << queue_name_ << std::endl;
+            is_creator_ = false;
         }
     }
 };
 
-// Advanced: Request-Response pattern
+// Advanced: Request-Response pattern. Requests carry a sequence id and
+// responses echo it, so a client can keep several requests in flight
+// (pipelining) and match responses that come back in any order.
 class RequestResponseClient {
 private:
+    SharedPayloadArena arena_;
     MessageQueueManager request_queue_;
     MessageQueueManager response_queue_;
     int sequence_counter_;
+    std::map<int, std::string> early_responses_;  // Arrived while waiting for another seq
+
+    // Waits for the response to seq, keeping any other response it sees
+    bool awaitResponse(int seq, std::string& response_data, int timeout_ms) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (true) {
+            auto early = early_responses_.find(seq);
+            if (early != early_responses_.end()) {
+                response_data = std::move(early->second);
+                early_responses_.erase(early);
+                return true;
+            }
+            
+            Message responses[16];
+            size_t count = response_queue_.receiveBatch(responses, 16);
+            for (size_t i = 0; i < count; ++i) {
+                early_responses_[responses[i].sequence_id] = std::string(response_queue_.payload(responses[i]));
+                response_queue_.release(responses[i]);
+            }
+            if (count > 0) continue;
+            
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (left <= 0) return false;
+            response_queue_.waitReadable(static_cast<int>(left));
+        }
+    }
+
+    bool sendWithRetry(int seq, std::string_view request_data) {
+        for (int attempts = 0; attempts < 100; ++attempts) {
+            if (request_queue_.sendPayload(Message::COMMAND, seq, request_data, 1)) {  // High priority
+                return true;
+            }
+            if (errno != EAGAIN) return false;
+            request_queue_.waitWritable(10);
+        }
+        return false;
+    }
 
 public:
     RequestResponseClient() 
-        : request_queue_("/request_queue", false),
+        : arena_("/request_arena", false),
+          request_queue_("/request_queue", false),
           response_queue_("/response_queue", false),
           sequence_counter_(0) {}
     
     bool initialize() {
-        return request_queue_.initialize() && response_queue_.initialize();
+        if (!arena_.initialize() || !request_queue_.initialize() || !response_queue_.initialize()) {
+            return false;
+        }
+        request_queue_.attachArena(&arena_);
+        response_queue_.attachArena(&arena_);
+        return true;
+    }
+    
+    void setVerbose(bool verbose) {
+        request_queue_.setVerbose(verbose);
+        response_queue_.setVerbose(verbose);
     }
     
+    // One request at a time
     bool sendRequest(const std::string& request_data, std::string& response_data) {
-        // Send request
-        Message request(Message::COMMAND, ++sequence_counter_, request_data);
-        if (!request_queue_.sendMessage(request, 1)) {  // High priority
+        int seq = ++sequence_counter_;
+        if (!sendWithRetry(seq, request_data)) {
+            return false;
+        }
+        if (!awaitResponse(seq, response_data, 1000)) {
+            std::cerr << "Timeout waiting for response\n";
             return false;
         }
+        return true;
+    }
+    
+    // Pipelined: keeps up to `window` requests in flight, so the server's
+    // workers can overlap them. responses[i] answers requests[i].
+    bool sendRequests(const std::vector<std::string>& requests, std::vector<std::string>& responses,
+                      size_t window = 8) {
+        responses.assign(requests.size(), std::string());
+        std::deque<std::pair<int, size_t>> in_flight;  // (seq, request index)
+        size_t next = 0;
         
-        // Wait for response
-        Message response;
-        for (int attempts = 0; attempts < 10; ++attempts) {
-            if (response_queue_.receiveMessage(response)) {
-                if (response.sequence_id == sequence_counter_) {
-                    response_data = response.toString();
-                    return true;
-                }
+        while (next < requests.size() || !in_flight.empty()) {
+            while (next < requests.size() && in_flight.size() < window) {
+                int seq = ++sequence_counter_;
+                if (!sendWithRetry(seq, requests[next])) return false;
+                in_flight.emplace_back(seq, next++);
+            }
+            // Oldest first; later responses that arrive meanwhile are kept
+            auto [seq, index] = in_flight.front();
+            in_flight.pop_front();
+            if (!awaitResponse(seq, responses[index], 5000)) {
+                std::cerr << "Timeout waiting for response " << seq << "\n";
+                return false;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        
-        std::cerr << "Timeout waiting for response\n";
-        return false;
+        return true;
     }
 };
 
 class RequestResponseServer {
 private:
+    SharedPayloadArena arena_;
     MessageQueueManager request_queue_;
     MessageQueueManager response_queue_;
+    std::atomic<bool> running_;
+    
+    std::mutex work_mutex_;
+    std::condition_variable work_available_;
+    std::deque<Message> work_;
 
 public:
     RequestResponseServer() 
-        : request_queue_("/request_queue", true),
-          response_queue_("/response_queue", true) {}
+        : arena_("/request_arena", true),
+          request_queue_("/request_queue", true),
+          response_queue_("/response_queue", true),
+          running_(false) {}
     
     bool initialize() {
-        return request_queue_.initialize() && response_queue_.initialize();
+        if (!arena_.initialize() || !request_queue_.initialize() || !response_queue_.initialize()) {
+            return false;
+        }
+        request_queue_.attachArena(&arena_);
+        response_queue_.attachArena(&arena_);
+        request_queue_.setVerbose(false);
+        response_queue_.setVerbose(false);
+        return true;
     }
     
-    void processRequests() {
-        std::cout << "Server started, waiting for requests...\n";
+    // Receives on this thread and hands requests to a pool of workers.
+    // Workers answer as soon as they finish, so responses can overtake each
+    // other; the client matches them by sequence id. Runs until stop().
+    void processRequests(size_t workers = 4) {
+        std::cout << "Server started with " << workers << " workers, waiting for requests...\n";
+        running_ = true;
+        
+        std::vector<std::thread> pool;
+        for (size_t i = 0; i < workers; ++i) {
+            pool.emplace_back(&RequestResponseServer::workerLoop, this);
+        }
+        
+        while (running_) {
+            // Blocks in epoll_wait instead of sleeping between polls
+            if (!request_queue_.waitReadable(100)) continue;
+            
+            Message batch[16];
+            size_t count = request_queue_.receiveBatch(batch, 16);
+            if (count == 0) continue;
+            {
+                std::lock_guard<std::mutex> lock(work_mutex_);
+                work_.insert(work_.end(), batch, batch + count);
+            }
+            if (count == 1) work_available_.notify_one();
+            else work_available_.notify_all();
+        }
         
+        // Requests already queued still get an answer; an arena payload
+        // left unreceived would never go back to the free list
+        Message batch[16];
+        while (size_t count = request_queue_.receiveBatch(batch, 16)) {
+            std::lock_guard<std::mutex> lock(work_mutex_);
+            work_.insert(work_.end(), batch, batch + count);
+        }
+        work_available_.notify_all();
+        for (auto& worker : pool) worker.join();
+    }
+    
+    void stop() {
+        running_ = false;
+    }
+
+private:
+    void workerLoop() {
         while (true) {
             Message request;
-            if (request_queue_.receiveMessage(request)) {
-                // Process request
-                std::string response_data = processRequest(request.toString());
-                
-                // Send response
-                Message response(Message::RESPONSE, request.sequence_id, response_data);
-                response_queue_.sendMessage(response);
+            {
+                std::unique_lock<std::mutex> lock(work_mutex_);
+                work_available_.wait(lock, [this] { return !work_.empty() || !running_; });
+                if (work_.empty()) return;
+                request = work_.front();
+                work_.pop_front();
             }
             
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            std::string response_data = processRequest(request_queue_.payload(request));
+            request_queue_.release(request);
+            
+            // Once stopped, a full response queue gets one more second to
+            // drain before the response is dropped. sendPayload gives its
+            // arena block back on every failure, so nothing leaks either way.
+            auto give_up = std::chrono::steady_clock::time_point::max();
+            while (!response_queue_.sendPayload(Message::RESPONSE, request.sequence_id, response_data)) {
+                if (errno != EAGAIN) break;
+                if (!running_) {
+                    auto now = std::chrono::steady_clock::now();
+                    if (give_up == std::chrono::steady_clock::time_point::max()) give_up = now + std::chrono::seconds(1);
+                    else if (now >= give_up) break;
+                }
+                response_queue_.waitWritable(10);
+            }
         }
     }
-
-private:
-    std::string processRequest(const std::string& request) {
-        std::cout << "Processing request: " << request << std::endl;
+    
+    std::string processRequest(std::string_view request) {
+        // One write per line, since several workers print at once
+        std::string line = "Processing request: " + std::string(request.substr(0, 40));
+        if (request.size() > 40) line += "... (" + std::to_string(request.size()) + " bytes)";
+        std::cout << line + "\n" << std::flush;
         
         // Simple echo server with timestamp
         auto now = std::chrono::system_clock::now();
         auto time_t = std::chrono::system_clock::to_time_t(now);
         
-        return "Echo: " + request + " (processed at " + std::to_string(time_t) + ")";
+        return "Echo: " + std::string(request) + " (processed at " + std::to_string(time_t) + ")";
     }
 };
 
@@ -331,7 +820,7 @@ void demonstrateBasicMessageQueue() {
         for (int i = 0; i < 5; ++i) {
             Message msg;
             while (!receiver.receiveMessage(msg)) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                receiver.waitReadable(1000);  // Sleeps in epoll until a message arrives
             }
         }
         
@@ -381,20 +870,25 @@ void demonstrateRequestResponse() {
     pid_t pid = fork();
     
     if (pid == 0) {
-        // Child process (server)
-        RequestResponseServer server;
-        if (!server.initialize()) {
-            std::cerr << "Server: Failed to initialize\n";
-            exit(1);
+        // Child process (server); the scope lets the destructors remove
+        // the queues and the arena before exit()
+        {
+            RequestResponseServer server;
+            if (!server.initialize()) {
+                std::cerr << "Server: Failed to initialize\n";
+                exit(1);
+            }
+            
+            // Process requests for a limited time
+            std::thread server_thread([&server]() {
+                server.processRequests(4);
+            });
+            
+            std::this_thread::sleep_for(std::chrono::seconds(5));
+            server.stop();
+            server_thread.join();
         }
         
-        // Process requests for a limited time
-        std::thread server_thread([&server]() {
-            server.processRequests();
-        });
-        
-        std::this_thread::sleep_for(std::chrono::seconds(5));
-        
         exit(0);
         
     } else if (pid > 0) {
@@ -426,6 +920,25 @@ void demonstrateRequestResponse() {
             std::this_thread::sleep_for(std::chrono::milliseconds(500));
         }
         
+        // Pipelined: 16 requests in flight at once, two of them too large
+        // for a message, so they and their echoes travel through the arena
+        std::vector<std::string> batch;
+        for (int i = 0; i < 16; ++i) {
+            batch.push_back(i % 8 == 7 ? std::string(20000, 'a' + i) : "Pipelined request " + std::to_string(i));
+        }
+        std::vector<std::string> responses;
+        client.setVerbose(false);
+        auto start = std::chrono::steady_clock::now();
+        bool ok = client.sendRequests(batch, responses, 8);
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+        
+        size_t matched = 0;
+        for (size_t i = 0; ok && i < batch.size(); ++i) {
+            if (responses[i].compare(0, 6 + batch[i].size(), "Echo: " + batch[i]) == 0) ++matched;
+        }
+        std::cout << "Pipelined " << batch.size() << " requests (window 8) in " << elapsed.count()
+                  << " ms, " << matched << " responses matched by sequence id\n";
+        
         // Wait for server to complete
         int status;
         wait(&status);
@@ -435,47 +948,119 @@ void demonstrateRequestResponse() {
     }
 }
 
-void benchmarkMessageQueue() {
-    std::cout << "\n=== Message Queue Performance Benchmark ===\n";
+// Sender process for the benchmarks. Waits for space with poll() when the
+// queue is full instead of sleeping.
+void runBenchmarkSender(const char* queue_name, const char* arena_name, int count, size_t payload_size) {
+    SharedPayloadArena arena(arena_name, false);
+    MessageQueueManager queue(queue_name, false);
+    queue.setVerbose(false);
+    if (!queue.initialize()) _exit(1);
+    if (payload_size > Message::kInlineCapacity) {
+        if (!arena.initialize()) _exit(1);
+        queue.attachArena(&arena);
+    }
     
+    std::string payload(payload_size, 'x');
+    if (payload_size <= Message::kInlineCapacity) {
+        // Small messages: fill a batch and send as much of it as fits
+        Message batch[32];
+        for (int sent = 0; sent < count;) {
+            size_t n = std::min<size_t>(32, count - sent);
+            for (size_t i = 0; i < n; ++i) batch[i] = Message(Message::DATA, sent + static_cast<int>(i), payload);
+            for (size_t done = 0; done < n;) {
+                done += queue.sendBatch(batch + done, n - done);
+                if (done < n) queue.waitWritable(1000);
+            }
+            sent += static_cast<int>(n);
+        }
+    } else {
+        // Large messages: the payload is copied once, into an arena block
+        for (int i = 0; i < count; ++i) {
+            while (!queue.sendPayload(Message::DATA, i, payload)) {
+                queue.waitWritable(1);  // Queue full, or every block still being read
+            }
+        }
+    }
+    _exit(0);
+}
+
+void benchmarkReceive(const char* label, bool sleep_polling, int count, size_t payload_size) {
     const char* queue_name = "/benchmark_queue";
-    const int iterations = 10000;
+    const char* arena_name = "/benchmark_arena";
     
+    SharedPayloadArena arena(arena_name, true);
     MessageQueueManager queue(queue_name, true);
-    if (!queue.initialize()) {
+    queue.setVerbose(false);
+    if (!arena.initialize() || !queue.initialize()) {
         std::cerr << "Failed to initialize queue for benchmark\n";
         return;
     }
+    queue.attachArena(&arena);
     
-    auto start = std::chrono::high_resolution_clock::now();
-    
-    // Send messages
-    for (int i = 0; i < iterations; ++i) {
-        Message msg(Message::DATA, i, "Benchmark data " + std::to_string(i));
-        while (!queue.sendMessage(msg)) {
-            std::this_thread::sleep_for(std::chrono::microseconds(10));
-        }
+    std::cout.flush();
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid == 0) runBenchmarkSender(queue_name, arena_name, count, payload_size);
+    if (pid < 0) {
+        perror("fork failed");
+        return;
     }
     
-    auto send_end = std::chrono::high_resolution_clock::now();
-    
-    // Receive messages
-    for (int i = 0; i < iterations; ++i) {
-        Message msg;
-        while (!queue.receiveMessage(msg)) {
-            std::this_thread::sleep_for(std::chrono::microseconds(10));
+    int received = 0, empty_polls = 0, errors = 0;
+    uint64_t checksum = 0;
+    while (received < count) {
+        if (sleep_polling) {
+            // The old approach: try, and sleep 10 µs whenever the queue is empty
+            Message msg;
+            if (queue.receiveMessage(msg)) {
+                if (msg.sequence_id != received) ++errors;
+                checksum += queue.payload(msg).size();
+                ++received;
+            } else {
+                ++empty_polls;
+                std::this_thread::sleep_for(std::chrono::microseconds(10));
+            }
+            continue;
+        }
+        
+        // Sleep in epoll until something arrives, then drain a batch
+        Message batch[32];
+        size_t n = queue.receiveBatch(batch, 32);
+        if (n == 0) {
+            ++empty_polls;
+            if (!queue.waitReadable(5000)) break;
+            continue;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            std::string_view data = queue.payload(batch[i]);  // Read in place
+            if (batch[i].sequence_id != received || data.size() != payload_size || data.back() != 'x') ++errors;
+            checksum += data.size();
+            queue.release(batch[i]);
+            ++received;
         }
     }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    waitpid(pid, nullptr, 0);
     
-    auto end = std::chrono::high_resolution_clock::now();
-    
-    auto send_duration = std::chrono::duration_cast<std::chrono::microseconds>(send_end - start);
-    auto total_duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    std::cout << label << ": " << received << " x " << payload_size << " bytes in "
+              << seconds * 1000 << " ms (" << received / seconds / 1000 << " K msgs/s, "
+              << checksum / seconds / (1 << 20) << " MB/s), waited for data " << empty_polls << " times";
+    if (!sleep_polling) {
+        std::cout << " (" << std::chrono::duration<double, std::milli>(queue.readableWait()).count()
+                  << " ms in epoll_wait)";
+    }
+    std::cout << (errors || received != count ? "  [ERRORS]" : "") << "\n";
+}
+
+void benchmarkMessageQueue() {
+    std::cout << "\n=== Message Queue Performance Benchmark ===\n";
+    std::cout << "Sender and receiver in separate processes, queue depth 10\n";
+    const int iterations = 20000;
     
-    std::cout << "Sent " << iterations << " messages in " << send_duration.count() << " μs\n";
-    std::cout << "Round-trip time: " << total_duration.count() << " μs\n";
-    std::cout << "Average send time: " << static_cast<double>(send_duration.count()) / iterations << " μs\n";
-    std::cout << "Messages per second: " << (iterations * 1000000.0) / total_duration.count() << "\n";
+    benchmarkReceive("Sleep-polling receive  ", true, iterations, 32);
+    benchmarkReceive("epoll + batch receive  ", false, iterations, 32);
+    benchmarkReceive("epoll + batch, 1 KB    ", false, iterations, 1024);
+    benchmarkReceive("epoll + batch, 64 KB   ", false, iterations / 4, 64 << 10);
 }
 
 int main() {
@@ -489,6 +1074,9 @@ int main() {
     std::cout << "3. Asynchronous communication pattern\n";
     std::cout << "4. Built-in synchronization and buffering\n";
     std::cout << "5. Perfect for producer-consumer scenarios\n";
+    std::cout << "6. Large payloads go through shared memory; the queue carries descriptors\n";
+    std::cout << "7. epoll on the queue descriptor replaces sleep-polling\n";
+    std::cout << "8. Time asleep in epoll_wait shows how long the receiver waited on the sender\n";
     
     return 0;
 }
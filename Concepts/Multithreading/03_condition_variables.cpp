@@ -7,6 +7,12 @@
 #include <chrono>
 #include <random>
 #include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
 
 // ===== CONDITION VARIABLES AND THREAD COMMUNICATION =====
 
@@ -178,7 +184,7 @@ void demonstrateSpuriousWakeups() {
 // Multiple condition variables for complex synchronization
 class WorkQueue {
 private:
-    std::mutex mutex_;
+    mutable std::mutex mutex_;
     std::condition_variable not_empty_;
     std::condition_variable not_full_;
     std::queue<int> queue_;
@@ -422,6 +428,334 @@ void demonstrateNotificationTypes() {
     std::cout << "Notification demonstration completed\n\n";
 }
 
+// Bounded lock-free MPMC queue (Dmitry Vyukov's sequence-number design)
+// - Capacity is a power of two, positions are masked instead of using %
+// - Each cell carries a sequence number telling producers and consumers
+//   whose turn it is, so a push or pop is one CAS on its own position counter
+// - Cells and both position counters are cache-line padded
+// - Blocking push/pop park on the cell's sequence with C++20 atomic::wait,
+//   and the other side only calls notify when someone is actually waiting
+template<typename T>
+class MPMCQueue {
+private:
+    static constexpr size_t kCacheLine = 64;
+    
+    struct alignas(kCacheLine) Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+        
+        T* item() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+    
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(kCacheLine) std::atomic<size_t> enqueue_pos_{0};
+    alignas(kCacheLine) std::atomic<size_t> dequeue_pos_{0};
+    alignas(kCacheLine) std::atomic<uint32_t> waiting_producers_{0};
+    std::atomic<uint32_t> waiting_consumers_{0};
+    
+    static size_t round_up_pow2(size_t n) {
+        size_t capacity = 2;
+        while (capacity < n) capacity <<= 1;
+        return capacity;
+    }
+    
+    static intptr_t diff(size_t a, size_t b) { return static_cast<intptr_t>(a - b); }
+    
+public:
+    explicit MPMCQueue(size_t capacity)
+        : mask_(round_up_pow2(capacity) - 1), cells_(new Cell[mask_ + 1]) {
+        for (size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+    
+    ~MPMCQueue() {
+        // No other thread may use the queue any more: destroy what is left
+        size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+        for (size_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != tail; ++pos) {
+            cells_[pos & mask_].item()->~T();
+        }
+    }
+    
+    size_t capacity() const { return mask_ + 1; }
+    
+    template<typename U>
+    bool try_push(U&& value) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t d = diff(seq, pos);
+            
+            if (d == 0) {
+                // Cell is free for this lap: claim the position
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    ::new (cell.storage) T(std::forward<U>(value));
+                    publish(cell, pos + 1, waiting_consumers_);
+                    return true;
+                }
+            } else if (d < 0) {
+                return false;  // Full: the consumer of the previous lap is not done
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    bool try_pop(T& out) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t d = diff(seq, pos + 1);
+            
+            if (d == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(*cell.item());
+                    cell.item()->~T();
+                    publish(cell, pos + mask_ + 1, waiting_producers_);
+                    return true;
+                }
+            } else if (d < 0) {
+                return false;  // Empty: the producer for this cell has not committed
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    // Pushes up to `count` items moved from `first` with a single CAS.
+    // Returns how many were pushed (fewer than count if the queue fills up).
+    template<typename It>
+    size_t push_n(It first, size_t count) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            size_t ready = 0;
+            while (ready < count && ready <= mask_ &&
+                   cells_[(pos + ready) & mask_].sequence.load(std::memory_order_acquire) == pos + ready) {
+                ++ready;
+            }
+            if (ready == 0) {
+                if (diff(cells_[pos & mask_].sequence.load(std::memory_order_acquire), pos) < 0) return 0;
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed)) {
+                for (size_t i = 0; i < ready; ++i, ++first) {
+                    Cell& cell = cells_[(pos + i) & mask_];
+                    ::new (cell.storage) T(std::move(*first));
+                    publish(cell, pos + i + 1, waiting_consumers_);
+                }
+                return ready;
+            }
+        }
+    }
+    
+    // Pops up to `max_count` items into `out` with a single CAS.
+    template<typename OutIt>
+    size_t pop_n(OutIt out, size_t max_count) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            size_t ready = 0;
+            while (ready < max_count && ready <= mask_ &&
+                   cells_[(pos + ready) & mask_].sequence.load(std::memory_order_acquire) == pos + ready + 1) {
+                ++ready;
+            }
+            if (ready == 0) {
+                if (diff(cells_[pos & mask_].sequence.load(std::memory_order_acquire), pos + 1) < 0) return 0;
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed)) {
+                for (size_t i = 0; i < ready; ++i) {
+                    Cell& cell = cells_[(pos + i) & mask_];
+                    *out++ = std::move(*cell.item());
+                    cell.item()->~T();
+                    publish(cell, pos + i + mask_ + 1, waiting_producers_);
+                }
+                return ready;
+            }
+        }
+    }
+    
+    // Blocking variants: sleep on the cell sequence instead of a mutex + condvar
+    template<typename U>
+    void push(U&& value) {
+        while (!try_push(std::forward<U>(value))) {
+            // Full at pos: the cell still holds the item pushed one lap ago,
+            // whose sequence is pos - capacity + 1 until a consumer frees it
+            size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            wait_on_cell(cells_[pos & mask_], pos - mask_, waiting_producers_);
+        }
+    }
+    
+    void pop(T& out) {
+        while (!try_pop(out)) {
+            // Empty at pos: the cell still has the sequence pos until the
+            // producer for this lap commits
+            size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+            wait_on_cell(cells_[pos & mask_], pos, waiting_consumers_);
+        }
+    }
+    
+    // Approximate, for monitoring only
+    size_t size_approx() const {
+        size_t head = dequeue_pos_.load(std::memory_order_relaxed);
+        size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+        return tail >= head ? tail - head : 0;
+    }
+    
+private:
+    void publish(Cell& cell, size_t sequence, std::atomic<uint32_t>& waiters) {
+        cell.sequence.store(sequence, std::memory_order_release);
+        // Pairs with the seq_cst increment in wait_on_cell(): either the
+        // waiter sees the new sequence, or we see the waiter and notify
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) != 0) {
+            cell.sequence.notify_all();
+        }
+    }
+    
+    // Sleeps only while the cell still shows this lap's "not ready" value.
+    // Any other value means the position moved on under us (another thread
+    // took the cell, or it is a lap ahead): sleeping on it would wait for the
+    // cell to come round again while publish() notifies other cells, so the
+    // caller reloads the position instead.
+    void wait_on_cell(Cell& cell, size_t not_ready, std::atomic<uint32_t>& waiters) {
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        if (cell.sequence.load(std::memory_order_seq_cst) == not_ready) {
+            cell.sequence.wait(not_ready, std::memory_order_acquire);
+        }
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
+
+void demonstrateMPMCQueue() {
+    std::cout << "=== Lock-Free Bounded MPMC Queue ===\n\n";
+    
+    MPMCQueue<int> queue(5);  // Rounded up to 8
+    std::cout << "Requested capacity 5, actual capacity: " << queue.capacity() << "\n";
+    
+    int pushed = 0;
+    while (queue.try_push(pushed)) ++pushed;
+    std::cout << "try_push accepted " << pushed << " items before reporting full\n";
+    
+    std::vector<int> batch;
+    size_t popped = queue.pop_n(std::back_inserter(batch), 5);
+    std::cout << "pop_n(5) returned " << popped << " items:";
+    for (int v : batch) std::cout << " " << v;
+    std::cout << "\n";
+    
+    std::vector<int> more = {100, 101, 102, 103, 104, 105, 106};
+    size_t accepted = queue.push_n(more.begin(), more.size());
+    std::cout << "push_n(7) accepted " << accepted << " items (space for 5)\n";
+    
+    // Blocking pop wakes up as soon as a producer commits
+    MPMCQueue<int> handoff(4);
+    std::thread consumer([&handoff] {
+        int value;
+        handoff.pop(value);
+        std::cout << "Blocking pop received: " << value << "\n";
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    handoff.push(7);
+    consumer.join();
+    std::cout << "\n";
+}
+
+// MPMCQueue as a thread pool task queue: workers block in pop(), an empty
+// std::function is the shutdown signal
+void demonstrateMPMCTaskQueue() {
+    std::cout << "=== MPMC Queue as a Thread Pool Task Queue ===\n\n";
+    
+    MPMCQueue<std::function<void()>> tasks(1024);
+    std::atomic<int> executed{0};
+    const int num_workers = 3;
+    
+    std::vector<std::thread> workers;
+    for (int w = 0; w < num_workers; ++w) {
+        workers.emplace_back([&tasks] {
+            std::function<void()> task;
+            while (true) {
+                tasks.pop(task);
+                if (!task) return;
+                task();
+            }
+        });
+    }
+    
+    std::vector<std::thread> submitters;
+    for (int s = 0; s < 4; ++s) {
+        submitters.emplace_back([&tasks, &executed] {
+            for (int i = 0; i < 5000; ++i) {
+                tasks.push([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    for (auto& t : submitters) t.join();
+    for (int w = 0; w < num_workers; ++w) tasks.push(std::function<void()>());
+    for (auto& t : workers) t.join();
+    
+    std::cout << "4 submitters, " << num_workers << " workers executed " << executed.load()
+              << " tasks (expected 20000)\n\n";
+}
+
+// Mutex + condvar queue vs lock-free ring for growing producer counts
+void benchmarkQueues() {
+    std::cout << "=== Queue Benchmark: ThreadSafeQueue vs MPMCQueue ===\n\n";
+    
+    const int items_per_producer = 200000;
+    const int num_consumers = 2;
+    
+    auto run = [&](int num_producers, auto& push, auto& pop) {
+        std::atomic<long long> consumed{0};
+        const long long total = static_cast<long long>(num_producers) * items_per_producer;
+        auto start = std::chrono::high_resolution_clock::now();
+        
+        std::vector<std::thread> threads;
+        for (int p = 0; p < num_producers; ++p) {
+            threads.emplace_back([&push, items_per_producer] {
+                for (int i = 0; i < items_per_producer; ++i) push(i);
+            });
+        }
+        for (int c = 0; c < num_consumers; ++c) {
+            threads.emplace_back([&] {
+                int item;
+                while (consumed.load(std::memory_order_relaxed) < total) {
+                    if (pop(item)) consumed.fetch_add(1, std::memory_order_relaxed);
+                    else std::this_thread::yield();
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+        
+        auto elapsed = std::chrono::high_resolution_clock::now() - start;
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        return total / seconds / 1e6;
+    };
+    
+    for (int producers : {1, 2, 4, 8}) {
+        ThreadSafeQueue<int> locked;
+        auto locked_push = [&locked](int v) { locked.push(v); };
+        auto locked_pop = [&locked](int& v) { return locked.try_pop(v); };
+        double locked_rate = run(producers, locked_push, locked_pop);
+        
+        MPMCQueue<int> lock_free(1 << 14);
+        auto lf_push = [&lock_free](int v) { while (!lock_free.try_push(v)) std::this_thread::yield(); };
+        auto lf_pop = [&lock_free](int& v) { return lock_free.try_pop(v); };
+        double lock_free_rate = run(producers, lf_push, lf_pop);
+        
+        std::cout << producers << " producers / " << num_consumers << " consumers: "
+                  << "ThreadSafeQueue " << locked_rate << " M items/s, "
+                  << "MPMCQueue " << lock_free_rate << " M items/s\n";
+    }
+    std::cout << "\n";
+}
+
 int main() {
     try {
         std::cout << "=== CONDITION VARIABLE CONCEPTS ===\n";
@@ -432,6 +766,9 @@ int main() {
         demonstrateBoundedQueue();
         demonstrateTimedWaits();
         demonstrateNotificationTypes();
+        demonstrateMPMCQueue();
+        demonstrateMPMCTaskQueue();
+        benchmarkQueues();
         
         std::cout << "=== KEY CONCEPTS COVERED ===\n";
         std::cout << "1. condition_variable for thread coordination\n";
@@ -441,7 +778,8 @@ int main() {
         std::cout << "5. Timed waits: wait_for and wait_until\n";
         std::cout << "6. notify_one vs notify_all strategies\n";
         std::cout << "7. Thread-safe queue implementation\n";
-        std::cout << "8. Graceful shutdown patterns\n\n";
+        std::cout << "8. Graceful shutdown patterns\n";
+        std::cout << "9. Lock-free bounded MPMC queue with atomic::wait blocking\n\n";
         
         std::cout << "=== NEXT STEPS ===\n";
         std::cout << "-> Run 04_atomic_operations.cpp to learn about lock-free programming\n";
@@ -517,6 +855,26 @@ Worker 4 got signal (remaining: 0)
 3. Finishing all workers:
 Notification demonstration completed
 
+=== Lock-Free Bounded MPMC Queue ===
+
+Requested capacity 5, actual capacity: 8
+try_push accepted 8 items before reporting full
+pop_n(5) returned 5 items: 0 1 2 3 4
+push_n(7) accepted 5 items (space for 5)
+Blocking pop received: 7
+
+=== MPMC Queue as a Thread Pool Task Queue ===
+
+4 submitters, 3 workers executed 20000 tasks (expected 20000)
+
+=== Queue Benchmark: ThreadSafeQueue vs MPMCQueue ===
+
+1 producers / 2 consumers: ThreadSafeQueue [rate] M items/s, MPMCQueue [rate] M items/s
+2 producers / 2 consumers: ThreadSafeQueue [rate] M items/s, MPMCQueue [rate] M items/s
+4 producers / 2 consumers: ThreadSafeQueue [rate] M items/s, MPMCQueue [rate] M items/s
+8 producers / 2 consumers: ThreadSafeQueue [rate] M items/s, MPMCQueue [rate] M items/s
+[the lock-free queue keeps scaling where the single mutex collapses]
+
 === KEY CONCEPTS COVERED ===
 1. condition_variable for thread coordination
 2. Producer-consumer pattern implementation
@@ -526,12 +884,13 @@ Notification demonstration completed
 6. notify_one vs notify_all strategies
 7. Thread-safe queue implementation
 8. Graceful shutdown patterns
+9. Lock-free bounded MPMC queue with atomic::wait blocking
 
 === NEXT STEPS ===
 -> Run 04_atomic_operations.cpp to learn about lock-free programming
 
 Compilation command:
-g++ -std=c++17 -Wall -Wextra -O2 -pthread 03_condition_variables.cpp -o 03_condition_variables
+g++ -std=c++20 -Wall -Wextra -O2 -pthread 03_condition_variables.cpp -o 03_condition_variables
 
 Key Learning Points:
 ===================
@@ -543,4 +902,6 @@ Key Learning Points:
 6. Timed waits prevent indefinite blocking
 7. Multiple condition variables can manage complex states
 8. Graceful shutdown requires careful state management
+9. A single mutex serializes every producer; per-cell sequence numbers let them proceed in parallel
+10. atomic::wait/notify gives blocking semantics without a mutex, notify only when someone waits
 */
@@ -4,6 +4,11 @@
 #include <vector>
 #include <chrono>
 #include <memory>
+#include <mutex>
+#include <algorithm>
+#include <optional>
+#include <new>
+#include <stdexcept>
 
 // ===== ATOMIC OPERATIONS AND LOCK-FREE PROGRAMMING =====
 
@@ -93,45 +98,315 @@ void demonstrateMemoryOrdering() {
     std::cout << "Memory ordering ensures data is visible when flag is set\n\n";
 }
 
-// Compare-and-swap based stack (lock-free)
+// ===== SAFE MEMORY RECLAMATION: HAZARD POINTERS =====
+// A thread publishes the node it is about to dereference in a hazard slot.
+// Unlinked nodes are retired to a per-thread list instead of being deleted;
+// once the list grows past a threshold, a scan reclaims only the nodes that
+// no hazard slot points at. A node can therefore never be freed (or reused,
+// which is what causes ABA) while another thread may still touch it.
+// The epoch-based alternative, with a Michael-Scott queue on top, is in
+// IPC/Synchronization Mechanisms/3. atomic.cpp.
+class HazardPointerDomain {
+public:
+    static constexpr size_t kMaxThreads = 128;
+    static constexpr size_t kSlotsPerThread = 2;
+    
+    using Reclaimer = void (*)(void*);
+    
+    static HazardPointerDomain& instance() {
+        static HazardPointerDomain domain;
+        return domain;
+    }
+    
+    std::atomic<void*>& slot(size_t index) {
+        return local().record->slots[index];
+    }
+    
+    void retire(void* ptr, Reclaimer reclaim) {
+        ThreadState& state = local();
+        state.retired.push_back({ptr, reclaim});
+        // Amortized O(1): scan only after collecting more nodes than there can be hazards
+        size_t threshold = 2 * kSlotsPerThread * used_records_.load(std::memory_order_relaxed) + 16;
+        if (state.retired.size() >= threshold) {
+            scan(state);
+        }
+    }
+    
+    ~HazardPointerDomain() {
+        for (const Retired& r : orphans_) r.reclaim(r.ptr);
+    }
+    
+private:
+    struct Retired {
+        void* ptr;
+        Reclaimer reclaim;
+    };
+    
+    struct alignas(64) Record {
+        std::atomic<bool> in_use{false};
+        std::atomic<void*> slots[kSlotsPerThread] = {};
+    };
+    
+    struct ThreadState {
+        Record* record = nullptr;
+        std::vector<Retired> retired;
+        std::vector<void*> hazards;  // Scratch space reused by every scan
+        
+        ~ThreadState() {
+            HazardPointerDomain& domain = instance();
+            if (!retired.empty()) {
+                // Still protected somewhere: hand over to whoever scans next
+                domain.scan(*this);
+                std::lock_guard<std::mutex> lock(domain.orphan_mutex_);
+                domain.orphans_.insert(domain.orphans_.end(), retired.begin(), retired.end());
+                domain.has_orphans_.store(true, std::memory_order_relaxed);
+            }
+            if (record) record->in_use.store(false, std::memory_order_release);
+        }
+    };
+    
+    Record records_[kMaxThreads];
+    std::atomic<size_t> used_records_{0};
+    std::mutex orphan_mutex_;
+    std::vector<Retired> orphans_;
+    std::atomic<bool> has_orphans_{false};
+    
+    HazardPointerDomain() = default;
+    
+    ThreadState& local() {
+        instance();  // The domain must outlive every ThreadState
+        static thread_local ThreadState state;
+        if (!state.record) state.record = acquire_record();
+        return state;
+    }
+    
+    Record* acquire_record() {
+        for (size_t i = 0; i < kMaxThreads; ++i) {
+            bool expected = false;
+            if (!records_[i].in_use.load(std::memory_order_relaxed) &&
+                records_[i].in_use.compare_exchange_strong(expected, true)) {
+                size_t used = used_records_.load();
+                while (used < i + 1 && !used_records_.compare_exchange_weak(used, i + 1)) {}
+                return &records_[i];
+            }
+        }
+        throw std::runtime_error("HazardPointerDomain: too many threads");
+    }
+    
+    void scan(ThreadState& state) {
+        if (has_orphans_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(orphan_mutex_);
+            state.retired.insert(state.retired.end(), orphans_.begin(), orphans_.end());
+            orphans_.clear();
+            has_orphans_.store(false, std::memory_order_relaxed);
+        }
+        
+        // 1. Snapshot every published hazard
+        state.hazards.clear();
+        size_t used = used_records_.load();
+        for (size_t i = 0; i < used; ++i) {
+            for (auto& slot : records_[i].slots) {
+                if (void* p = slot.load()) state.hazards.push_back(p);
+            }
+        }
+        std::sort(state.hazards.begin(), state.hazards.end());
+        
+        // 2. Reclaim whatever is not in the snapshot, keep the rest for later
+        auto keep = std::partition(state.retired.begin(), state.retired.end(),
+            [&state](const Retired& r) {
+                return std::binary_search(state.hazards.begin(), state.hazards.end(), r.ptr);
+            });
+        for (auto it = keep; it != state.retired.end(); ++it) {
+            it->reclaim(it->ptr);
+        }
+        state.retired.erase(keep, state.retired.end());
+    }
+};
+
+// RAII owner of one of the calling thread's hazard slots
+class HazardPointer {
+private:
+    std::atomic<void*>& slot_;
+    
+public:
+    explicit HazardPointer(size_t index = 0)
+        : slot_(HazardPointerDomain::instance().slot(index)) {}
+    
+    HazardPointer(const HazardPointer&) = delete;
+    HazardPointer& operator=(const HazardPointer&) = delete;
+    
+    ~HazardPointer() { reset(); }
+    
+    // Publish-then-validate: once the source still holds the value we
+    // published, no scan can miss it, so the node is safe to dereference
+    template<typename T>
+    T* protect(const std::atomic<T*>& source) {
+        T* ptr = source.load();
+        while (true) {
+            slot_.store(ptr);
+            T* current = source.load();
+            if (current == ptr) return ptr;
+            ptr = current;
+        }
+    }
+    
+    void reset() { slot_.store(nullptr, std::memory_order_release); }
+};
+
+// Node recycling so that steady-state push/pop never reaches the global
+// allocator. Each thread keeps a small cache; whole batches move between
+// caches and a shared depot, so the depot lock is taken once per kBatch
+// nodes. Batching matters because the threads that free nodes (poppers)
+// are usually not the ones that allocate them (pushers).
+template<typename Node>
+class NodePool {
+public:
+    static constexpr size_t kBatch = 64;
+    
+    static void* allocate() {
+        if (cache_destroyed_) return allocate_during_thread_exit();
+        Cache& cache = local();
+        if (cache.nodes.empty()) {
+            Depot& d = depot();
+            std::lock_guard<std::mutex> lock(d.mutex);
+            size_t take = std::min(kBatch, d.nodes.size());
+            cache.nodes.insert(cache.nodes.end(), d.nodes.end() - take, d.nodes.end());
+            d.nodes.resize(d.nodes.size() - take);
+        }
+        if (cache.nodes.empty()) {
+            heap_allocations_.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(sizeof(Node));
+        }
+        void* node = cache.nodes.back();
+        cache.nodes.pop_back();
+        return node;
+    }
+    
+    static void deallocate(void* node) {
+        if (cache_destroyed_) {
+            // Late frees at thread exit (e.g. a final hazard scan) bypass the cache
+            Depot& d = depot();
+            std::lock_guard<std::mutex> lock(d.mutex);
+            d.nodes.push_back(node);
+            return;
+        }
+        Cache& cache = local();
+        cache.nodes.push_back(node);
+        if (cache.nodes.size() >= 2 * kBatch) {
+            Depot& d = depot();
+            std::lock_guard<std::mutex> lock(d.mutex);
+            d.nodes.insert(d.nodes.end(), cache.nodes.end() - kBatch, cache.nodes.end());
+            cache.nodes.resize(cache.nodes.size() - kBatch);
+        }
+    }
+    
+    static size_t heap_allocations() { return heap_allocations_.load(std::memory_order_relaxed); }
+    
+private:
+    struct Depot {
+        std::mutex mutex;
+        std::vector<void*> nodes;
+    };
+    
+    struct Cache {
+        std::vector<void*> nodes;
+        
+        Cache() {
+            nodes.reserve(2 * kBatch);
+        }
+        
+        ~Cache() {
+            Depot& d = depot();
+            std::lock_guard<std::mutex> lock(d.mutex);
+            d.nodes.insert(d.nodes.end(), nodes.begin(), nodes.end());
+            cache_destroyed_ = true;
+        }
+    };
+    
+    static inline std::atomic<size_t> heap_allocations_{0};
+    static inline thread_local bool cache_destroyed_ = false;
+    
+    // Intentionally never destroyed: thread caches and the hazard pointer
+    // domain may still return nodes during static destruction
+    static Depot& depot() {
+        static Depot* d = new Depot;
+        return *d;
+    }
+    
+    static void* allocate_during_thread_exit() {
+        heap_allocations_.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(sizeof(Node));
+    }
+    
+    static Cache& local() {
+        static thread_local Cache cache;
+        return cache;
+    }
+};
+
+// Compare-and-swap based stack (lock-free, hazard-pointer protected)
 template<typename T>
 class LockFreeStack {
 private:
     struct Node {
-        std::atomic<T*> data;
+        T data;
         Node* next;
         
-        Node() : data(nullptr), next(nullptr) {}
+        template<typename U>
+        explicit Node(U&& value) : data(std::forward<U>(value)), next(nullptr) {}
     };
     
     std::atomic<Node*> head_;
     
+    static void reclaim(void* ptr) {
+        Node* node = static_cast<Node*>(ptr);
+        node->~Node();
+        NodePool<Node>::deallocate(node);
+    }
+    
 public:
     LockFreeStack() : head_(nullptr) {}
     
+    LockFreeStack(const LockFreeStack&) = delete;
+    LockFreeStack& operator=(const LockFreeStack&) = delete;
+    
+    ~LockFreeStack() {
+        Node* node = head_.load();
+        while (node) {
+            Node* next = node->next;
+            reclaim(node);
+            node = next;
+        }
+    }
+    
     void push(T item) {
-        Node* new_node = new Node;
-        new_node->data.store(new T(std::move(item)));
-        new_node->next = head_.load();
+        Node* new_node = new (NodePool<Node>::allocate()) Node(std::move(item));
+        new_node->next = head_.load(std::memory_order_relaxed);
         
         // CAS loop to update head
-        while (!head_.compare_exchange_weak(new_node->next, new_node)) {
+        while (!head_.compare_exchange_weak(new_node->next, new_node,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
             // new_node->next is updated by compare_exchange_weak on failure
         }
     }
     
-    std::unique_ptr<T> pop() {
-        Node* old_head = head_.load();
+    std::optional<T> pop() {
+        HazardPointer hazard;
+        Node* old_head;
         
-        while (old_head && !head_.compare_exchange_weak(old_head, old_head->next)) {
-            // old_head is updated by compare_exchange_weak on failure
+        while (true) {
+            old_head = hazard.protect(head_);
+            if (!old_head) return std::nullopt;
+            
+            // Safe: old_head cannot be reclaimed (or recycled) while protected,
+            // so the CAS below cannot succeed on a reused node (no ABA)
+            if (head_.compare_exchange_weak(old_head, old_head->next)) break;
         }
         
-        std::unique_ptr<T> result;
-        if (old_head) {
-            result.reset(old_head->data.load());
-            delete old_head;
-        }
+        hazard.reset();
+        std::optional<T> result(std::move(old_head->data));
+        HazardPointerDomain::instance().retire(old_head, &LockFreeStack::reclaim);
         return result;
     }
     
@@ -139,8 +414,7 @@ public:
         return head_.load() == nullptr;
     }
     
-    // Note: This is a simplified implementation
-    // Production code would need hazard pointers or epochs for memory reclamation
+    static size_t node_heap_allocations() { return NodePool<Node>::heap_allocations(); }
 };
 
 void demonstrateLockFreeStack() {
@@ -354,12 +628,45 @@ void demonstrateABAProblem() {
     }
     
     std::cout << "Note: In production, use hazard pointers or epochs to solve ABA problem\n\n";
+    
+    // The fix: LockFreeStack protects the head with a hazard pointer before
+    // reading head->next, and defers reuse of popped nodes until no thread
+    // holds a hazard on them. Hammer it with concurrent push/pop pairs.
+    std::cout << "Hazard-pointer stack under contention:\n";
+    LockFreeStack<long> safe_stack;
+    const int num_threads = 4;
+    const int rounds = 200000;
+    std::atomic<long> popped_sum{0};
+    std::vector<std::thread> threads;
+    
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&safe_stack, &popped_sum, rounds, t] {
+            long local_sum = 0;
+            for (int i = 0; i < rounds; ++i) {
+                safe_stack.push(static_cast<long>(t) * rounds + i);
+                if (auto item = safe_stack.pop()) local_sum += *item;
+            }
+            popped_sum.fetch_add(local_sum);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    
+    long remaining_sum = 0;
+    while (auto item = safe_stack.pop()) remaining_sum += *item;
+    
+    long n = static_cast<long>(num_threads) * rounds;
+    long expected = n * (n - 1) / 2;
+    std::cout << "Pushed and popped " << n << " items, checksum "
+              << (popped_sum.load() + remaining_sum == expected ? "OK" : "MISMATCH") << "\n";
+    std::cout << "Nodes taken from the global allocator: "
+              << LockFreeStack<long>::node_heap_allocations()
+              << " (the rest were recycled from the node pool)\n\n";
 }
 
 // Performance comparison: atomic vs mutex
 class MutexCounter {
 private:
-    std::mutex mutex_;
+    mutable std::mutex mutex_;
     int counter_ = 0;
     
 public:
@@ -447,7 +754,8 @@ int main() {
         std::cout << "5. Wait-free vs lock-free guarantees\n";
         std::cout << "6. ABA problem in lock-free algorithms\n";
         std::cout << "7. Atomic shared_ptr operations\n";
-        std::cout << "8. Performance comparison: atomics vs mutexes\n\n";
+        std::cout << "8. Performance comparison: atomics vs mutexes\n";
+        std::cout << "9. Hazard pointers for safe memory reclamation\n\n";
         
         std::cout << "=== NEXT STEPS ===\n";
         std::cout << "-> Run 05_futures_promises.cpp to learn about asynchronous programming\n";
@@ -520,6 +828,10 @@ Initial stack: 3 -> 2 -> 1
 Popped: 3
 Note: In production, use hazard pointers or epochs to solve ABA problem
 
+Hazard-pointer stack under contention:
+Pushed and popped 800000 items, checksum OK
+Nodes taken from the global allocator: [small number] (the rest were recycled from the node pool)
+
 === Atomic vs Mutex Performance Comparison ===
 
 Atomic counter time: [atomic_time] ms (result: 2000000)
@@ -535,6 +847,7 @@ Speedup: [speedup]x
 6. ABA problem in lock-free algorithms
 7. Atomic shared_ptr operations
 8. Performance comparison: atomics vs mutexes
+9. Hazard pointers for safe memory reclamation
 
 === NEXT STEPS ===
 -> Run 05_futures_promises.cpp to learn about asynchronous programming
@@ -552,4 +865,6 @@ Key Learning Points:
 6. Atomics are generally faster than mutexes for simple operations
 7. Lock-free programming is complex and error-prone
 8. Use standard atomic types when possible, avoid rolling your own
+9. Never delete a node another thread may be reading: retire it and reclaim after a hazard scan
+10. Recycling nodes is only safe once reclamation proves nobody holds them, otherwise it causes ABA
 */
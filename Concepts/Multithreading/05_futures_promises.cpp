@@ -6,6 +6,22 @@
 #include <string>
 #include <exception>
 #include <functional>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#if __cplusplus >= 202002L
+#include <stop_token>
+#endif
 
 // ===== FUTURES, PROMISES, AND ASYNC PROGRAMMING =====
 
@@ -221,6 +237,546 @@ void demonstrateFutureStatus() {
     std::cout << "\n";
 }
 
+// ===== CONTINUATION FUTURES =====
+//
+// std::future cannot express "when this is ready, run that". A dependent
+// step has to block some thread in get(), or launch yet another
+// std::async, which usually means a new OS thread per step. Future<T>
+// below takes continuations instead:
+//
+//   asyncOn(pool, load).then(parse).then(validate)
+//
+// Each step is a single make_shared allocation that holds the step's
+// shared state, its callable and the hook its predecessor calls. Steps
+// run on an Executor: inline on the completing thread, or on a pool.
+// Nothing blocks until the final get().
+
+struct OperationCancelled : std::runtime_error {
+    OperationCancelled() : std::runtime_error("operation cancelled") {}
+};
+
+// Cancellation uses std::stop_token where C++20 provides it (see
+// 07_modern_synchronization.cpp); otherwise a minimal stand-in with the
+// same interface
+#if __cplusplus >= 202002L
+using StopSource = std::stop_source;
+using StopToken = std::stop_token;
+#else
+class StopToken {
+    std::shared_ptr<std::atomic<bool>> flag_;
+    friend class StopSource;
+    explicit StopToken(std::shared_ptr<std::atomic<bool>> flag) : flag_(std::move(flag)) {}
+
+public:
+    StopToken() = default;
+    bool stop_requested() const noexcept { return flag_ && flag_->load(std::memory_order_acquire); }
+};
+
+class StopSource {
+    std::shared_ptr<std::atomic<bool>> flag_ = std::make_shared<std::atomic<bool>>(false);
+
+public:
+    StopToken get_token() const noexcept { return StopToken(flag_); }
+    bool request_stop() noexcept { return !flag_->exchange(true, std::memory_order_acq_rel); }
+};
+#endif
+
+struct Runnable {
+    virtual ~Runnable() = default;
+    virtual void run() = 0;
+};
+
+class Executor {
+public:
+    virtual ~Executor() = default;
+    virtual void execute(std::shared_ptr<Runnable> task) = 0;
+};
+
+// Runs the task on the calling thread
+class InlineExecutor : public Executor {
+public:
+    void execute(std::shared_ptr<Runnable> task) override { task->run(); }
+};
+
+// Fixed worker threads draining one queue. Tasks are already-allocated
+// future states, so queueing one does not wrap it in a std::function.
+class ContinuationPool : public Executor {
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable available_;
+    std::deque<std::shared_ptr<Runnable>> queue_;
+    bool stopping_ = false;
+
+public:
+    explicit ContinuationPool(size_t threads) {
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this] {
+                for (;;) {
+                    std::shared_ptr<Runnable> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        available_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+                        if (queue_.empty()) return;
+                        task = std::move(queue_.front());
+                        queue_.pop_front();
+                    }
+                    task->run();
+                }
+            });
+        }
+    }
+
+    // Drains the queue before joining
+    ~ContinuationPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        available_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    void execute(std::shared_ptr<Runnable> task) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(std::move(task));
+        }
+        available_.notify_one();
+    }
+};
+
+// Shared pool for the demos. Some demo tasks sleep, so there are at least
+// four workers even on small machines.
+inline ContinuationPool& continuationPool() {
+    static ContinuationPool pool(std::max(4u, std::thread::hardware_concurrency()));
+    return pool;
+}
+
+// Value or error, plus at most one continuation. The executor and stop
+// token are inherited by continuations that do not name their own.
+template<typename T>
+class FutureState {
+private:
+    mutable std::mutex mutex_;
+    mutable std::condition_variable readyCv_;
+    bool ready_ = false;
+    std::optional<T> value_;
+    std::exception_ptr error_;
+    std::shared_ptr<Runnable> continuation_;
+    Executor* continuationExecutor_ = nullptr;
+
+    static void dispatch(std::shared_ptr<Runnable> task, Executor* executor) {
+        if (executor) {
+            executor->execute(std::move(task));
+        } else {
+            task->run();
+        }
+    }
+
+    template<typename Store>
+    void complete(Store&& store) {
+        std::shared_ptr<Runnable> next;
+        Executor* executor;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (ready_) throw std::logic_error("future state already satisfied");
+            store();
+            ready_ = true;
+            next = std::move(continuation_);
+            executor = continuationExecutor_;
+        }
+        readyCv_.notify_all();
+        if (next) dispatch(std::move(next), executor);
+    }
+
+public:
+    Executor* executor = nullptr;  // nullptr: run continuations inline
+    StopToken token;
+
+    FutureState() = default;
+    FutureState(Executor* exec, StopToken stop) : executor(exec), token(std::move(stop)) {}
+    virtual ~FutureState() = default;
+
+    void setValue(T value) { complete([&] { value_.emplace(std::move(value)); }); }
+    void setError(std::exception_ptr error) { complete([&] { error_ = std::move(error); }); }
+
+    // Runs next on exec once this state is ready; right away if it already is
+    void attach(std::shared_ptr<Runnable> next, Executor* exec) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!ready_) {
+                continuation_ = std::move(next);
+                continuationExecutor_ = exec;
+                return;
+            }
+        }
+        dispatch(std::move(next), exec);
+    }
+
+    bool isReady() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return ready_;
+    }
+
+    void wait() const {
+        std::unique_lock<std::mutex> lock(mutex_);
+        readyCv_.wait(lock, [this] { return ready_; });
+    }
+
+    // Only valid once ready; continuations are dispatched after that point
+    std::exception_ptr error() const { return error_; }
+    T takeValue() { return std::move(*value_); }
+
+    T get() {
+        wait();
+        if (error_) std::rethrow_exception(error_);
+        return takeValue();
+    }
+};
+
+template<typename T>
+class Future;
+
+// Completes the next state from callable(args...), turning a throw or a
+// stop request into an error
+template<typename T, typename F, typename... Args>
+void completeWith(FutureState<T>& state, F& callable, Args&&... args) {
+    if (state.token.stop_requested()) {
+        state.setError(std::make_exception_ptr(OperationCancelled()));
+        return;
+    }
+    std::optional<T> result;
+    try {
+        result.emplace(callable(std::forward<Args>(args)...));
+    } catch (...) {
+        state.setError(std::current_exception());
+        return;
+    }
+    state.setValue(std::move(*result));
+}
+
+template<typename F>
+class TaskState : public FutureState<std::invoke_result_t<F&>>, public Runnable {
+    F f_;
+
+public:
+    TaskState(F f, Executor* exec, StopToken token)
+        : FutureState<std::invoke_result_t<F&>>(exec, std::move(token)), f_(std::move(f)) {}
+    void run() override { completeWith(*this, f_); }
+};
+
+template<typename T, typename F>
+class ThenState : public FutureState<std::invoke_result_t<F&, T>>, public Runnable {
+    std::shared_ptr<FutureState<T>> parent_;
+    F f_;
+
+public:
+    ThenState(std::shared_ptr<FutureState<T>> parent, F f, Executor* exec)
+        : FutureState<std::invoke_result_t<F&, T>>(exec, parent->token), parent_(std::move(parent)), f_(std::move(f)) {}
+
+    void run() override {
+        auto parent = std::move(parent_);  // Breaks the parent -> continuation -> parent cycle
+        if (auto error = parent->error()) {
+            this->setError(error);
+        } else {
+            completeWith(*this, f_, parent->takeValue());
+        }
+    }
+};
+
+template<typename T>
+class Future {
+private:
+    std::shared_ptr<FutureState<T>> state_;
+
+    template<typename U>
+    friend class Future;
+    template<typename U>
+    friend class Promise;
+    template<typename U>
+    friend Future<std::vector<U>> whenAll(std::vector<Future<U>> futures);
+    template<typename U>
+    friend Future<std::pair<size_t, U>> whenAny(std::vector<Future<U>> futures);
+
+public:
+    Future() = default;
+    explicit Future(std::shared_ptr<FutureState<T>> state) : state_(std::move(state)) {}
+
+    bool valid() const { return state_ != nullptr; }
+    bool isReady() const { return state_->isReady(); }
+    void wait() const { state_->wait(); }
+
+    // Blocks until ready, then returns the value or rethrows the error
+    T get() {
+        auto state = std::move(state_);
+        return state->get();
+    }
+
+    // f(T) runs once this future holds a value; errors and cancellation
+    // skip f and pass straight to the returned future. The continuation
+    // runs on exec, or on this future's executor if none is given.
+    template<typename F>
+    auto then(Executor& exec, F f) && {
+        using U = std::invoke_result_t<F&, T>;
+        static_assert(!std::is_void_v<U>, "continuations must return a value");
+        auto next = std::make_shared<ThenState<T, F>>(state_, std::move(f), &exec);
+        auto parent = std::move(state_);
+        parent->attach(next, &exec);
+        return Future<U>(std::move(next));
+    }
+
+    template<typename F>
+    auto then(F f) && {
+        using U = std::invoke_result_t<F&, T>;
+        static_assert(!std::is_void_v<U>, "continuations must return a value");
+        Executor* exec = state_->executor;
+        auto next = std::make_shared<ThenState<T, F>>(state_, std::move(f), exec);
+        auto parent = std::move(state_);
+        parent->attach(next, exec);
+        return Future<U>(std::move(next));
+    }
+};
+
+template<typename T>
+class Promise {
+private:
+    std::shared_ptr<FutureState<T>> state_;
+
+public:
+    explicit Promise(Executor* exec = nullptr, StopToken token = {})
+        : state_(std::make_shared<FutureState<T>>(exec, std::move(token))) {}
+    Promise(Promise&&) = default;
+    Promise& operator=(Promise&&) = default;
+
+    // An unsatisfied promise completes its future with broken_promise
+    ~Promise() {
+        if (state_ && !state_->isReady()) {
+            state_->setError(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+        }
+    }
+
+    Future<T> getFuture() { return Future<T>(state_); }
+    void setValue(T value) { state_->setValue(std::move(value)); }
+    void setException(std::exception_ptr error) { state_->setError(std::move(error)); }
+};
+
+// Runs f on exec; continuations of the result stay on exec by default
+template<typename F>
+auto asyncOn(Executor& exec, F f, StopToken token = {}) {
+    auto state = std::make_shared<TaskState<F>>(std::move(f), &exec, std::move(token));
+    exec.execute(state);
+    return Future<std::invoke_result_t<F&>>(std::move(state));
+}
+
+// Completes when every input has. The result keeps input order; the first
+// failing input (by index) supplies the error. A single allocation holds
+// the hook for every input.
+template<typename T>
+class WhenAllState : public FutureState<std::vector<T>> {
+public:
+    struct Input : Runnable {
+        WhenAllState* owner = nullptr;
+        size_t index = 0;
+        std::shared_ptr<FutureState<T>> source;
+        void run() override { owner->arrive(index, std::move(source)); }
+    };
+
+    std::vector<Input> inputs;
+
+private:
+    std::vector<std::optional<T>> values_;
+    std::vector<std::exception_ptr> errors_;
+    std::atomic<size_t> remaining_;
+
+    void arrive(size_t index, std::shared_ptr<FutureState<T>> source) {
+        if (auto error = source->error()) {
+            errors_[index] = error;
+        } else {
+            values_[index].emplace(source->takeValue());
+        }
+        if (remaining_.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+        for (auto& error : errors_) {
+            if (error) {
+                this->setError(error);
+                return;
+            }
+        }
+        std::vector<T> results;
+        results.reserve(values_.size());
+        for (auto& value : values_) results.push_back(std::move(*value));
+        this->setValue(std::move(results));
+    }
+
+public:
+    explicit WhenAllState(size_t count) : inputs(count), values_(count), errors_(count), remaining_(count) {}
+};
+
+template<typename T>
+Future<std::vector<T>> whenAll(std::vector<Future<T>> futures) {
+    auto state = std::make_shared<WhenAllState<T>>(futures.size());
+    if (futures.empty()) state->setValue({});
+    for (size_t i = 0; i < futures.size(); ++i) {
+        auto& input = state->inputs[i];
+        input.owner = state.get();
+        input.index = i;
+        input.source = std::move(futures[i].state_);
+        // Aliasing shared_ptr: the hook keeps the whole WhenAllState alive
+        input.source->attach(std::shared_ptr<Runnable>(state, &input), nullptr);
+    }
+    return Future<std::vector<T>>(std::move(state));
+}
+
+// Completes with (index, value) of the first input to finish, or with its
+// error if that input failed. Later completions are ignored.
+template<typename T>
+class WhenAnyState : public FutureState<std::pair<size_t, T>> {
+public:
+    struct Input : Runnable {
+        WhenAnyState* owner = nullptr;
+        size_t index = 0;
+        std::shared_ptr<FutureState<T>> source;
+        void run() override { owner->arrive(index, std::move(source)); }
+    };
+
+    std::vector<Input> inputs;
+
+private:
+    std::atomic<bool> decided_{false};
+
+    void arrive(size_t index, std::shared_ptr<FutureState<T>> source) {
+        if (decided_.exchange(true, std::memory_order_acq_rel)) return;
+        if (auto error = source->error()) {
+            this->setError(error);
+        } else {
+            this->setValue({index, source->takeValue()});
+        }
+    }
+
+public:
+    explicit WhenAnyState(size_t count) : inputs(count) {}
+};
+
+template<typename T>
+Future<std::pair<size_t, T>> whenAny(std::vector<Future<T>> futures) {
+    if (futures.empty()) throw std::invalid_argument("whenAny needs at least one future");
+    auto state = std::make_shared<WhenAnyState<T>>(futures.size());
+    for (size_t i = 0; i < futures.size(); ++i) {
+        auto& input = state->inputs[i];
+        input.owner = state.get();
+        input.index = i;
+        input.source = std::move(futures[i].state_);
+        input.source->attach(std::shared_ptr<Runnable>(state, &input), nullptr);
+    }
+    return Future<std::pair<size_t, T>>(std::move(state));
+}
+
+void demonstrateContinuationFutures() {
+    std::cout << "=== Continuation Futures (then / whenAll / whenAny) ===\n\n";
+    ContinuationPool& pool = continuationPool();
+
+    // 1. A pipeline that never blocks a thread between steps
+    std::cout << "1. Pipeline of dependent steps on a pool:\n";
+    auto pipeline = asyncOn(pool, [] { return std::string("42"); })
+                        .then([](std::string text) { return std::stoi(text); })
+                        .then([](int value) { return value * 2.5; });
+    std::cout << "   \"42\" -> parse -> * 2.5 = " << pipeline.get() << "\n";
+
+    // 2. Inline continuations run on whichever thread completes the promise
+    std::cout << "\n2. Inline continuation on the producing thread:\n";
+    Promise<int> promise;
+    auto onProducer = promise.getFuture().then([](int value) {
+        std::cout << "   Continuation sees " << value << " on the producer thread\n";
+        return value + 1;
+    });
+    std::thread producer([&promise] { promise.setValue(7); });
+    producer.join();
+    std::cout << "   Result: " << onProducer.get() << "\n";
+
+    // 3. Errors skip the remaining steps
+    std::cout << "\n3. Error propagation:\n";
+    auto failing = asyncOn(pool, []() -> int { throw std::runtime_error("sensor offline"); })
+                       .then([](int value) { return value * 2; });
+    try {
+        failing.get();
+    } catch (const std::exception& e) {
+        std::cout << "   Caught: " << e.what() << "\n";
+    }
+
+    // 4. Cancellation through a stop token shared by the chain
+    std::cout << "\n4. Cancellation with a stop token:\n";
+    StopSource stop;
+    std::atomic<bool> stepTwoRan{false};
+    auto cancellable = asyncOn(pool, [] {
+                           std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                           return 1;
+                       }, stop.get_token())
+                           .then([&stepTwoRan](int value) {
+                               stepTwoRan = true;
+                               return value + 1;
+                           });
+    stop.request_stop();  // While step 1 is still sleeping
+    try {
+        cancellable.get();
+    } catch (const OperationCancelled& e) {
+        std::cout << "   Caught: " << e.what() << " (step 2 ran: " << (stepTwoRan ? "yes" : "no") << ")\n";
+    }
+
+    // 5. First answer wins
+    std::cout << "\n5. whenAny:\n";
+    std::vector<Future<std::string>> replicas;
+    for (int i = 0; i < 3; ++i) {
+        replicas.push_back(asyncOn(pool, [i] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(60 - i * 20));
+            return "replica " + std::to_string(i);
+        }));
+    }
+    auto fastest = whenAny(std::move(replicas)).get();
+    std::cout << "   First answer: " << fastest.second << " (index " << fastest.first << ")\n\n";
+}
+
+// Three dependent steps, timed for std::async nesting against continuations
+void benchmarkContinuations() {
+    std::cout << "=== Pipeline Cost: std::async vs Continuations ===\n\n";
+    auto step1 = [](double x) { return x * x; };
+    auto step2 = [](double x) { return x + 10.0; };
+    auto step3 = [](double x) { return std::sqrt(x); };
+
+    auto perChainUs = [](int chains, auto&& body) {
+        auto start = std::chrono::steady_clock::now();
+        double checksum = 0;
+        for (int i = 0; i < chains; ++i) checksum += body(static_cast<double>(i));
+        auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        return std::make_pair(elapsed / chains, checksum);
+    };
+
+    auto asyncResult = perChainUs(500, [&](double x) {
+        return std::async(std::launch::async, [&, x] {
+                   double a = std::async(std::launch::async, step1, x).get();
+                   double b = std::async(std::launch::async, step2, a).get();
+                   return step3(b);
+               }).get();
+    });
+
+    ContinuationPool& pool = continuationPool();
+    auto poolResult = perChainUs(20000, [&](double x) {
+        return asyncOn(pool, [&, x] { return step1(x); }).then(step2).then(step3).get();
+    });
+
+    InlineExecutor inlineExecutor;
+    auto inlineResult = perChainUs(20000, [&](double x) {
+        return asyncOn(inlineExecutor, [&, x] { return step1(x); }).then(step2).then(step3).get();
+    });
+
+    std::printf("   nested std::async (3 threads per chain): %8.2f us/chain\n", asyncResult.first);
+    std::printf("   Future::then on ContinuationPool:        %8.2f us/chain\n", poolResult.first);
+    std::printf("   Future::then inline:                     %8.2f us/chain\n", inlineResult.first);
+    std::cout << "   (one allocation per step; results "
+              << (std::abs(poolResult.second / 20000 - inlineResult.second / 20000) < 1e-9 ? "agree" : "DIFFER")
+              << ")\n\n";
+}
+
 // Multiple futures and coordination
 void demonstrateMultipleFutures() {
     std::cout << "=== Multiple Futures Coordination ===\n\n";
@@ -269,7 +825,29 @@ void demonstrateMultipleFutures() {
     duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
     
     std::cout << "   Sequential total: " << total << "\n";
-    std::cout << "   Sequential execution time: " << duration.count() << " ms\n\n";
+    std::cout << "   Sequential execution time: " << duration.count() << " ms\n";
+    
+    // 3. Same fan-out, combined by a continuation instead of get() in a loop
+    std::cout << "\n3. Parallel execution with whenAll:\n";
+    start_time = std::chrono::high_resolution_clock::now();
+    
+    std::vector<Future<int>> pending;
+    for (int i = 0; i < 4; ++i) {
+        pending.push_back(asyncOn(continuationPool(), [i]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100 + i * 50));
+            return i * i;
+        }));
+    }
+    auto sum = whenAll(std::move(pending)).then([](std::vector<int> results) {
+        return std::accumulate(results.begin(), results.end(), 0);
+    });
+    total = sum.get();
+    
+    end_time = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    
+    std::cout << "   whenAll total: " << total << "\n";
+    std::cout << "   whenAll execution time: " << duration.count() << " ms\n\n";
 }
 
 // Advanced async patterns
@@ -305,6 +883,27 @@ public:
         });
     }
     
+    // The same chain as continuations: each step is queued when the
+    // previous one finishes, and no thread waits in between
+    Future<double> calculate_complex_chained(double x) {
+        return asyncOn(continuationPool(), [x]() {
+                   std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                   std::cout << "   Step 1 complete: " << x << "² = " << x * x << "\n";
+                   return x * x;
+               })
+            .then([](double step1_result) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                std::cout << "   Step 2 complete: " << step1_result << " + 10 = " << step1_result + 10.0 << "\n";
+                return step1_result + 10.0;
+            })
+            .then([](double step2_result) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                double final_result = std::sqrt(step2_result);
+                std::cout << "   Step 3 complete: √" << step2_result << " = " << final_result << "\n";
+                return final_result;
+            });
+    }
+    
     // Async operation with cancellation-like behavior
     std::future<std::string> long_running_task(std::chrono::milliseconds timeout) {
         auto promise = std::make_shared<std::promise<std::string>>();
@@ -350,8 +949,14 @@ void demonstrateAdvancedAsync() {
     double result = complex_future.get();
     std::cout << "   Final result: " << result << "\n";
     
-    // 2. Async with timeout simulation
-    std::cout << "\n2. Long-running task with timeout:\n";
+    // 2. Same chain with continuations
+    std::cout << "\n2. Chained continuations:\n";
+    auto chained_future = calc.calculate_complex_chained(5.0);
+    double chained_result = chained_future.get();
+    std::cout << "   Final result: " << chained_result << "\n";
+    
+    // 3. Async with timeout simulation
+    std::cout << "\n3. Long-running task with timeout:\n";
     auto timeout_future = calc.long_running_task(std::chrono::milliseconds(1000));
     
     try {
@@ -422,8 +1027,10 @@ int main() {
         demonstratePackagedTask();
         demonstrateFutureStatus();
         demonstrateMultipleFutures();
+        demonstrateContinuationFutures();
         demonstrateAdvancedAsync();
         demonstrateAsyncExceptions();
+        benchmarkContinuations();
         
         std::cout << "=== KEY CONCEPTS COVERED ===\n";
         std::cout << "1. std::async for launching asynchronous tasks\n";
@@ -433,7 +1040,8 @@ int main() {
         std::cout << "5. Future status checking and timeouts\n";
         std::cout << "6. Multiple futures coordination and aggregation\n";
         std::cout << "7. Exception propagation in async operations\n";
-        std::cout << "8. Advanced patterns: chaining and cancellation\n\n";
+        std::cout << "8. Advanced patterns: chaining and cancellation\n";
+        std::cout << "9. Continuation futures: then, whenAll, whenAny, stop tokens\n\n";
         
         std::cout << "=== NEXT STEPS ===\n";
         std::cout << "-> Run 06_thread_pool.cpp to learn about thread pool patterns\n";
@@ -527,6 +1135,28 @@ This file covers asynchronous programming in C++
    Sequential total: 14
    Sequential execution time: ~800 ms
 
+3. Parallel execution with whenAll:
+   whenAll total: 14
+   whenAll execution time: ~250 ms
+
+=== Continuation Futures (then / whenAll / whenAny) ===
+
+1. Pipeline of dependent steps on a pool:
+   "42" -> parse -> * 2.5 = 105
+
+2. Inline continuation on the producing thread:
+   Continuation sees 7 on the producer thread
+   Result: 8
+
+3. Error propagation:
+   Caught: sensor offline
+
+4. Cancellation with a stop token:
+   Caught: operation cancelled (step 2 ran: no)
+
+5. whenAny:
+   First answer: replica 2 (index 2)
+
 === Advanced Async Patterns ===
 
 1. Chained async operations:
@@ -536,7 +1166,13 @@ This file covers asynchronous programming in C++
    Step 3 complete: √35 = 5.91608
    Final result: 5.91608
 
-2. Long-running task with timeout:
+2. Chained continuations:
+   Step 1 complete: 5² = 25
+   Step 2 complete: 25 + 10 = 35
+   Step 3 complete: √35 = 5.91608
+   Final result: 5.91608
+
+3. Long-running task with timeout:
    Progress: 0%
    Task failed: Task timeout
 
@@ -551,6 +1187,13 @@ This file covers asynchronous programming in C++
    Task 2 failed: Task 2 failed
    Task 3 succeeded: 30
 
+=== Pipeline Cost: std::async vs Continuations ===
+
+   nested std::async (3 threads per chain):    [~40] us/chain
+   Future::then on ContinuationPool:           [~15] us/chain
+   Future::then inline:                        [<1] us/chain
+   (one allocation per step; results agree)
+
 === KEY CONCEPTS COVERED ===
 1. std::async for launching asynchronous tasks
 2. std::promise and std::future for thread communication
@@ -560,12 +1203,14 @@ This file covers asynchronous programming in C++
 6. Multiple futures coordination and aggregation
 7. Exception propagation in async operations
 8. Advanced patterns: chaining and cancellation
+9. Continuation futures: then, whenAll, whenAny, stop tokens
 
 === NEXT STEPS ===
 -> Run 06_thread_pool.cpp to learn about thread pool patterns
 
 Compilation command:
 g++ -std=c++17 -Wall -Wextra -O2 -pthread 05_futures_promises.cpp -o 05_futures_promises
+(C++20 uses std::stop_token for cancellation: -std=c++20)
 
 Key Learning Points:
 ===================
@@ -577,4 +1222,5 @@ Key Learning Points:
 6. Exception propagation works seamlessly through futures
 7. Parallel execution can provide significant speedup
 8. Always handle exceptions in async operations
+9. Continuations (then/whenAll/whenAny) chain steps without blocking a thread per step
 */
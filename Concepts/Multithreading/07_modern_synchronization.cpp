@@ -2,6 +2,15 @@
 #include <thread>
 #include <vector>
 #include <chrono>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
 
 // C++20 features - conditional compilation based on availability
 #if __cplusplus >= 202002L
@@ -325,59 +334,151 @@ void demonstrateModernFeatures() {
 
 #endif
 
-// Performance comparison of synchronization primitives
+// ===== CONTENDED INCREMENT TIMING =====
+
+// One warmup, then timedRuns() runs of `threads` threads each calling
+// body() once. Threads start together, so the timed window is all
+// contention and no thread creation. Each result is one line with
+// p50/p90/p99 ns per increment over the runs, the same line and CSV
+// columns as the other thread benchmarks (06_thread_pool.cpp,
+// IPC/2. mutex); BenchmarkSuite in 08_performance_analysis.cpp is the
+// full harness. BENCH_OUTPUT_DIR=<dir> writes <dir>/<suite>.csv,
+// BENCH_REPEATS overrides the number of timed runs.
+inline int timedRuns() {
+    static const int runs = [] {
+        const char* repeats = std::getenv("BENCH_REPEATS");
+        return repeats ? std::max(1, std::atoi(repeats)) : 5;
+    }();
+    return runs;
+}
+
+class ContentionReport {
+private:
+    struct Row {
+        std::string name;
+        int threads;
+        uint64_t ops;
+        std::vector<double> ns;  // Per increment, one per timed run, sorted
+    };
+    
+    std::string suite_;
+    std::vector<Row> rows_;
+    
+    static double percentile(const std::vector<double>& sorted, double p) {
+        double rank = p * static_cast<double>(sorted.size() - 1);
+        size_t low = static_cast<size_t>(rank);
+        size_t high = std::min(low + 1, sorted.size() - 1);
+        return sorted[low] + (sorted[high] - sorted[low]) * (rank - static_cast<double>(low));
+    }
+
+public:
+    explicit ContentionReport(std::string suite) : suite_(std::move(suite)) {}
+    
+    ContentionReport(const ContentionReport&) = delete;
+    ContentionReport& operator=(const ContentionReport&) = delete;
+    
+    ~ContentionReport() {
+        const char* dir = std::getenv("BENCH_OUTPUT_DIR");
+        if (!dir || rows_.empty()) return;
+        std::string path = std::string(dir) + "/" + suite_ + ".csv";
+        std::ofstream out(path);
+        if (!out) {
+            std::cerr << "ContentionReport: cannot write " << path << "\n";
+            return;
+        }
+        out << "suite,name,threads,ops,samples,min_ns,median_ns,p90_ns,p99_ns,max_ns,mean_ns,stddev_ns\n";
+        for (const Row& row : rows_) {
+            double mean = 0, squares = 0;
+            for (double ns : row.ns) mean += ns / static_cast<double>(row.ns.size());
+            for (double ns : row.ns) squares += (ns - mean) * (ns - mean);
+            out << suite_ << ",\"" << row.name << "\"," << row.threads << "," << row.ops << "," << row.ns.size()
+                << "," << row.ns.front() << "," << percentile(row.ns, 0.5) << "," << percentile(row.ns, 0.9)
+                << "," << percentile(row.ns, 0.99) << "," << row.ns.back() << "," << mean << ","
+                << std::sqrt(squares / static_cast<double>(row.ns.size())) << "\n";
+        }
+    }
+    
+    // Returns the p50 ns per increment
+    template <typename Body>
+    double time(const std::string& name, int threads, int increments_per_thread, Body body) {
+        Row row{name, threads, static_cast<uint64_t>(threads) * increments_per_thread, {}};
+        for (int run = 0; run <= timedRuns(); ++run) {
+            std::atomic<int> ready{0};
+            std::atomic<bool> go{false};
+            std::vector<std::thread> workers;
+            for (int t = 0; t < threads; ++t) {
+                workers.emplace_back([&] {
+                    ready.fetch_add(1);
+                    while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                    body();
+                });
+            }
+            while (ready.load() < threads) std::this_thread::yield();
+            auto start = std::chrono::steady_clock::now();
+            go.store(true, std::memory_order_release);
+            for (auto& worker : workers) worker.join();
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            if (run > 0) row.ns.push_back(elapsed.count() / static_cast<double>(row.ops));
+        }
+        std::sort(row.ns.begin(), row.ns.end());
+        std::printf("%s [%d %s]: p50 %.2f ns/op, p90 %.2f, p99 %.2f (n=%zu)\n", name.c_str(), threads,
+                    threads == 1 ? "thread" : "threads", percentile(row.ns, 0.5), percentile(row.ns, 0.9),
+                    percentile(row.ns, 0.99), row.ns.size());
+        rows_.push_back(std::move(row));
+        return percentile(rows_.back().ns, 0.5);
+    }
+};
+
+// Performance comparison of synchronization primitives: the same shared
+// counter increment at 1, 2, 4, ... threads
 void benchmarkSynchronizationPrimitives() {
     std::cout << "=== Synchronization Primitives Performance Comparison ===\n\n";
     
     const int num_iterations = 100000;
-    const int num_threads = 4;
+    std::vector<int> thread_counts;
+    const int max_threads = std::max(4, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int n = 1; n < max_threads; n *= 2) thread_counts.push_back(n);
+    thread_counts.push_back(max_threads);
     
-    // Benchmark std::atomic
     std::atomic<int> atomic_counter{0};
-    auto start = std::chrono::high_resolution_clock::now();
+    std::mutex mutex_lock;
+    int mutex_counter = 0;
+#if __cplusplus >= 202002L
+    // A binary semaphore used as a lock: same exclusion, but no owner, so
+    // it cannot do priority inheritance or catch a wrong-thread release
+    std::binary_semaphore semaphore_lock{1};
+    int semaphore_counter = 0;
+#endif
     
-    std::vector<std::thread> atomic_threads;
-    for (int i = 0; i < num_threads; ++i) {
-        atomic_threads.emplace_back([&atomic_counter, num_iterations]() {
+    ContentionReport report("sync_primitives");
+    long long expected = 0;
+    for (int threads : thread_counts) {
+        double atomic_ns = report.time("atomic fetch_add", threads, num_iterations, [&] {
             for (int j = 0; j < num_iterations; ++j) {
                 atomic_counter.fetch_add(1, std::memory_order_relaxed);
             }
         });
-    }
-    
-    for (auto& t : atomic_threads) {
-        t.join();
-    }
-    
-    auto atomic_time = std::chrono::high_resolution_clock::now() - start;
-    
-    // Benchmark std::mutex
-    std::mutex mutex_lock;
-    int mutex_counter = 0;
-    start = std::chrono::high_resolution_clock::now();
-    
-    std::vector<std::thread> mutex_threads;
-    for (int i = 0; i < num_threads; ++i) {
-        mutex_threads.emplace_back([&mutex_lock, &mutex_counter, num_iterations]() {
+        double mutex_ns = report.time("std::mutex", threads, num_iterations, [&] {
             for (int j = 0; j < num_iterations; ++j) {
                 std::lock_guard<std::mutex> lock(mutex_lock);
                 ++mutex_counter;
             }
         });
+#if __cplusplus >= 202002L
+        report.time("std::binary_semaphore", threads, num_iterations, [&] {
+            for (int j = 0; j < num_iterations; ++j) {
+                semaphore_lock.acquire();
+                ++semaphore_counter;
+                semaphore_lock.release();
+            }
+        });
+#endif
+        std::cout << "  atomic over mutex at " << threads << (threads == 1 ? " thread: " : " threads: ")
+                  << mutex_ns / atomic_ns << "x\n";
+        expected += static_cast<long long>(timedRuns() + 1) * threads * num_iterations;
     }
-    
-    for (auto& t : mutex_threads) {
-        t.join();
-    }
-    
-    auto mutex_time = std::chrono::high_resolution_clock::now() - start;
-    
-    auto atomic_ms = std::chrono::duration_cast<std::chrono::milliseconds>(atomic_time).count();
-    auto mutex_ms = std::chrono::duration_cast<std::chrono::milliseconds>(mutex_time).count();
-    
-    std::cout << "Atomic operations time: " << atomic_ms << " ms (result: " << atomic_counter.load() << ")\n";
-    std::cout << "Mutex operations time: " << mutex_ms << " ms (result: " << mutex_counter << ")\n";
-    std::cout << "Atomic speedup: " << static_cast<double>(mutex_ms) / atomic_ms << "x\n\n";
+    std::cout << "\nCounts correct: " << (atomic_counter.load() == expected && mutex_counter == expected ? "Yes" : "No")
+              << "\n\n";
 }
 
 int main() {
@@ -492,9 +593,15 @@ Consumer finished processing
 
 === Synchronization Primitives Performance Comparison ===
 
-Atomic operations time: [fast_time] ms (result: 400000)
-Mutex operations time: [slower_time] ms (result: 400000)
-Atomic speedup: [speedup]x
+atomic fetch_add [1 thread]: p50 6.40 ns/op, p90 6.52, p99 6.53 (n=5)
+std::mutex [1 thread]: p50 18.54 ns/op, p90 18.74, p99 18.80 (n=5)
+std::binary_semaphore [1 thread]: p50 231.23 ns/op, p90 241.70, p99 242.58 (n=5)
+  atomic over mutex at 1 thread: 2.89496x
+atomic fetch_add [2 threads]: p50 7.31 ns/op, p90 8.26, p99 8.81 (n=5)
+[... the same three rows and ratio at 2, 4, ... up to max(4, hardware_concurrency())
+     threads; figures above are from a 1-CPU VM]
+
+Counts correct: Yes
 
 === KEY CONCEPTS COVERED ===
 1. std::barrier for multi-phase synchronization
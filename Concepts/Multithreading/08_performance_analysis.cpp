@@ -9,25 +9,516 @@
 #include <memory>
 #include <algorithm>
 #include <random>
+#include <shared_mutex>
+#include <cstdint>
+#include <cstdio>
+#include <sched.h>
+#include <pthread.h>
+#include <stdexcept>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// ===== BENCHMARK HARNESS =====
+
+// Every measurement goes through a BenchmarkSuite. It does warmup runs first
+// (page faults, cold caches, lazily created thread stacks), then several
+// timed runs, and reports the median and percentiles so that one noisy run
+// does not decide the result. Set BENCH_OUTPUT_DIR to also write each suite
+// to <dir>/<suite>.json, or to .csv with BENCH_FORMAT=csv, so CI can track
+// regressions. BENCH_REPEATS overrides the number of timed runs.
+
+// Makes the compiler assume `value` is read and may be modified here. A
+// computation whose result is only used to be measured is therefore kept,
+// without the extra store a volatile sink would add inside the loop.
+template <typename T>
+inline void doNotOptimize(T& value) {
+    asm volatile("" : "+m"(value) : : "memory");
+}
+
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "m"(value) : "memory");
+}
+
+// Timestamps come from the CPU's time-stamp counter where there is one.
+// rdtsc is a ~20 cycle instruction with no vDSO call behind it, and it
+// ticks at a constant rate on current CPUs (constant_tsc). Calibrating it
+// once against steady_clock is enough to turn ticks into nanoseconds.
+class BenchClock {
+public:
+    static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+    
+    static const char* source() {
+#if defined(__x86_64__) || defined(__i386__)
+        return "rdtsc";
+#else
+        return "steady_clock";
+#endif
+    }
+    
+    static double nsPerTick() {
+        static const double ns_per_tick = calibrate();
+        return ns_per_tick;
+    }
+    
+    static double toNs(uint64_t ticks) { return static_cast<double>(ticks) * nsPerTick(); }
+    
+    // Cost of reading the clock back to back, subtracted from per-call samples
+    static uint64_t overheadTicks() {
+        static const uint64_t overhead = [] {
+            uint64_t best = UINT64_MAX;
+            for (int i = 0; i < 1000; ++i) {
+                uint64_t start = now();
+                best = std::min(best, now() - start);
+            }
+            return best;
+        }();
+        return overhead;
+    }
 
-// Performance measurement utilities
-class Timer {
 private:
-    std::chrono::high_resolution_clock::time_point start_time;
+    static double calibrate() {
+#if defined(__x86_64__) || defined(__i386__)
+        auto wall_start = std::chrono::steady_clock::now();
+        uint64_t ticks_start = now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        uint64_t ticks = now() - ticks_start;
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - wall_start).count();
+        return ns / static_cast<double>(ticks);
+#else
+        return 1.0;
+#endif
+    }
+};
+
+struct BenchmarkResult {
     std::string name;
+    int threads = 0;               // Set by runThreads(); 0 for run() and sampleLatency()
+    uint64_t ops = 1;              // Operations per timed run (1 for per-call samples)
+    std::vector<double> ns_per_op; // One entry per timed run or sample, sorted
+    double min = 0, median = 0, p90 = 0, p99 = 0, max = 0, mean = 0, stddev = 0;
+};
+
+inline double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    double rank = p * static_cast<double>(sorted.size() - 1);
+    size_t low = static_cast<size_t>(rank);
+    size_t high = std::min(low + 1, sorted.size() - 1);
+    return sorted[low] + (sorted[high] - sorted[low]) * (rank - static_cast<double>(low));
+}
+
+inline std::string formatNs(double ns) {
+    char text[32];
+    if (ns < 1e3) std::snprintf(text, sizeof(text), "%.2f ns", ns);
+    else if (ns < 1e6) std::snprintf(text, sizeof(text), "%.2f us", ns / 1e3);
+    else if (ns < 1e9) std::snprintf(text, sizeof(text), "%.2f ms", ns / 1e6);
+    else std::snprintf(text, sizeof(text), "%.2f s", ns / 1e9);
+    return text;
+}
+
+struct BenchmarkOptions {
+    int warmup = 1;
+    int repeats = 5;
+    bool print = true;  // One line per result as it completes
+};
+
+class BenchmarkSuite {
+private:
+    std::string name_;
+    BenchmarkOptions options_;
+    std::vector<BenchmarkResult> results_;
+    
+    const BenchmarkResult& record(const std::string& name, int threads, uint64_t ops,
+                                  std::vector<double> samples) {
+        BenchmarkResult result;
+        result.name = name;
+        result.threads = threads;
+        result.ops = ops;
+        std::sort(samples.begin(), samples.end());
+        result.min = samples.front();
+        result.max = samples.back();
+        result.median = percentile(samples, 0.5);
+        result.p90 = percentile(samples, 0.9);
+        result.p99 = percentile(samples, 0.99);
+        double sum = 0, squares = 0;
+        for (double sample : samples) sum += sample;
+        result.mean = sum / static_cast<double>(samples.size());
+        for (double sample : samples) squares += (sample - result.mean) * (sample - result.mean);
+        result.stddev = std::sqrt(squares / static_cast<double>(samples.size()));
+        result.ns_per_op = std::move(samples);
+        results_.push_back(std::move(result));
+        if (options_.print) printResult(results_.back());
+        return results_.back();
+    }
+    
+    // Threads are created before the clock starts and released together
+    template <typename Body>
+    static double timeThreads(int threads, Body& body) {
+        std::atomic<int> ready{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                ready.fetch_add(1);
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                body(t);
+            });
+        }
+        while (ready.load() < threads) std::this_thread::yield();
+        uint64_t start = BenchClock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& worker : workers) worker.join();
+        return BenchClock::toNs(BenchClock::now() - start);
+    }
+    
+    void exportResults() const {
+        const char* dir = std::getenv("BENCH_OUTPUT_DIR");
+        if (!dir || results_.empty()) return;
+        const char* format = std::getenv("BENCH_FORMAT");
+        bool csv = format && std::string(format) == "csv";
+        std::string path = std::string(dir) + "/" + name_ + (csv ? ".csv" : ".json");
+        std::ofstream out(path);
+        if (!out) {
+            std::cerr << "BenchmarkSuite: cannot write " << path << "\n";
+            return;
+        }
+        if (csv) writeCsv(out);
+        else writeJson(out);
+    }
+
+public:
+    explicit BenchmarkSuite(std::string name, BenchmarkOptions options = BenchmarkOptions())
+        : name_(std::move(name)), options_(options) {
+        if (const char* repeats = std::getenv("BENCH_REPEATS")) options_.repeats = std::max(1, std::atoi(repeats));
+    }
+    
+    ~BenchmarkSuite() { exportResults(); }
+    
+    BenchmarkSuite(const BenchmarkSuite&) = delete;
+    BenchmarkSuite& operator=(const BenchmarkSuite&) = delete;
+    
+    // body() performs `ops` operations; it may start its own threads
+    template <typename Body>
+    const BenchmarkResult& run(const std::string& name, uint64_t ops, Body&& body) {
+        for (int i = 0; i < options_.warmup; ++i) body();
+        std::vector<double> samples;
+        for (int i = 0; i < options_.repeats; ++i) {
+            uint64_t start = BenchClock::now();
+            body();
+            samples.push_back(BenchClock::toNs(BenchClock::now() - start) / static_cast<double>(ops));
+        }
+        return record(name, 0, ops, std::move(samples));
+    }
+    
+    // body(thread_index) runs on each of `threads` threads and performs
+    // ops_per_thread operations; ns/op is wall time over all operations
+    template <typename Body>
+    const BenchmarkResult& runThreads(const std::string& name, int threads, uint64_t ops_per_thread, Body&& body) {
+        const double total_ops = static_cast<double>(ops_per_thread) * threads;
+        std::vector<double> samples;
+        for (int i = 0; i < options_.warmup + options_.repeats; ++i) {
+            double ns = timeThreads(threads, body);
+            if (i >= options_.warmup) samples.push_back(ns / total_ops);
+        }
+        return record(name, threads, ops_per_thread * threads, std::move(samples));
+    }
+    
+    // The same per-thread workload at each thread count (weak scaling)
+    template <typename Body>
+    std::vector<BenchmarkResult> sweepThreads(const std::string& name, const std::vector<int>& counts,
+                                              uint64_t ops_per_thread, Body&& body) {
+        std::vector<BenchmarkResult> sweep;
+        for (int threads : counts) sweep.push_back(runThreads(name, threads, ops_per_thread, body));
+        return sweep;
+    }
+    
+    // Times every call on its own, for a latency distribution instead of an
+    // average. The clock's own cost is subtracted. Calls of a few ns are
+    // below the clock's resolution, so measure those with run() over a loop.
+    template <typename Body>
+    const BenchmarkResult& sampleLatency(const std::string& name, int samples, Body&& body) {
+        for (int i = 0; i < samples / 10; ++i) body();
+        const uint64_t overhead = BenchClock::overheadTicks();
+        std::vector<double> ns;
+        ns.reserve(samples);
+        for (int i = 0; i < samples; ++i) {
+            uint64_t start = BenchClock::now();
+            body();
+            uint64_t ticks = BenchClock::now() - start;
+            ns.push_back(BenchClock::toNs(ticks > overhead ? ticks - overhead : 0));
+        }
+        return record(name, 0, 1, std::move(ns));
+    }
+    
+    // 1, 2, 4, ... up to `max_threads`, which is always included
+    static std::vector<int> threadCounts(int max_threads = static_cast<int>(std::thread::hardware_concurrency())) {
+        std::vector<int> counts;
+        for (int n = 1; n < max_threads; n *= 2) counts.push_back(n);
+        counts.push_back(std::max(1, max_threads));
+        return counts;
+    }
+    
+    const std::vector<BenchmarkResult>& results() const { return results_; }
+    
+    // Bodies passed to run()/runThreads() execute this many times (warmup included)
+    int runs() const { return options_.warmup + options_.repeats; }
+    
+    static void printResult(const BenchmarkResult& r) {
+        const char* per = r.ops > 1 ? "/op" : "";
+        std::cout << r.name;
+        if (r.threads > 0) std::cout << " [" << r.threads << (r.threads == 1 ? " thread]" : " threads]");
+        std::cout << ": median " << formatNs(r.median) << per << " (min " << formatNs(r.min) << ", p90 "
+                  << formatNs(r.p90);
+        if (r.ns_per_op.size() >= 100) std::cout << ", p99 " << formatNs(r.p99);  // Noise below that
+        std::cout << ", max " << formatNs(r.max) << "; n=" << r.ns_per_op.size() << ")\n";
+    }
+    
+    void writeJson(std::ostream& out) const {
+        auto escape = [](const std::string& text) {
+            std::string escaped;
+            for (char c : text) {
+                if (c == '"' || c == '\\') escaped += '\\';
+                if (static_cast<unsigned char>(c) >= 0x20) escaped += c;
+            }
+            return escaped;
+        };
+        out << "{\"suite\": \"" << escape(name_) << "\", \"clock\": \"" << BenchClock::source()
+            << "\", \"ns_per_tick\": " << BenchClock::nsPerTick() << ", \"results\": [";
+        for (size_t i = 0; i < results_.size(); ++i) {
+            const BenchmarkResult& r = results_[i];
+            out << (i ? ",\n  " : "\n  ") << "{\"name\": \"" << escape(r.name) << "\", \"threads\": " << r.threads
+                << ", \"ops\": " << r.ops << ", \"samples\": " << r.ns_per_op.size() << ", \"min_ns\": " << r.min
+                << ", \"median_ns\": " << r.median << ", \"p90_ns\": " << r.p90 << ", \"p99_ns\": " << r.p99
+                << ", \"max_ns\": " << r.max << ", \"mean_ns\": " << r.mean << ", \"stddev_ns\": " << r.stddev
+                << "}";
+        }
+        out << "\n]}\n";
+    }
+    
+    void writeCsv(std::ostream& out) const {
+        out << "suite,name,threads,ops,samples,min_ns,median_ns,p90_ns,p99_ns,max_ns,mean_ns,stddev_ns\n";
+        for (const BenchmarkResult& r : results_) {
+            std::string quoted;
+            for (char c : r.name) quoted += (c == '"') ? std::string("\"\"") : std::string(1, c);
+            out << name_ << ",\"" << quoted << "\"," << r.threads << "," << r.ops << "," << r.ns_per_op.size()
+                << "," << r.min << "," << r.median << "," << r.p90 << "," << r.p99 << "," << r.max << ","
+                << r.mean << "," << r.stddev << "\n";
+        }
+    }
+};
+
+// ===== HARDWARE PERFORMANCE COUNTERS =====
+
+// Wall-clock time says whether a change helped; the counters say why.
+// PerfCounters opens one perf_event_open counter per event for the calling
+// thread and counts from construction on. Each event is opened on its own,
+// so a host without a PMU (most VMs and containers) still gets the software
+// events and reports the rest as n/a. When there are more events than
+// hardware counters the kernel time-slices them, so values are scaled by
+// time_enabled / time_running.
+enum PerfEvent : size_t {
+    kCycles,
+    kInstructions,
+    kL1DMisses,
+    kLLCMisses,
+    kBranchMisses,
+    kContextSwitches,
+    kPerfEventCount
+};
+
+struct PerfReading {
+    std::array<uint64_t, kPerfEventCount> values{};
+    std::array<bool, kPerfEventCount> valid{};
+    
+    PerfReading& operator+=(const PerfReading& other) {
+        for (size_t i = 0; i < kPerfEventCount; ++i) {
+            values[i] += other.values[i];
+            valid[i] = valid[i] || other.valid[i];
+        }
+        return *this;
+    }
+};
+
+class PerfCounters {
+private:
+    std::array<int, kPerfEventCount> fds_;
+    
+    // User-space only, which perf_event_paranoid=2 (the usual default)
+    // allows; count_kernel is for events that only happen in the kernel
+    static int open(uint32_t type, uint64_t config, bool count_kernel) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = count_kernel ? 0 : 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+        if (fd < 0 && count_kernel && (errno == EACCES || errno == EPERM)) return open(type, config, false);
+        return fd;
+    }
+    
+public:
+    PerfCounters() {
+        const uint64_t l1d_read_miss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        fds_[kCycles] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, false);
+        fds_[kInstructions] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, false);
+        fds_[kL1DMisses] = open(PERF_TYPE_HW_CACHE, l1d_read_miss, false);
+        fds_[kLLCMisses] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, false);
+        fds_[kBranchMisses] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, false);
+        // Switches happen inside the kernel, so exclude_kernel would hide all of them
+        fds_[kContextSwitches] = open(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, true);
+        for (int fd : fds_) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    
+    ~PerfCounters() {
+        for (int fd : fds_) {
+            if (fd >= 0) close(fd);
+        }
+    }
+    
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+    
+    // Counts since construction; the counters keep running
+    PerfReading read() const {
+        PerfReading reading;
+        for (size_t i = 0; i < kPerfEventCount; ++i) {
+            struct { uint64_t value, enabled, running; } data{};
+            if (fds_[i] < 0 || ::read(fds_[i], &data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+            if (data.running == 0) continue;  // Never scheduled onto a counter
+            reading.values[i] = data.running == data.enabled
+                ? data.value
+                : static_cast<uint64_t>(static_cast<double>(data.value) * data.enabled / data.running);
+            reading.valid[i] = true;
+        }
+        return reading;
+    }
+    
+    // Empty when cycles can be counted, otherwise why not
+    static const std::string& hardwareStatus() {
+        static const std::string status = [] {
+            int fd = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, false);
+            if (fd >= 0) {
+                close(fd);
+                return std::string();
+            }
+            return std::string("perf_event_open: ") + std::strerror(errno) +
+                   (errno == EACCES ? " (see /proc/sys/kernel/perf_event_paranoid)" : " (no PMU exposed here?)");
+        }();
+        return status;
+    }
+};
+
+// Collects the counts of every thread that runs a PerfScope against it
+class PerfTotals {
+private:
+    mutable std::mutex mutex_;
+    PerfReading total_;
+    std::vector<PerfReading> per_thread_;
     
 public:
-    Timer(const std::string& operation_name) : name(operation_name) {
-        start_time = std::chrono::high_resolution_clock::now();
+    void add(const PerfReading& reading) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        total_ += reading;
+        per_thread_.push_back(reading);
     }
     
-    ~Timer() {
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
-        std::cout << name << " took: " << duration.count() << " microseconds\n";
+    PerfReading total() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return total_;
     }
+    
+    std::vector<PerfReading> perThread() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return per_thread_;
+    }
+};
+
+// RAII region: counts the calling thread from construction to destruction.
+// Put one at the top of any thread body or benchmark region.
+class PerfScope {
+private:
+    PerfTotals& totals_;
+    PerfCounters counters_;
+    
+public:
+    explicit PerfScope(PerfTotals& totals) : totals_(totals) {}
+    ~PerfScope() { totals_.add(counters_.read()); }
+    
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
 };
 
+// One extra, untimed run of body(thread_index) on `threads` threads, each
+// inside a PerfScope; opening the counters would distort a timed run
+template <typename Body>
+PerfReading countThreads(int threads, Body&& body) {
+    PerfTotals totals;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&totals, &body, t] {
+            PerfScope scope(totals);
+            body(t);
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    return totals.total();
+}
+
+void printPerfHeader() {
+    static bool reported = false;  // Say why hardware events are n/a once, not per table
+    if (!PerfCounters::hardwareStatus().empty() && !reported) {
+        reported = true;
+        std::cout << "  [hardware counters unavailable: " << PerfCounters::hardwareStatus() << "]\n";
+    }
+    std::printf("  %-24s %9s %9s %6s %9s %9s %9s %8s\n", "per operation", "cycles", "instr", "IPC", "L1D miss",
+                "LLC miss", "br miss", "ctx sw");
+}
+
+void printPerfRow(const std::string& label, const PerfReading& r, double ops) {
+    auto per_op = [&](PerfEvent event) {
+        char text[16];
+        if (r.valid[event]) std::snprintf(text, sizeof(text), "%.3f", r.values[event] / ops);
+        else std::snprintf(text, sizeof(text), "n/a");
+        return std::string(text);
+    };
+    char ipc[16] = "n/a";
+    if (r.valid[kCycles] && r.valid[kInstructions] && r.values[kCycles] > 0) {
+        std::snprintf(ipc, sizeof(ipc), "%.2f", static_cast<double>(r.values[kInstructions]) / r.values[kCycles]);
+    }
+    std::string switches = r.valid[kContextSwitches] ? std::to_string(r.values[kContextSwitches]) : "n/a";
+    std::printf("  %-24s %9s %9s %6s %9s %9s %9s %8s\n", label.c_str(), per_op(kCycles).c_str(),
+                per_op(kInstructions).c_str(), ipc, per_op(kL1DMisses).c_str(), per_op(kLLCMisses).c_str(),
+                per_op(kBranchMisses).c_str(), switches.c_str());
+}
+
 // ===== CACHE LINE EFFECTS AND FALSE SHARING =====
 
 struct PaddedCounter {
@@ -45,45 +536,33 @@ void demonstrateFalseSharing() {
     const int num_threads = 4;
     const int iterations = 1000000;
     
+    BenchmarkSuite suite("false_sharing");
+    
     // Test with false sharing (adjacent counters)
     std::vector<UnpaddedCounter> unpadded_counters(num_threads);
-    
-    {
-        Timer timer("Unpadded counters (false sharing)");
-        std::vector<std::thread> threads;
-        
-        for (int i = 0; i < num_threads; ++i) {
-            threads.emplace_back([&unpadded_counters, i, iterations]() {
-                for (int j = 0; j < iterations; ++j) {
-                    unpadded_counters[i].counter.fetch_add(1, std::memory_order_relaxed);
-                }
-            });
+    auto unpadded = [&](int i) {
+        for (int j = 0; j < iterations; ++j) {
+            unpadded_counters[i].counter.fetch_add(1, std::memory_order_relaxed);
         }
-        
-        for (auto& t : threads) {
-            t.join();
-        }
-    }
+    };
+    suite.runThreads("Unpadded counters (false sharing)", num_threads, iterations, unpadded);
     
     // Test without false sharing (padded counters)
     std::vector<PaddedCounter> padded_counters(num_threads);
-    
-    {
-        Timer timer("Padded counters (no false sharing)");
-        std::vector<std::thread> threads;
-        
-        for (int i = 0; i < num_threads; ++i) {
-            threads.emplace_back([&padded_counters, i, iterations]() {
-                for (int j = 0; j < iterations; ++j) {
-                    padded_counters[i].counter.fetch_add(1, std::memory_order_relaxed);
-                }
-            });
-        }
-        
-        for (auto& t : threads) {
-            t.join();
+    auto padded = [&](int i) {
+        for (int j = 0; j < iterations; ++j) {
+            padded_counters[i].counter.fetch_add(1, std::memory_order_relaxed);
         }
-    }
+    };
+    suite.runThreads("Padded counters (no false sharing)", num_threads, iterations, padded);
+    
+    // The timing difference should come with fewer cache misses per increment
+    const double increments = static_cast<double>(num_threads) * iterations;
+    std::cout << "\nCounters, one extra run each (context switches are totals):\n";
+    printPerfHeader();
+    printPerfRow("Unpadded counters", countThreads(num_threads, unpadded), increments);
+    printPerfRow("Padded counters", countThreads(num_threads, padded), increments);
+    std::cout << "\n";
     
     std::cout << "Padded version should be significantly faster due to avoided false sharing\n\n";
 }
@@ -99,71 +578,100 @@ void demonstrateMemoryAccessPatterns() {
     std::vector<int> data(array_size);
     std::iota(data.begin(), data.end(), 1);  // Fill with 1, 2, 3, ...
     
+    BenchmarkSuite suite("memory_access");
+    
     // Sequential access pattern
-    {
-        Timer timer("Sequential memory access");
-        std::vector<std::thread> threads;
-        
-        size_t chunk_size = array_size / num_threads;
-        
-        for (size_t i = 0; i < num_threads; ++i) {
-            threads.emplace_back([&data, i, chunk_size]() {
-                size_t start = i * chunk_size;
-                size_t end = (i == 3) ? data.size() : (i + 1) * chunk_size;
-                
-                long long sum = 0;
-                for (size_t j = start; j < end; ++j) {
-                    sum += data[j];
-                }
-                
-                // Prevent optimization
-                volatile long long result = sum;
-                (void)result;
-            });
-        }
+    const size_t chunk_size = array_size / num_threads;
+    auto sequential = [&](int i) {
+        size_t start = i * chunk_size;
+        size_t end = (static_cast<size_t>(i) == num_threads - 1) ? data.size() : (i + 1) * chunk_size;
         
-        for (auto& t : threads) {
-            t.join();
+        long long sum = 0;
+        for (size_t j = start; j < end; ++j) {
+            sum += data[j];
         }
-    }
+        doNotOptimize(sum);  // Prevent optimization
+    };
+    suite.runThreads("Sequential memory access", num_threads, chunk_size, sequential);
     
     // Random access pattern (cache-unfriendly)
-    {
-        Timer timer("Random memory access");
-        std::vector<std::thread> threads;
+    const int random_reads = 100000;
+    auto random = [&](int i) {
+        std::mt19937 gen(12345 + i);  // Different seed per thread, same sequence every run
+        std::uniform_int_distribution<size_t> dist(0, array_size - 1);
         
-        for (size_t i = 0; i < num_threads; ++i) {
-            threads.emplace_back([&data, i, array_size]() {
-                std::random_device rd;
-                std::mt19937 gen(rd() + i);  // Different seed per thread
-                std::uniform_int_distribution<size_t> dist(0, array_size - 1);
-                
-                long long sum = 0;
-                for (int j = 0; j < 100000; ++j) {
-                    size_t index = dist(gen);
-                    sum += data[index];
-                }
-                
-                // Prevent optimization
-                volatile long long result = sum;
-                (void)result;
-            });
-        }
-        
-        for (auto& t : threads) {
-            t.join();
+        long long sum = 0;
+        for (int j = 0; j < random_reads; ++j) {
+            size_t index = dist(gen);
+            sum += data[index];
         }
-    }
+        doNotOptimize(sum);  // Prevent optimization
+    };
+    suite.runThreads("Random memory access", num_threads, random_reads, random);
+    
+    std::cout << "\nCounters, one extra run each (context switches are totals):\n";
+    printPerfHeader();
+    printPerfRow("Sequential, per element", countThreads(num_threads, sequential),
+                 static_cast<double>(chunk_size) * num_threads);
+    printPerfRow("Random, per element", countThreads(num_threads, random),
+                 static_cast<double>(random_reads) * num_threads);
     
-    std::cout << "Sequential access should be much faster due to cache locality\n\n";
+    std::cout << "\nSequential access should be much faster per element due to cache locality\n\n";
 }
 
+// ===== SPINLOCKS UNDER TEST =====
+
+// The full family (TTAS with backoff, ticket, MCS, CLH behind one Lockable
+// interface) is in IPC/Synchronization Mechanisms/3. atomic.cpp. Measuring
+// needs only its two ends: a test-and-set lock, where whoever sees the
+// release first wins, and a FIFO ticket lock, which must hand over to the
+// next waiter in line even if that thread is not running. Both are plain
+// BasicLockable types so std::lock_guard and ContentionDemo take them.
+
+// PAUSE on x86 keeps a spin loop from flooding the memory system; after
+// 1024 rounds the holder has probably been preempted, so yield to it
+inline void spinPause(int spins) {
+    if (spins % 1024 == 1023) {
+        std::this_thread::yield();
+    } else {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+}
+
+class TASLock {
+private:
+    std::atomic<bool> locked_{false};
+
+public:
+    void lock() {
+        for (int spins = 0; locked_.exchange(true, std::memory_order_acquire); ++spins) spinPause(spins);
+    }
+    void unlock() { locked_.store(false, std::memory_order_release); }
+};
+
+class TicketLock {
+private:
+    alignas(64) std::atomic<uint32_t> next_{0};
+    alignas(64) std::atomic<uint32_t> serving_{0};
+
+public:
+    void lock() {
+        uint32_t ticket = next_.fetch_add(1, std::memory_order_relaxed);
+        for (int spins = 0; serving_.load(std::memory_order_acquire) != ticket; ++spins) spinPause(spins);
+    }
+    void unlock() { serving_.store(serving_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+};
+
 // ===== LOCK CONTENTION ANALYSIS =====
 
+// Lock is std::mutex or one of the spinlocks above
+template <typename Lock = std::mutex>
 class ContentionDemo {
 private:
-    std::mutex hot_mutex;
-    std::vector<std::mutex> distributed_mutexes;
+    Lock hot_mutex;
+    std::vector<Lock> distributed_mutexes;
     std::atomic<long long> shared_counter{0};
     std::vector<std::atomic<long long>> distributed_counters;
     
@@ -174,7 +682,7 @@ public:
     
     void hotMutexTest(int iterations) {
         for (int i = 0; i < iterations; ++i) {
-            std::lock_guard<std::mutex> lock(hot_mutex);
+            std::lock_guard<Lock> lock(hot_mutex);
             shared_counter.fetch_add(1, std::memory_order_relaxed);
         }
     }
@@ -183,7 +691,7 @@ public:
         size_t mutex_index = thread_id % distributed_mutexes.size();
         
         for (int i = 0; i < iterations; ++i) {
-            std::lock_guard<std::mutex> lock(distributed_mutexes[mutex_index]);
+            std::lock_guard<Lock> lock(distributed_mutexes[mutex_index]);
             distributed_counters[mutex_index].fetch_add(1, std::memory_order_relaxed);
         }
     }
@@ -197,92 +705,195 @@ public:
     }
 };
 
+template <typename Lock>
+void runContention(BenchmarkSuite& suite, const std::string& lock_name, int num_threads, int iterations) {
+    ContentionDemo<Lock> demo(num_threads);
+    
+    // High contention scenario
+    suite.runThreads("High contention (single " + lock_name + ")", num_threads, iterations,
+                     [&](int) { demo.hotMutexTest(iterations); });
+    
+    // Distributed contention scenario
+    suite.runThreads("Distributed contention (multiple " + lock_name + ")", num_threads, iterations,
+                     [&](int i) { demo.distributedMutexTest(i, iterations); });
+    
+    std::cout << "Total distributed count: " << demo.getTotalDistributedCount() << " (expected "
+              << static_cast<long long>(suite.runs()) * num_threads * iterations << ")\n";
+}
+
+// Where the contention cost goes: cache misses on the lock line, and for a
+// sleeping lock, context switches
+void countContention(int num_threads, int iterations) {
+    ContentionDemo<std::mutex> demo(num_threads);
+    const double ops = static_cast<double>(num_threads) * iterations;
+    std::cout << "Counters for the mutex runs (context switches are totals):\n";
+    printPerfHeader();
+    printPerfRow("Single mutex", countThreads(num_threads, [&](int) { demo.hotMutexTest(iterations); }), ops);
+    printPerfRow("Distributed mutexes",
+                 countThreads(num_threads, [&](int i) { demo.distributedMutexTest(i, iterations); }), ops);
+    std::cout << "\n";
+}
+
 void demonstrateLockContention() {
     std::cout << "=== LOCK CONTENTION ANALYSIS ===\n\n";
     
     const int num_threads = 8;
     const int iterations = 100000;
     
-    ContentionDemo demo(num_threads);
+    BenchmarkSuite suite("lock_contention");
+    runContention<std::mutex>(suite, "mutex", num_threads, iterations);
+    countContention(num_threads, iterations);
     
-    // High contention scenario
-    {
-        Timer timer("High contention (single mutex)");
-        std::vector<std::thread> threads;
-        
-        for (int i = 0; i < num_threads; ++i) {
-            threads.emplace_back([&demo, iterations]() {
-                demo.hotMutexTest(iterations);
-            });
-        }
-        
-        for (auto& t : threads) {
-            t.join();
-        }
-    }
+    // Spinlocks only make sense with a core per spinning thread
+    const int spin_threads = static_cast<int>(std::clamp(std::thread::hardware_concurrency(), 2u, 8u));
+    const int spin_iterations = 20000;
+    std::cout << "Spinlocks with " << spin_threads << " threads x " << spin_iterations << " iterations:\n";
+    runContention<TASLock>(suite, "TAS spinlock", spin_threads, spin_iterations);
+    runContention<TicketLock>(suite, "ticket lock", spin_threads, spin_iterations);
     
-    // Distributed contention scenario
-    {
-        Timer timer("Distributed contention (multiple mutexes)");
-        std::vector<std::thread> threads;
-        
-        for (int i = 0; i < num_threads; ++i) {
-            threads.emplace_back([&demo, i, iterations]() {
-                demo.distributedMutexTest(i, iterations);
-            });
-        }
-        
-        for (auto& t : threads) {
-            t.join();
-        }
-    }
-    
-    std::cout << "Distributed version should be faster due to reduced contention\n";
-    std::cout << "Total distributed count: " << demo.getTotalDistributedCount() << "\n\n";
+    std::cout << "Distributed version should be faster due to reduced contention\n\n";
 }
 
 // ===== THREAD AFFINITY AND NUMA EFFECTS =====
 
+// Just enough topology for the placement comparison below: which package
+// and core each allowed CPU belongs to, read from sysfs. The full version
+// (NUMA nodes, placement policies, package-aware stealing) is CpuTopology
+// in 06_thread_pool.cpp.
+struct CpuSlot {
+    int cpu;
+    int core;     // core_id, unique within its package only
+    int package;
+};
+
+inline int readSysfsInt(const std::string& path, int fallback) {
+    std::ifstream in(path);
+    int value = 0;
+    return (in >> value) ? value : fallback;
+}
+
+// Allowed CPUs in compact order: package, then core, then SMT sibling.
+// Without sysfs every CPU counts as its own core on package 0.
+inline std::vector<CpuSlot> allowedCpus() {
+    std::vector<CpuSlot> cpus;
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (!CPU_ISSET(cpu, &allowed)) continue;
+        std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+        cpus.push_back(CpuSlot{cpu, readSysfsInt(base + "core_id", cpu),
+                               readSysfsInt(base + "physical_package_id", 0)});
+    }
+    std::sort(cpus.begin(), cpus.end(), [](const CpuSlot& a, const CpuSlot& b) {
+        if (a.package != b.package) return a.package < b.package;
+        if (a.core != b.core) return a.core < b.core;
+        return a.cpu < b.cpu;
+    });
+    return cpus;
+}
+
+// Compact fills SMT siblings and neighbouring cores first; scatter takes
+// the first CPU of every core, alternating packages, before any sibling.
+// -1 means "not pinned"; more threads than CPUs wrap around.
+inline std::vector<int> placeThreads(const std::vector<CpuSlot>& cpus, bool scatter, size_t threads) {
+    std::vector<int> assignment(threads, -1);
+    if (cpus.empty()) return assignment;
+    std::vector<std::pair<std::array<int, 3>, int>> order;  // (sort key, cpu)
+    int core_rank = -1;
+    int smt_rank = 0;
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        bool new_package = i == 0 || cpus[i].package != cpus[i - 1].package;
+        bool new_core = new_package || cpus[i].core != cpus[i - 1].core;
+        core_rank = new_package ? 0 : core_rank + (new_core ? 1 : 0);
+        smt_rank = new_core ? 0 : smt_rank + 1;
+        std::array<int, 3> key = scatter ? std::array<int, 3>{smt_rank, core_rank, cpus[i].package}
+                                         : std::array<int, 3>{0, 0, static_cast<int>(i)};
+        order.emplace_back(key, cpus[i].cpu);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (size_t i = 0; i < threads; ++i) assignment[i] = order[i % order.size()].second;
+    return assignment;
+}
+
+// Memory a pinned thread touches first lands on its CPU's NUMA node
+// (Linux first-touch), so data it fills itself is node-local
+inline bool pinCurrentThread(int cpu) {
+    if (cpu < 0) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
 void demonstrateThreadAffinity() {
-    std::cout << "=== THREAD AFFINITY CONSIDERATIONS ===\n\n";
+    std::cout << "=== THREAD AFFINITY AND NUMA PLACEMENT ===\n\n";
     
-    std::cout << "Hardware concurrency: " << std::thread::hardware_concurrency() << " threads\n";
+    const std::vector<CpuSlot> topology = allowedCpus();
+    std::cout << "Hardware concurrency: " << std::thread::hardware_concurrency() << " threads, "
+              << topology.size() << " usable CPU(s)\n";
+    for (size_t i = 0; i < topology.size() && i < 16; ++i) {
+        std::printf("  cpu%-3d core %-3d package %d\n", topology[i].cpu, topology[i].core, topology[i].package);
+    }
+    if (topology.size() > 16) std::cout << "  ...\n";
+    std::cout << "\n";
     
-    // Simulate work that benefits from thread affinity
     const int num_threads = std::min(4u, std::thread::hardware_concurrency());
     const int work_size = 1000000;
     
-    std::vector<std::vector<int>> thread_local_data(num_threads);
-    for (int i = 0; i < num_threads; ++i) {
-        thread_local_data[i].resize(work_size);
-        std::iota(thread_local_data[i].begin(), thread_local_data[i].end(), i * work_size);
+    // Page placement follows the first write: data filled by the main thread
+    // sits on the main thread's node, data filled by a pinned worker on its own
+    auto fill = [&](const std::vector<int>& cpus, bool on_workers) {
+        std::vector<std::vector<int>> data(num_threads);
+        auto fill_one = [&](int i) {
+            if (on_workers) pinCurrentThread(cpus[i]);
+            data[i].resize(work_size);
+            std::iota(data[i].begin(), data[i].end(), i * work_size);
+        };
+        if (!on_workers) {
+            for (int i = 0; i < num_threads; ++i) fill_one(i);
+            return data;
+        }
+        std::vector<std::thread> fillers;
+        for (int i = 0; i < num_threads; ++i) fillers.emplace_back(fill_one, i);
+        for (auto& filler : fillers) filler.join();
+        return data;
+    };
+    
+    std::vector<long long> results(num_threads);
+    BenchmarkSuite suite("thread_affinity");
+    auto measure = [&](const std::string& label, const std::vector<int>& cpus, bool node_local) {
+        std::vector<std::vector<int>> data = fill(cpus, node_local);
+        suite.runThreads(label, num_threads, work_size, [&](int i) {
+            pinCurrentThread(cpus[i]);  // No-op for -1 (unpinned)
+            long long sum = 0;
+            for (size_t j = 0; j < data[i].size(); ++j) {
+                sum += static_cast<long long>(data[i][j]) * data[i][j];
+            }
+            results[i] = sum;
+        });
+    };
+    
+    measure("Unpinned, data filled by main thread", std::vector<int>(num_threads, -1), false);
+    for (bool scatter : {false, true}) {
+        const char* name = scatter ? "scatter" : "compact";
+        std::vector<int> cpus = placeThreads(topology, scatter, num_threads);
+        std::cout << name << " places threads on CPUs";
+        for (int cpu : cpus) std::cout << " " << cpu;
+        std::cout << "\n";
+        measure(std::string("Pinned ") + name + ", node-local data", cpus, true);
     }
+    // Scatter spans packages, so with several NUMA nodes most threads read remote memory here
+    measure("Pinned scatter, data filled by main thread", placeThreads(topology, true, num_threads), false);
     
-    {
-        Timer timer("Thread-local data processing");
-        std::vector<std::thread> threads;
-        
-        for (int i = 0; i < num_threads; ++i) {
-            threads.emplace_back([&thread_local_data, i]() {
-                long long sum = 0;
-                for (size_t j = 0; j < thread_local_data[i].size(); ++j) {
-                    sum += thread_local_data[i][j] * thread_local_data[i][j];
-                }
-                
-                // Prevent optimization
-                volatile long long result = sum;
-                std::cout << "Thread " << i << " processed " << thread_local_data[i].size() 
-                         << " elements (result: " << result << ")\n";
-            });
-        }
-        
-        for (auto& t : threads) {
-            t.join();
-        }
+    for (int i = 0; i < num_threads; ++i) {
+        std::cout << "Thread " << i << " processed " << work_size 
+                  << " elements (result: " << results[i] << ")\n";
     }
     
-    std::cout << "\nNote: Thread affinity can be set using platform-specific APIs\n";
-    std::cout << "Linux: pthread_setaffinity_np(), Windows: SetThreadAffinityMask()\n\n";
+    std::cout << "\nOn one socket the variants differ mainly by migrations. On several,\n";
+    std::cout << "remote reads show up in the last row; see also the pools in 06_thread_pool.cpp\n\n";
 }
 
 // ===== SCALABILITY ANALYSIS =====
@@ -316,66 +927,251 @@ public:
     }
 };
 
+// One table row: `Lock` at each thread count, same critical section (one
+// increment). Only the median is printed; the suite keeps the rest.
+template <typename Lock>
+void lockScalabilityRow(BenchmarkSuite& suite, const char* name, const std::vector<int>& thread_counts,
+                        int cores) {
+    Lock lock;
+    std::printf("  %-16s", name);
+    for (int n : thread_counts) {
+        long counter = 0;
+        const int per_thread = (n > cores ? 20000 : 400000) / n;
+        const BenchmarkResult& result = suite.runThreads(name, n, per_thread, [&](int) {
+            for (int i = 0; i < per_thread; ++i) {
+                lock.lock();
+                ++counter;
+                lock.unlock();
+            }
+        });
+        bool correct = counter == static_cast<long>(suite.runs()) * per_thread * n;
+        std::printf(correct ? "%9.1f" : "%8.1f!", result.median);
+        std::fflush(stdout);
+    }
+    std::printf("\n");
+}
+
+// 1..N threads, then past the core count, because that is where FIFO
+// locks collapse: they hand the lock to a waiter that may not be running,
+// and everyone behind it waits for it to be scheduled. 3. atomic.cpp
+// compares the whole family for correctness and fairness.
+void analyzeLockScalability() {
+    std::cout << "Lock scalability (ns per acquisition, total across threads):\n";
+    
+    // Powers of two up to the core count, then one oversubscribed column
+    // (marked *). FIFO locks can get far slower there, so it runs fewer operations.
+    const int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<int> thread_counts;
+    for (int n = 1; n <= std::min(cores, 16); n *= 2) thread_counts.push_back(n);
+    thread_counts.push_back(2 * thread_counts.back());
+    
+    BenchmarkOptions options;
+    options.print = false;
+    BenchmarkSuite suite("lock_scalability", options);
+    
+    std::printf("  %-16s", "threads");
+    for (int n : thread_counts) std::printf("%8d%c", n, n > cores ? '*' : ' ');
+    std::printf("\n");
+    lockScalabilityRow<std::mutex>(suite, "std::mutex", thread_counts, cores);
+    lockScalabilityRow<TASLock>(suite, "TAS spinlock", thread_counts, cores);
+    lockScalabilityRow<TicketLock>(suite, "Ticket lock", thread_counts, cores);
+    std::cout << "* more threads than cores: a preempted waiter stalls every FIFO\n"
+              << "  hand-off behind it, while TAS lets whoever is running take the lock\n\n";
+}
+
 void analyzeScalability() {
     std::cout << "=== SCALABILITY ANALYSIS ===\n\n";
     
     const int iterations_per_thread = 50000;
     const int max_threads = std::min(8u, std::thread::hardware_concurrency());
+    const std::vector<int> thread_counts = BenchmarkSuite::threadCounts(max_threads);
     
     ScalabilityTester tester;
+    BenchmarkSuite suite("scalability");
     
     std::cout << "Testing scalability with increasing thread count:\n\n";
     
     // Test atomic operations scalability
     std::cout << "Atomic operations:\n";
-    for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
-        tester.reset();
-        
-        auto start = std::chrono::high_resolution_clock::now();
-        
-        std::vector<std::thread> threads;
-        for (int i = 0; i < num_threads; ++i) {
-            threads.emplace_back([&tester, iterations_per_thread]() {
-                tester.atomicIncrement(iterations_per_thread);
-            });
+    suite.sweepThreads("Atomic increment", thread_counts, iterations_per_thread,
+                       [&](int) { tester.atomicIncrement(iterations_per_thread); });
+    
+    std::cout << "\nMutex operations:\n";
+    suite.sweepThreads("Mutex increment", thread_counts, iterations_per_thread,
+                       [&](int) { tester.mutexIncrement(iterations_per_thread); });
+    
+    std::cout << "\nNote: Atomic operations should scale better than mutex-based operations\n\n";
+    
+    analyzeLockScalability();
+}
+
+// ===== READ-MOSTLY SCALING =====
+
+// Same designs as BigReaderLock and SeqLock in 02_mutex_synchronization.cpp,
+// kept minimal here so this file stays self-contained
+class PerCpuReaderLock {
+private:
+    struct alignas(64) Slot {
+        std::atomic<int> readers{0};
+    };
+    std::vector<Slot> slots_;
+    alignas(64) std::atomic<bool> writer_{false};
+    std::mutex writer_mutex_;
+    
+public:
+    PerCpuReaderLock() : slots_(std::max(1u, std::thread::hardware_concurrency())) {}
+    
+    size_t lock_shared() {
+        int cpu = sched_getcpu();
+        size_t slot = static_cast<size_t>(cpu < 0 ? 0 : cpu) % slots_.size();
+        for (;;) {
+            slots_[slot].readers.fetch_add(1, std::memory_order_seq_cst);
+            if (!writer_.load(std::memory_order_seq_cst)) return slot;
+            slots_[slot].readers.fetch_sub(1, std::memory_order_release);
+            while (writer_.load(std::memory_order_relaxed)) std::this_thread::yield();
         }
-        
-        for (auto& t : threads) {
-            t.join();
+    }
+    
+    void unlock_shared(size_t slot) { slots_[slot].readers.fetch_sub(1, std::memory_order_release); }
+    
+    void lock() {
+        writer_mutex_.lock();
+        writer_.store(true, std::memory_order_seq_cst);
+        // seq_cst, not acquire: an acquire load may be reordered before the
+        // store above, and then a reader that is just entering goes unseen.
+        // Pairs with the reader's seq_cst increment-then-check.
+        for (auto& slot : slots_) {
+            while (slot.readers.load(std::memory_order_seq_cst) != 0) std::this_thread::yield();
         }
-        
-        auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-        
-        std::cout << "  " << num_threads << " threads: " << duration.count() 
-                  << " ms (count: " << tester.getCount() << ")\n";
     }
     
-    std::cout << "\nMutex operations:\n";
-    for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
-        tester.reset();
-        
-        auto start = std::chrono::high_resolution_clock::now();
-        
-        std::vector<std::thread> threads;
-        for (int i = 0; i < num_threads; ++i) {
-            threads.emplace_back([&tester, iterations_per_thread]() {
-                tester.mutexIncrement(iterations_per_thread);
-            });
+    void unlock() {
+        writer_.store(false, std::memory_order_release);
+        writer_mutex_.unlock();
+    }
+};
+
+struct PricePair {
+    uint64_t bid;
+    uint64_t ask;  // Always bid + 1
+};
+
+class PriceSeqLock {
+private:
+    alignas(64) std::atomic<uint64_t> sequence_{0};
+    std::atomic<uint64_t> bid_{0};
+    std::atomic<uint64_t> ask_{1};
+    
+public:
+    void store(PricePair value) {  // Single writer
+        uint64_t seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bid_.store(value.bid, std::memory_order_relaxed);
+        ask_.store(value.ask, std::memory_order_relaxed);
+        sequence_.store(seq + 2, std::memory_order_release);
+    }
+    
+    PricePair load() const {
+        for (;;) {
+            uint64_t before = sequence_.load(std::memory_order_acquire);
+            if (before & 1) continue;
+            PricePair value{bid_.load(std::memory_order_relaxed), ask_.load(std::memory_order_relaxed)};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == before) return value;
         }
-        
-        for (auto& t : threads) {
-            t.join();
+    }
+};
+
+// `readers` threads read a bid/ask pair as fast as they can while one writer
+// updates it every ~50 µs. Returns millions of reads per second; a torn pair
+// (ask != bid + 1) is counted as an error.
+template <typename Read, typename Write>
+double measureReadMostly(int readers, std::chrono::milliseconds duration, Read read, Write write,
+                         long long& torn) {
+    std::atomic<bool> stop{false};
+    std::atomic<long long> total_reads{0};
+    std::atomic<long long> torn_reads{0};
+    std::vector<std::thread> threads;
+    
+    for (int i = 0; i < readers; ++i) {
+        threads.emplace_back([&]() {
+            long long count = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                PricePair pair = read();
+                if (pair.ask != pair.bid + 1) torn_reads.fetch_add(1, std::memory_order_relaxed);
+                ++count;
+            }
+            total_reads.fetch_add(count);
+        });
+    }
+    threads.emplace_back([&]() {
+        for (uint64_t version = 1; !stop.load(std::memory_order_relaxed); ++version) {
+            write(PricePair{version, version + 1});
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
         }
+    });
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    std::this_thread::sleep_for(duration);
+    stop = true;
+    for (auto& t : threads) t.join();
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    
+    torn += torn_reads.load();
+    return total_reads.load() / seconds / 1e6;
+}
+
+void analyzeReadMostlyScaling() {
+    std::cout << "=== READ-MOSTLY SCALING (M reads/s, 1 writer) ===\n\n";
+    
+    const auto duration = std::chrono::milliseconds(100);
+    const int reader_counts[] = {1, 2, 4, 8, 16, 32};
+    
+    std::cout << "Readers  shared_mutex  per-CPU brlock   seqlock\n";
+    long long torn = 0;
+    for (int readers : reader_counts) {
+        PricePair shared_pair{0, 1};
+        std::shared_mutex shared_mutex;
+        double shared_rate = measureReadMostly(
+            readers, duration,
+            [&]() {
+                std::shared_lock<std::shared_mutex> lock(shared_mutex);
+                return shared_pair;
+            },
+            [&](PricePair value) {
+                std::unique_lock<std::shared_mutex> lock(shared_mutex);
+                shared_pair = value;
+            },
+            torn);
+        
+        PricePair br_pair{0, 1};
+        PerCpuReaderLock br_lock;
+        double br_rate = measureReadMostly(
+            readers, duration,
+            [&]() {
+                size_t slot = br_lock.lock_shared();
+                PricePair value = br_pair;
+                br_lock.unlock_shared(slot);
+                return value;
+            },
+            [&](PricePair value) {
+                br_lock.lock();
+                br_pair = value;
+                br_lock.unlock();
+            },
+            torn);
         
-        auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+        PriceSeqLock seq_lock;
+        double seq_rate = measureReadMostly(
+            readers, duration, [&]() { return seq_lock.load(); },
+            [&](PricePair value) { seq_lock.store(value); }, torn);
         
-        std::cout << "  " << num_threads << " threads: " << duration.count() 
-                  << " ms (count: " << tester.getCount() << ")\n";
+        std::printf("%7d %13.1f %15.1f %9.1f\n", readers, shared_rate, br_rate, seq_rate);
     }
-    
-    std::cout << "\nNote: Atomic operations should scale better than mutex-based operations\n\n";
+    std::cout << "Torn reads: " << torn << " (expected 0)\n";
+    std::cout << "shared_mutex readers all write one counter; brlock readers write only their\n"
+              << "CPU's slot, and seqlock readers write nothing, so they keep scaling\n\n";
 }
 
 // ===== MEMORY ORDERING PERFORMANCE =====
@@ -391,39 +1187,25 @@ void benchmarkMemoryOrdering() {
         "relaxed", "acquire_release", "seq_cst"
     };
     
+    BenchmarkSuite suite("memory_ordering");
     for (const auto& ordering : orderings) {
         std::atomic<int> counter{0};
         
-        auto start = std::chrono::high_resolution_clock::now();
-        
-        std::vector<std::thread> threads;
-        for (int i = 0; i < num_threads; ++i) {
-            threads.emplace_back([&counter, iterations, &ordering]() {
-                if (ordering == "relaxed") {
-                    for (int j = 0; j < iterations; ++j) {
-                        counter.fetch_add(1, std::memory_order_relaxed);
-                    }
-                } else if (ordering == "acquire_release") {
-                    for (int j = 0; j < iterations; ++j) {
-                        counter.fetch_add(1, std::memory_order_acq_rel);
-                    }
-                } else {  // seq_cst
-                    for (int j = 0; j < iterations; ++j) {
-                        counter.fetch_add(1, std::memory_order_seq_cst);
-                    }
+        suite.runThreads(ordering + " ordering", num_threads, iterations, [&](int) {
+            if (ordering == "relaxed") {
+                for (int j = 0; j < iterations; ++j) {
+                    counter.fetch_add(1, std::memory_order_relaxed);
                 }
-            });
-        }
-        
-        for (auto& t : threads) {
-            t.join();
-        }
-        
-        auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        
-        std::cout << ordering << " ordering: " << duration.count() 
-                  << " microseconds (result: " << counter.load() << ")\n";
+            } else if (ordering == "acquire_release") {
+                for (int j = 0; j < iterations; ++j) {
+                    counter.fetch_add(1, std::memory_order_acq_rel);
+                }
+            } else {  // seq_cst
+                for (int j = 0; j < iterations; ++j) {
+                    counter.fetch_add(1, std::memory_order_seq_cst);
+                }
+            }
+        });
     }
     
     std::cout << "\nRelaxed ordering should be fastest, seq_cst slowest\n\n";
@@ -440,36 +1222,35 @@ void demonstrateWorkDistribution() {
     std::vector<int> data(total_work);
     std::iota(data.begin(), data.end(), 1);
     
+    // Both bodies start their own threads, so thread creation is in both timings
+    BenchmarkSuite suite("work_distribution");
+    
     // Static work distribution
-    {
-        Timer timer("Static work distribution");
+    suite.run("Static work distribution", total_work, [&]() {
         std::vector<std::thread> threads;
         
         size_t chunk_size = total_work / num_threads;
         
         for (int i = 0; i < num_threads; ++i) {
-            threads.emplace_back([&data, i, chunk_size, total_work]() {
+            threads.emplace_back([&data, i, chunk_size, total_work, num_threads]() {
                 size_t start = i * chunk_size;
-                size_t end = (i == 3) ? total_work : (i + 1) * chunk_size;
+                size_t end = (i == num_threads - 1) ? total_work : (i + 1) * chunk_size;
                 
                 long long sum = 0;
                 for (size_t j = start; j < end; ++j) {
                     sum += data[j] % 17;  // Some work
                 }
-                
-                volatile long long result = sum;
-                (void)result;
+                doNotOptimize(sum);
             });
         }
         
         for (auto& t : threads) {
             t.join();
         }
-    }
+    });
     
     // Dynamic work distribution with atomic counter
-    {
-        Timer timer("Dynamic work distribution");
+    suite.run("Dynamic work distribution", total_work, [&]() {
         std::atomic<size_t> work_index{0};
         const size_t batch_size = 1000;
         
@@ -489,20 +1270,61 @@ void demonstrateWorkDistribution() {
                         sum += data[j] % 17;  // Same work as static version
                     }
                 }
-                
-                volatile long long result = sum;
-                (void)result;
+                doNotOptimize(sum);
             });
         }
         
         for (auto& t : threads) {
             t.join();
         }
-    }
+    });
     
     std::cout << "Dynamic distribution provides better load balancing\n\n";
 }
 
+// ===== BENCHMARK HARNESS IN PRACTICE =====
+
+void demonstrateBenchmarkHarness() {
+    std::cout << "=== BENCHMARK HARNESS ===\n\n";
+    
+    std::cout << "Clock: " << BenchClock::source() << ", " << BenchClock::nsPerTick() << " ns/tick, "
+              << BenchClock::toNs(BenchClock::overheadTicks()) << " ns per read\n\n";
+    
+    BenchmarkSuite suite("harness");
+    const int n = 1000000;
+    
+    // Without a barrier the optimizer may fold the loop into a closed form
+    // (or delete it), and the "benchmark" measures nothing
+    suite.run("Sum loop, result unused", n, [&]() {
+        long long sum = 0;
+        for (int i = 0; i < n; ++i) sum += i;
+        (void)sum;
+    });
+    suite.run("Sum loop, doNotOptimize(i) each step", n, [&]() {
+        long long sum = 0;
+        for (int i = 0; i < n; ++i) {
+            doNotOptimize(i);
+            sum += i;
+        }
+        doNotOptimize(sum);
+    });
+    
+    // Per-call samples show the tail that an average hides
+    std::mutex mutex;
+    suite.sampleLatency("Uncontended mutex lock/unlock", 100000, [&]() {
+        mutex.lock();
+        mutex.unlock();
+    });
+    suite.sampleLatency("new/delete 64 bytes", 100000, [&]() {
+        char* p = new char[64];
+        doNotOptimize(p);
+        delete[] p;
+    });
+    
+    std::cout << "\nSet BENCH_OUTPUT_DIR=<dir> (and BENCH_FORMAT=csv) to write every suite\n"
+              << "in this file as <dir>/<suite>.json for regression tracking\n\n";
+}
+
 // ===== PROFILING UTILITIES =====
 
 void demonstrateProfilingTechniques() {
@@ -556,7 +1378,7 @@ void demonstrateProfilingTechniques() {
     std::cout << "- Linux perf for system-level profiling\n";
     std::cout << "- ThreadSanitizer for race condition detection\n";
     std::cout << "- Helgrind (Valgrind) for thread error detection\n";
-    std::cout << "- Custom timing with std::chrono for micro-benchmarks\n\n";
+    std::cout << "- BenchmarkSuite (above) for repeatable micro-benchmarks\n\n";
 }
 
 int main() {
@@ -569,8 +1391,10 @@ int main() {
         demonstrateLockContention();
         demonstrateThreadAffinity();
         analyzeScalability();
+        analyzeReadMostlyScaling();
         benchmarkMemoryOrdering();
         demonstrateWorkDistribution();
+        demonstrateBenchmarkHarness();
         demonstrateProfilingTechniques();
         
         std::cout << "=== KEY PERFORMANCE INSIGHTS ===\n";
@@ -611,66 +1435,114 @@ This file analyzes performance characteristics of threading
 
 === FALSE SHARING DEMONSTRATION ===
 
-Unpadded counters (false sharing) took: [longer_time] microseconds
-Padded counters (no false sharing) took: [shorter_time] microseconds
+Unpadded counters (false sharing) [4 threads]: median [higher] ns/op (min [...], p90 [...], max [...]; n=5)
+Padded counters (no false sharing) [4 threads]: median [lower] ns/op (min [...], p90 [...], max [...]; n=5)
+
+Counters, one extra run each (context switches are totals):
+  [hardware counters unavailable: ...]   (only without a PMU, e.g. in most VMs)
+  per operation                cycles     instr    IPC  L1D miss  LLC miss   br miss   ctx sw
+  Unpadded counters          [higher]       [~]    [~]  [higher]       [~]       [~]      [n]
+  Padded counters             [lower]       [~]    [~]   [lower]       [~]       [~]      [n]
 Padded version should be significantly faster due to avoided false sharing
 
 === MEMORY ACCESS PATTERNS ===
 
-Sequential memory access took: [shorter_time] microseconds
-Random memory access took: [longer_time] microseconds
-Sequential access should be much faster due to cache locality
+Sequential memory access [4 threads]: median [lower] ns/op (...)
+Random memory access [4 threads]: median [higher] ns/op (...)
+
+Counters, one extra run each (context switches are totals):
+  per operation                cycles     instr    IPC  L1D miss  LLC miss   br miss   ctx sw
+  Sequential, per element     [small]      [...]  [high]  [~0.06]   [small]       [~0]      [n]
+  Random, per element         [large]      [...]   [low]    [~1]    [~1]       [...]      [n]
+
+Sequential access should be much faster per element due to cache locality
 
 === LOCK CONTENTION ANALYSIS ===
 
-High contention (single mutex) took: [longer_time] microseconds
-Distributed contention (multiple mutexes) took: [shorter_time] microseconds
+High contention (single mutex) [8 threads]: median [higher] ns/op (...)
+Distributed contention (multiple mutex) [8 threads]: median [lower] ns/op (...)
+Total distributed count: 4800000 (expected 4800000)
+Counters for the mutex runs (context switches are totals):
+  per operation                cycles     instr    IPC  L1D miss  LLC miss   br miss   ctx sw
+  Single mutex               [higher]      [...]   [...]  [higher]     [...]     [...]  [more]
+  Distributed mutexes         [lower]      [...]   [...]   [lower]     [...]     [...]  [fewer]
+
+Spinlocks with [2-8] threads x 20000 iterations:
+[same pair for TAS spinlock and ticket lock]
 Distributed version should be faster due to reduced contention
-Total distributed count: 800000
 
-=== THREAD AFFINITY CONSIDERATIONS ===
+=== THREAD AFFINITY AND NUMA PLACEMENT ===
 
-Hardware concurrency: [N] threads
-Thread-local data processing took: [time] microseconds
+Hardware concurrency: [N] threads, [M] usable CPU(s)
+  cpu0   core 0   package 0
+[one line per allowed CPU, up to 16]
+
+Unpinned, data filled by main thread [min(4, N) threads]: median [time] ns/op (...)
+compact places threads on CPUs 0 1 2 3
+Pinned compact, node-local data [min(4, N) threads]: median [time] ns/op (...)
+scatter places threads on CPUs [one per core, alternating packages]
+Pinned scatter, node-local data [min(4, N) threads]: median [time] ns/op (...)
+Pinned scatter, data filled by main thread [min(4, N) threads]: median [time] ns/op (...)
 Thread 0 processed 1000000 elements (result: [large_number])
-Thread 1 processed 1000000 elements (result: [large_number])
 [additional threads...]
 
-Note: Thread affinity can be set using platform-specific APIs
-Linux: pthread_setaffinity_np(), Windows: SetThreadAffinityMask()
+On one socket the variants differ mainly by migrations. On several,
+remote reads show up in the last row; see also the pools in 06_thread_pool.cpp
 
 === SCALABILITY ANALYSIS ===
 
 Testing scalability with increasing thread count:
 
 Atomic operations:
-  1 threads: [time1] ms (count: 50000)
-  2 threads: [time2] ms (count: 100000)
-  4 threads: [time3] ms (count: 200000)
-  8 threads: [time4] ms (count: 400000)
+Atomic increment [1 thread]: median [time] ns/op (...)
+Atomic increment [2 threads]: median [time] ns/op (...)
+[... up to min(8, cores) threads]
 
 Mutex operations:
-  1 threads: [time1] ms (count: 50000)
-  2 threads: [time2] ms (count: 100000)
-  4 threads: [time3] ms (count: 200000)
-  8 threads: [time4] ms (count: 400000)
+Mutex increment [1 thread]: median [time] ns/op (...)
+[... up to min(8, cores) threads]
 
 Note: Atomic operations should scale better than mutex-based operations
 
+Lock scalability (ns per acquisition, total across threads):
+  threads                1        2 [... cores, 2x cores*]
+  std::mutex         [ns/op per thread count]
+  TAS spinlock       [...]
+  Ticket lock        [...]
+
+=== READ-MOSTLY SCALING (M reads/s, 1 writer) ===
+
+Readers  shared_mutex  per-CPU brlock   seqlock
+      1        [rate]          [rate]    [rate]
+[... 2, 4, 8, 16, 32 readers: seqlock and brlock keep scaling, shared_mutex flattens]
+Torn reads: 0 (expected 0)
+
 === MEMORY ORDERING PERFORMANCE ===
 
-relaxed ordering: [fastest_time] microseconds (result: 4000000)
-acquire_release ordering: [medium_time] microseconds (result: 4000000)
-seq_cst ordering: [slowest_time] microseconds (result: 4000000)
+relaxed ordering [4 threads]: median [fastest] ns/op (...)
+acquire_release ordering [4 threads]: median [medium] ns/op (...)
+seq_cst ordering [4 threads]: median [slowest] ns/op (...)
 
 Relaxed ordering should be fastest, seq_cst slowest
 
 === WORK DISTRIBUTION STRATEGIES ===
 
-Static work distribution took: [time1] microseconds
-Dynamic work distribution took: [time2] microseconds
+Static work distribution: median [time] ns/op (...)
+Dynamic work distribution: median [time] ns/op (...)
 Dynamic distribution provides better load balancing
 
+=== BENCHMARK HARNESS ===
+
+Clock: rdtsc, [ns] ns/tick, [ns] ns per read
+
+Sum loop, result unused: median 0.00 ns/op (...)
+Sum loop, doNotOptimize(i) each step: median [~1-3] ns/op (...)
+Uncontended mutex lock/unlock: median [time] ns (min [...], p90 [...], p99 [...], max [...]; n=100000)
+new/delete 64 bytes: median [time] ns (...)
+
+Set BENCH_OUTPUT_DIR=<dir> (and BENCH_FORMAT=csv) to write every suite
+in this file as <dir>/<suite>.json for regression tracking
+
 === PROFILING TECHNIQUES ===
 
 Thread execution timing:
@@ -685,7 +1557,7 @@ Profiling tools and techniques:
 - Linux perf for system-level profiling
 - ThreadSanitizer for race condition detection
 - Helgrind (Valgrind) for thread error detection
-- Custom timing with std::chrono for micro-benchmarks
+- BenchmarkSuite (above) for repeatable micro-benchmarks
 
 === KEY PERFORMANCE INSIGHTS ===
 1. False sharing can significantly impact performance
@@ -724,6 +1596,9 @@ Key Learning Points:
 8. Profiling is essential for identifying performance bottlenecks
 9. Cache-line alignment prevents false sharing
 10. Understanding hardware characteristics is crucial for optimization
+11. Read-mostly data scales only if readers avoid writing shared cache lines (brlock, seqlock)
+12. Benchmark with warmup, several runs and the median; keep results alive with doNotOptimize()
+13. Confirm the cause with hardware counters (perf_event_open): cache misses, IPC, context switches
 
 Performance Optimization Strategies:
 ===================================
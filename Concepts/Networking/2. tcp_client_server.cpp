@@ -7,22 +7,48 @@
 #include <thread>
 #include <chrono>
 #include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <string_view>
+#include <algorithm>
+#include <stdexcept>
+#include <cerrno>
 #include <signal.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#if __cplusplus >= 202002L
+#include <coroutine>
+#endif
 
 const int PORT = 8080;
 const int BUFFER_SIZE = 1024;
 const char* SERVER_IP = "127.0.0.1";
-const int MAX_CLIENTS = 5;
+const int LISTEN_BACKLOG = SOMAXCONN;
 
-class TCPServer {
+// Thread-per-connection server: one blocking thread per accepted socket.
+// Simple, but every connection costs a thread stack and a context switch per
+// message, so it runs out of threads long before it runs out of bandwidth.
+// Kept as the baseline that TCPServer (below) is compared against.
+class ThreadedTCPServer {
 private:
     int server_fd;
-    struct sockaddr_in server_addr, client_addr;
-    socklen_t client_len;
-    char buffer[BUFFER_SIZE];
+    struct sockaddr_in server_addr;
+    bool verbose;
+    std::atomic<bool> running{true};
+    std::atomic<int> active_clients{0};
+    // Open client sockets, so stop() can wake threads blocked in recv()
+    std::mutex clients_mutex;
+    std::unordered_set<int> client_fds;
 
 public:
-    TCPServer() : client_len(sizeof(client_addr)) {
+    explicit ThreadedTCPServer(int port = PORT, bool verbose_output = true) : verbose(verbose_output) {
         // Create socket
         server_fd = socket(AF_INET, SOCK_STREAM, 0);
         if (server_fd < 0) {
@@ -40,7 +66,7 @@ public:
         memset(&server_addr, 0, sizeof(server_addr));
         server_addr.sin_family = AF_INET;
         server_addr.sin_addr.s_addr = INADDR_ANY;
-        server_addr.sin_port = htons(PORT);
+        server_addr.sin_port = htons(port);
 
         // Bind socket to address
         if (bind(server_fd, (const struct sockaddr*)&server_addr, sizeof(server_addr)) < 0) {
@@ -49,30 +75,33 @@ public:
         }
 
         // Start listening for connections
-        if (listen(server_fd, MAX_CLIENTS) < 0) {
+        if (listen(server_fd, LISTEN_BACKLOG) < 0) {
             close(server_fd);
             throw std::runtime_error("Listen failed");
         }
 
-        std::cout << "TCP Server listening on port " << PORT << std::endl;
+        if (verbose) std::cout << "Threaded TCP Server listening on port " << port << std::endl;
     }
 
-    ~TCPServer() {
+    ~ThreadedTCPServer() {
+        stop();
         close(server_fd);
     }
 
-    void handleClient(int client_socket) {
+    void handleClient(int client_socket, sockaddr_in client_addr) {
+        // Each connection gets its own stack buffer; a shared member buffer
+        // would be overwritten by every other client thread
+        char buffer[BUFFER_SIZE];
         char client_ip[INET_ADDRSTRLEN];
         inet_ntop(AF_INET, &client_addr.sin_addr, client_ip, INET_ADDRSTRLEN);
-        std::cout << "New client connected from " << client_ip << ":" << ntohs(client_addr.sin_port) << std::endl;
+        if (verbose) std::cout << "New client connected from " << client_ip << ":" << ntohs(client_addr.sin_port) << std::endl;
 
         while (true) {
-            memset(buffer, 0, BUFFER_SIZE);
-            
             // Receive message from client
             ssize_t bytes_received = recv(client_socket, buffer, BUFFER_SIZE - 1, 0);
-            
+
             if (bytes_received <= 0) {
+                if (!verbose) break;
                 if (bytes_received == 0) {
                     std::cout << "Client disconnected" << std::endl;
                 } else {
@@ -82,51 +111,932 @@ public:
             }
 
             buffer[bytes_received] = '\0';
-            std::cout << "Received from client: " << buffer << std::endl;
+            if (verbose) std::cout << "Received from client: " << buffer << std::endl;
 
             // Check for exit condition
             if (strcmp(buffer, "exit") == 0) {
-                std::cout << "Client requested disconnect" << std::endl;
+                if (verbose) std::cout << "Client requested disconnect" << std::endl;
                 break;
             }
 
             // Echo the message back with a prefix
-            std::string response = "Echo: " + std::string(buffer);
-            
+            std::string response = "Echo: " + std::string(buffer, bytes_received);
+
             // Send response back to client
-            ssize_t bytes_sent = send(client_socket, response.c_str(), response.length(), 0);
-            
+            ssize_t bytes_sent = send(client_socket, response.c_str(), response.length(), MSG_NOSIGNAL);
+
             if (bytes_sent < 0) {
                 std::cerr << "Error sending response to client" << std::endl;
                 break;
-            } else {
+            } else if (verbose) {
                 std::cout << "Sent response: " << response << std::endl;
             }
         }
 
+        {
+            // Unregister before closing: once closed, the fd number can be
+            // reused and stop() must not shut down someone else's socket
+            std::lock_guard<std::mutex> lock(clients_mutex);
+            client_fds.erase(client_socket);
+        }
         close(client_socket);
-        std::cout << "Client connection closed" << std::endl;
+        if (verbose) std::cout << "Client connection closed" << std::endl;
+        active_clients.fetch_sub(1, std::memory_order_release);
     }
 
     void start() {
-        std::cout << "Server started. Waiting for connections..." << std::endl;
-        
-        while (true) {
+        if (verbose) std::cout << "Server started. Waiting for connections..." << std::endl;
+
+        while (running.load(std::memory_order_relaxed)) {
             // Accept incoming connection
+            sockaddr_in client_addr{};
+            socklen_t client_len = sizeof(client_addr);
             int client_socket = accept(server_fd, (struct sockaddr*)&client_addr, &client_len);
-            
+
             if (client_socket < 0) {
+                if (!running.load(std::memory_order_relaxed)) break;
                 std::cerr << "Error accepting connection" << std::endl;
                 continue;
             }
 
+            {
+                // Checked under the lock, so a socket accepted while stop()
+                // runs is either shut down by it or closed here
+                std::lock_guard<std::mutex> lock(clients_mutex);
+                if (!running.load(std::memory_order_relaxed)) {
+                    close(client_socket);
+                    break;
+                }
+                client_fds.insert(client_socket);
+            }
+
             // Handle client in a separate thread for concurrent connections
-            std::thread client_thread(&TCPServer::handleClient, this, client_socket);
+            active_clients.fetch_add(1, std::memory_order_relaxed);
+            std::thread client_thread(&ThreadedTCPServer::handleClient, this, client_socket, client_addr);
             client_thread.detach(); // Detach thread to handle multiple clients
         }
     }
+
+    // Unblocks accept() and every client's recv(), then waits for the
+    // detached client threads to finish
+    void stop() {
+        if (!running.exchange(false)) return;
+        shutdown(server_fd, SHUT_RDWR);
+        {
+            std::lock_guard<std::mutex> lock(clients_mutex);
+            for (int fd : client_fds) shutdown(fd, SHUT_RDWR);
+        }
+        while (active_clients.load(std::memory_order_acquire) > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
 };
 
+// Event-driven echo server: a fixed number of epoll loops, each on its own
+// thread, serve every connection. Each loop owns a listening socket bound
+// to the same port with SO_REUSEPORT, so the kernel spreads new connections
+// across loops and a connection is only ever touched by one thread.
+//
+// Sockets are non-blocking and registered edge-triggered (EPOLLET): an event
+// fires once per readiness change, so every handler drains until EAGAIN.
+// Each connection has its own read buffer and a pending-output buffer.
+// When a peer stops reading, output piles up; above kHighWaterMark the loop
+// stops reading from that connection until EPOLLOUT drains it below
+// kLowWaterMark, so a slow client cannot make the server buffer unboundedly.
+class TCPServer {
+public:
+    static constexpr size_t kMaxEvents = 256;
+    static constexpr size_t kHighWaterMark = 256 * 1024;
+    static constexpr size_t kLowWaterMark = 64 * 1024;
+
+    struct Stats {
+        uint64_t accepted = 0;
+        uint64_t bytes_in = 0;
+        uint64_t bytes_out = 0;
+        uint64_t backpressure_pauses = 0;
+        uint64_t epoll_batches = 0;
+        uint64_t dispatch_ns = 0;      // Time spent handling those batches
+    };
+
+    explicit TCPServer(int port = PORT, size_t num_loops = std::thread::hardware_concurrency(),
+                       bool verbose_output = true)
+        : port_(port), verbose_(verbose_output) {
+        if (num_loops == 0) num_loops = 1;
+        try {
+            for (size_t i = 0; i < num_loops; ++i) {
+                auto loop = std::make_unique<Loop>();
+                loop->listen_fd = createListenSocket(port);
+                loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+                loop->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                loops_.push_back(std::move(loop));
+                Loop& l = *loops_.back();
+                if (l.epoll_fd < 0 || l.wake_fd < 0) {
+                    throw std::runtime_error("epoll/eventfd creation failed");
+                }
+                addToEpoll(l, l.listen_fd, EPOLLIN | EPOLLET);
+                addToEpoll(l, l.wake_fd, EPOLLIN);
+            }
+        } catch (...) {
+            closeAll();
+            throw;
+        }
+
+        if (verbose_) {
+            std::cout << "TCP Server (epoll, " << loops_.size() << " loops) listening on port "
+                      << port_ << std::endl;
+        }
+    }
+
+    ~TCPServer() {
+        stop();
+        closeAll();
+    }
+
+    TCPServer(const TCPServer&) = delete;
+    TCPServer& operator=(const TCPServer&) = delete;
+
+    // Starts the event loops and returns immediately
+    void start() {
+        if (running_.exchange(true)) return;
+        for (auto& loop : loops_) {
+            loop->thread = std::thread(&TCPServer::runLoop, this, std::ref(*loop));
+        }
+        if (verbose_) std::cout << "Server started. Waiting for connections..." << std::endl;
+    }
+
+    void stop() {
+        if (!running_.exchange(false)) return;
+        for (auto& loop : loops_) {
+            uint64_t one = 1;
+            ssize_t ignored = write(loop->wake_fd, &one, sizeof(one));
+            (void)ignored;
+        }
+        for (auto& loop : loops_) {
+            if (loop->thread.joinable()) loop->thread.join();
+            for (auto& entry : loop->connections) close(entry.first);
+            loop->connections.clear();
+        }
+    }
+
+    Stats stats() const {
+        Stats total;
+        for (const auto& loop : loops_) {
+            total.accepted += loop->accepted.load(std::memory_order_relaxed);
+            total.bytes_in += loop->bytes_in.load(std::memory_order_relaxed);
+            total.bytes_out += loop->bytes_out.load(std::memory_order_relaxed);
+            total.backpressure_pauses += loop->pauses.load(std::memory_order_relaxed);
+            total.epoll_batches += loop->batches.load(std::memory_order_relaxed);
+            total.dispatch_ns += loop->dispatch_ns.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    size_t loopCount() const { return loops_.size(); }
+
+private:
+    struct Connection {
+        int fd;
+        std::vector<char> in;       // Read buffer, reused for every recv
+        std::string out;            // Output not yet accepted by the kernel
+        size_t out_offset = 0;      // First unsent byte in out
+        bool paused = false;        // Reading suspended by backpressure
+        bool closing = false;       // Close once output is flushed ("exit")
+
+        explicit Connection(int socket_fd) : fd(socket_fd), in(BUFFER_SIZE) {}
+        size_t pending() const { return out.size() - out_offset; }
+    };
+
+    struct Loop {
+        int listen_fd = -1;
+        int epoll_fd = -1;
+        int wake_fd = -1;
+        std::thread thread;
+        std::unordered_map<int, std::unique_ptr<Connection>> connections;
+        std::atomic<uint64_t> accepted{0};
+        std::atomic<uint64_t> bytes_in{0};
+        std::atomic<uint64_t> bytes_out{0};
+        std::atomic<uint64_t> pauses{0};
+        std::atomic<uint64_t> batches{0};
+        std::atomic<uint64_t> dispatch_ns{0};
+    };
+
+    int port_;
+    bool verbose_;
+    std::atomic<bool> running_{false};
+    std::vector<std::unique_ptr<Loop>> loops_;
+
+    static int createListenSocket(int port) {
+        int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            throw std::runtime_error("Socket creation failed");
+        }
+
+        // SO_REUSEPORT lets every loop bind its own socket to the same port;
+        // the kernel load-balances incoming connections between them
+        int opt = 1;
+        if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0 ||
+            setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+            close(fd);
+            throw std::runtime_error("Set socket options failed");
+        }
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = INADDR_ANY;
+        addr.sin_port = htons(port);
+        if (bind(fd, (const struct sockaddr*)&addr, sizeof(addr)) < 0) {
+            close(fd);
+            throw std::runtime_error("Bind failed");
+        }
+        if (listen(fd, LISTEN_BACKLOG) < 0) {
+            close(fd);
+            throw std::runtime_error("Listen failed");
+        }
+        return fd;
+    }
+
+    static void addToEpoll(Loop& loop, int fd, uint32_t events) {
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.fd = fd;
+        if (epoll_ctl(loop.epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            throw std::runtime_error("epoll_ctl failed");
+        }
+    }
+
+    void closeAll() {
+        for (auto& loop : loops_) {
+            if (loop->listen_fd >= 0) close(loop->listen_fd);
+            if (loop->epoll_fd >= 0) close(loop->epoll_fd);
+            if (loop->wake_fd >= 0) close(loop->wake_fd);
+            loop->listen_fd = loop->epoll_fd = loop->wake_fd = -1;
+        }
+    }
+
+    void runLoop(Loop& loop) {
+        epoll_event events[kMaxEvents];
+
+        while (running_.load(std::memory_order_relaxed)) {
+            int n = epoll_wait(loop.epoll_fd, events, kMaxEvents, -1);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                std::cerr << "epoll_wait failed: " << strerror(errno) << std::endl;
+                break;
+            }
+
+            // Long batches are what delay every other connection on this loop
+            auto batch_start = std::chrono::steady_clock::now();
+            for (int i = 0; i < n; ++i) {
+                int fd = events[i].data.fd;
+                uint32_t ev = events[i].events;
+
+                if (fd == loop.wake_fd) continue;  // stop() was called
+                if (fd == loop.listen_fd) {
+                    acceptAll(loop);
+                    continue;
+                }
+
+                auto it = loop.connections.find(fd);
+                if (it == loop.connections.end()) continue;
+                Connection& conn = *it->second;
+
+                // Read first even on HUP/ERR so data sent just before
+                // close is still echoed; recv() then reports the error
+                bool alive = true;
+                if (ev & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) alive = onReadable(loop, conn);
+                if (alive && (ev & EPOLLOUT)) alive = onWritable(loop, conn);
+                if (!alive) closeConnection(loop, fd);
+            }
+            auto batch_time = std::chrono::steady_clock::now() - batch_start;
+            loop.dispatch_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(batch_time).count(),
+                                       std::memory_order_relaxed);
+            loop.batches.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void acceptAll(Loop& loop) {
+        while (true) {
+            sockaddr_in client_addr{};
+            socklen_t client_len = sizeof(client_addr);
+            int fd = accept4(loop.listen_fd, (struct sockaddr*)&client_addr, &client_len,
+                             SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    std::cerr << "Error accepting connection: " << strerror(errno) << std::endl;
+                }
+                return;  // Backlog drained (or out of fds; retried on next event)
+            }
+
+            int opt = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+
+            // Both directions registered once; edge-triggered EPOLLOUT only
+            // fires when the send buffer goes from full to writable, so
+            // leaving it armed costs nothing while output is flowing
+            try {
+                addToEpoll(loop, fd, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET);
+            } catch (const std::exception&) {
+                close(fd);
+                continue;
+            }
+            loop.connections.emplace(fd, std::make_unique<Connection>(fd));
+            loop.accepted.fetch_add(1, std::memory_order_relaxed);
+
+            if (verbose_) {
+                char client_ip[INET_ADDRSTRLEN];
+                inet_ntop(AF_INET, &client_addr.sin_addr, client_ip, INET_ADDRSTRLEN);
+                std::cout << "New client connected from " << client_ip << ":"
+                          << ntohs(client_addr.sin_port) << std::endl;
+            }
+        }
+    }
+
+    // Drains the socket; returns false when the connection should be closed
+    bool onReadable(Loop& loop, Connection& conn) {
+        while (!conn.paused && !conn.closing) {
+            // Same chunk size as the threaded server so echoes match exactly
+            ssize_t n = recv(conn.fd, conn.in.data(), BUFFER_SIZE - 1, 0);
+            if (n > 0) {
+                loop.bytes_in.fetch_add(n, std::memory_order_relaxed);
+                std::string_view message(conn.in.data(), n);
+                if (verbose_) std::cout << "Received from client: " << message << std::endl;
+
+                if (message == "exit") {
+                    if (verbose_) std::cout << "Client requested disconnect" << std::endl;
+                    conn.closing = true;
+                    break;
+                }
+
+                conn.out.append("Echo: ").append(message);
+                if (conn.pending() >= kHighWaterMark) {
+                    if (!flush(loop, conn)) return false;
+                    if (conn.pending() >= kHighWaterMark) {
+                        conn.paused = true;  // Resumed by onWritable
+                        loop.pauses.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            } else if (n == 0) {
+                if (verbose_) std::cout << "Client disconnected" << std::endl;
+                return false;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            } else if (errno != EINTR) {
+                return false;
+            }
+        }
+
+        if (!flush(loop, conn)) return false;
+        return !(conn.closing && conn.pending() == 0);
+    }
+
+    bool onWritable(Loop& loop, Connection& conn) {
+        if (!flush(loop, conn)) return false;
+        if (conn.closing && conn.pending() == 0) return false;
+
+        if (conn.paused && conn.pending() < kLowWaterMark) {
+            conn.paused = false;
+            // Edge-triggered: input that arrived while paused produced no new
+            // event, so read it now
+            return onReadable(loop, conn);
+        }
+        return true;
+    }
+
+    // Writes as much pending output as the kernel accepts
+    bool flush(Loop& loop, Connection& conn) {
+        while (conn.pending() > 0) {
+            ssize_t n = send(conn.fd, conn.out.data() + conn.out_offset, conn.pending(), MSG_NOSIGNAL);
+            if (n > 0) {
+                conn.out_offset += n;
+                loop.bytes_out.fetch_add(n, std::memory_order_relaxed);
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                return true;  // EPOLLOUT will call us again
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else {
+                return false;
+            }
+        }
+        conn.out.clear();
+        conn.out_offset = 0;
+        return true;
+    }
+
+    void closeConnection(Loop& loop, int fd) {
+        close(fd);  // Also removes it from the epoll set
+        loop.connections.erase(fd);
+        if (verbose_) std::cout << "Client connection closed" << std::endl;
+    }
+};
+
+// ===== C++20 COROUTINES ON THE EPOLL REACTOR =====
+// The same echo protocol written as one straight-line coroutine per
+// connection: async_accept / async_read / async_write suspend the session
+// instead of blocking a thread, and the reactor resumes it on readiness.
+
+#if __cplusplus >= 202002L
+
+// A session is created by its loop's accept loop and finishes on the same
+// reactor thread, so its frame is always freed where it was allocated.
+// That makes a plain per-thread free list per frame size enough: the
+// cross-thread version, with a shared depot, is FramePool in
+// Multithreading/06_thread_pool.cpp. At most kMaxCached frames of each
+// size are kept, so a burst of connections does not pin its memory.
+class SessionFrames {
+private:
+    static constexpr size_t kMaxCached = 1024;
+
+    struct FreeFrame {
+        FreeFrame* next;
+    };
+
+    struct FreeList {
+        size_t size;
+        FreeFrame* head = nullptr;
+        size_t count = 0;
+    };
+
+    // A server has two frame sizes (accept loop and session), so a short
+    // vector searched linearly beats a map
+    struct Cache {
+        std::vector<FreeList> lists;
+
+        ~Cache() {
+            for (FreeList& list : lists) {
+                while (FreeFrame* frame = list.head) {
+                    list.head = frame->next;
+                    ::operator delete(frame);
+                }
+            }
+        }
+
+        FreeList* find(size_t size) {
+            for (FreeList& list : lists) {
+                if (list.size == size) return &list;
+            }
+            return nullptr;
+        }
+    };
+
+    static Cache& cache() {
+        static thread_local Cache instance;
+        return instance;
+    }
+
+public:
+    static void* allocate(size_t size) {
+        Cache& c = cache();
+        FreeList* list = c.find(size);
+        if (!list) {
+            c.lists.push_back(FreeList{size});
+            list = &c.lists.back();
+        }
+        if (!list->head) return ::operator new(size);
+        FreeFrame* frame = list->head;
+        list->head = frame->next;
+        --list->count;
+        return frame;
+    }
+
+    // Never allocates: a size this thread has not handed out goes to the heap
+    static void deallocate(void* p, size_t size) noexcept {
+        FreeList* list = cache().find(size);
+        if (!list || list->count >= kMaxCached) {
+            ::operator delete(p);
+            return;
+        }
+        list->head = new (p) FreeFrame{list->head};
+        ++list->count;
+    }
+};
+
+// A session or accept loop: runs eagerly up to its first co_await and
+// hands its frame back to SessionFrames when it returns. Exceptions must
+// not escape it.
+struct session_task {
+    struct promise_type {
+        static void* operator new(size_t size) { return SessionFrames::allocate(size); }
+        static void operator delete(void* p, size_t size) noexcept { SessionFrames::deallocate(p, size); }
+
+        session_task get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+// Single-threaded epoll reactor that resumes coroutines. Each AsyncSocket
+// is registered once, edge-triggered for both directions. An awaitable
+// first tries its syscall. Only on EAGAIN does it park itself on the
+// socket. When the fd becomes ready, the reactor retries the syscall on
+// the coroutine's behalf and resumes the coroutine once it completes, so
+// a resumed coroutine never sees a spurious EAGAIN.
+//
+// A listener out of fds (EMFILE/ENFILE) cannot wait for readiness: the
+// pending connection already raised its edge and nothing else will. Its
+// accept is queued for a retry after kRetryMs instead.
+//
+// One coroutine drives each socket, so at most one operation is pending
+// on it. Everything runs on the reactor's thread, which also means
+// readiness cannot slip in between a failed syscall and the parking.
+class Reactor;
+
+struct IoOperation {
+    std::coroutine_handle<> waiter;
+    uint32_t events = 0;  // EPOLLIN or EPOLLOUT
+    ssize_t result = 0;   // Bytes or fd on success, -errno on failure
+
+    // Retries the syscall; false means "still would block"
+    virtual bool attempt() = 0;
+
+protected:
+    ~IoOperation() = default;
+};
+
+class AsyncSocket {
+public:
+    AsyncSocket(Reactor& reactor, int fd);
+    ~AsyncSocket();
+    AsyncSocket(const AsyncSocket&) = delete;
+    AsyncSocket& operator=(const AsyncSocket&) = delete;
+
+    int fd() const { return fd_; }
+    Reactor& reactor() const { return reactor_; }
+
+private:
+    friend class Reactor;
+    friend struct IoAwaiterBase;
+
+    Reactor& reactor_;
+    int fd_;
+    IoOperation* pending_ = nullptr;
+    AsyncSocket* prev_ = nullptr;  // Intrusive list of live sockets, for shutdown
+    AsyncSocket* next_ = nullptr;
+};
+
+class Reactor {
+public:
+    static constexpr size_t kMaxEvents = 256;
+    static constexpr int kRetryMs = 10;
+
+    Reactor() : epoll_fd_(epoll_create1(EPOLL_CLOEXEC)), wake_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+        if (epoll_fd_ < 0 || wake_fd_ < 0) {
+            if (epoll_fd_ >= 0) close(epoll_fd_);
+            if (wake_fd_ >= 0) close(wake_fd_);
+            throw std::runtime_error("epoll/eventfd creation failed");
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = nullptr;  // nullptr marks the wake-up fd
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev);
+    }
+
+    ~Reactor() {
+        close(epoll_fd_);
+        close(wake_fd_);
+    }
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    // Runs until stop(), then fails every pending operation with
+    // -ECANCELED so that suspended coroutines unwind and free their frames
+    void run() {
+        epoll_event events[kMaxEvents];
+        while (!stopping_.load(std::memory_order_relaxed)) {
+            int n = epoll_wait(epoll_fd_, events, kMaxEvents, retry_.empty() ? -1 : kRetryMs);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            runRetries();
+            for (int i = 0; i < n; ++i) {
+                auto* socket = static_cast<AsyncSocket*>(events[i].data.ptr);
+                if (!socket) continue;  // Woken by stop()
+                IoOperation* op = socket->pending_;
+                if (!op) continue;  // Nobody waiting; the next operation tries the syscall first
+                uint32_t ready = events[i].events;
+                if (!(ready & (op->events | EPOLLERR | EPOLLHUP | EPOLLRDHUP))) continue;
+                if (!op->attempt()) continue;
+                socket->pending_ = nullptr;
+                op->waiter.resume();  // May destroy the socket; not touched again
+            }
+        }
+        cancelAll();
+    }
+
+    // Callable from any thread
+    void stop() {
+        stopping_.store(true, std::memory_order_relaxed);
+        uint64_t one = 1;
+        ssize_t ignored = write(wake_fd_, &one, sizeof(one));
+        (void)ignored;
+    }
+
+    bool stopping() const { return stopping_.load(std::memory_order_relaxed); }
+    size_t liveSockets() const { return live_; }
+
+    // Re-attempts the socket's pending operation after kRetryMs, whether
+    // or not epoll reports it ready again
+    void retryLater(AsyncSocket& socket) {
+        if (retry_.empty()) retry_at_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(kRetryMs);
+        if (std::find(retry_.begin(), retry_.end(), &socket) == retry_.end()) retry_.push_back(&socket);
+    }
+
+private:
+    friend class AsyncSocket;
+
+    int epoll_fd_;
+    int wake_fd_;
+    std::atomic<bool> stopping_{false};
+    AsyncSocket* sockets_ = nullptr;
+    size_t live_ = 0;
+    std::vector<AsyncSocket*> retry_;
+    std::chrono::steady_clock::time_point retry_at_;
+
+    void runRetries() {
+        if (retry_.empty() || std::chrono::steady_clock::now() < retry_at_) return;
+        // Entries queued while retrying wait for the next round. A resumed
+        // coroutine may destroy sockets, which remove() drops from retry_
+        for (size_t due = retry_.size(); due > 0 && !retry_.empty(); --due) {
+            AsyncSocket* socket = retry_.front();
+            retry_.erase(retry_.begin());
+            IoOperation* op = socket->pending_;
+            if (!op || !op->attempt()) continue;
+            socket->pending_ = nullptr;
+            op->waiter.resume();
+        }
+        retry_at_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(kRetryMs);
+    }
+
+    void cancelAll() {
+        // Resuming a coroutine can destroy its socket (and others), so
+        // restart from the list head after every resume
+        for (bool progress = true; progress;) {
+            progress = false;
+            for (AsyncSocket* s = sockets_; s; s = s->next_) {
+                if (IoOperation* op = s->pending_) {
+                    s->pending_ = nullptr;
+                    op->result = -ECANCELED;
+                    op->waiter.resume();
+                    progress = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    void add(AsyncSocket& socket) {
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        ev.data.ptr = &socket;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, socket.fd_, &ev) < 0) {
+            throw std::runtime_error("epoll_ctl failed");
+        }
+        socket.next_ = sockets_;
+        if (sockets_) sockets_->prev_ = &socket;
+        sockets_ = &socket;
+        ++live_;
+    }
+
+    void remove(AsyncSocket& socket) {
+        if (socket.prev_) {
+            socket.prev_->next_ = socket.next_;
+        } else {
+            sockets_ = socket.next_;
+        }
+        if (socket.next_) socket.next_->prev_ = socket.prev_;
+        retry_.erase(std::remove(retry_.begin(), retry_.end(), &socket), retry_.end());
+        --live_;
+    }
+};
+
+AsyncSocket::AsyncSocket(Reactor& reactor, int fd) : reactor_(reactor), fd_(fd) {
+    try {
+        reactor_.add(*this);
+    } catch (...) {
+        close(fd_);
+        throw;
+    }
+}
+
+// Closing the fd also removes it from the epoll set
+AsyncSocket::~AsyncSocket() {
+    reactor_.remove(*this);
+    close(fd_);
+}
+
+struct IoAwaiterBase : IoOperation {
+    AsyncSocket& socket;
+
+    explicit IoAwaiterBase(AsyncSocket& s, uint32_t wanted) : socket(s) { events = wanted; }
+
+    bool await_ready() {
+        if (socket.reactor().stopping()) {
+            result = -ECANCELED;
+            return true;
+        }
+        return attempt();
+    }
+    void await_suspend(std::coroutine_handle<> handle) {
+        waiter = handle;
+        socket.pending_ = this;
+    }
+    ssize_t await_resume() const noexcept { return result; }
+};
+
+// Reads up to len bytes: result is the byte count, 0 on EOF, or -errno
+struct ReadAwaiter final : IoAwaiterBase {
+    char* buffer;
+    size_t len;
+    ReadAwaiter(AsyncSocket& s, char* buf, size_t n) : IoAwaiterBase(s, EPOLLIN), buffer(buf), len(n) {}
+    bool attempt() override {
+        for (;;) {
+            ssize_t n = recv(socket.fd(), buffer, len, 0);
+            if (n >= 0) {
+                result = n;
+                return true;
+            }
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return false;
+            result = -errno;
+            return true;
+        }
+    }
+};
+
+// Writes all len bytes (suspending as often as needed): result is len or -errno
+struct WriteAwaiter final : IoAwaiterBase {
+    const char* data;
+    size_t len;
+    size_t sent = 0;
+    WriteAwaiter(AsyncSocket& s, const char* d, size_t n) : IoAwaiterBase(s, EPOLLOUT), data(d), len(n) {}
+    bool attempt() override {
+        while (sent < len) {
+            ssize_t n = send(socket.fd(), data + sent, len - sent, MSG_NOSIGNAL);
+            if (n > 0) {
+                sent += n;
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                return false;
+            } else {
+                result = n < 0 ? -errno : -EPIPE;
+                return true;
+            }
+        }
+        result = static_cast<ssize_t>(len);
+        return true;
+    }
+};
+
+// Accepts one connection: result is a non-blocking fd or -errno
+struct AcceptAwaiter final : IoAwaiterBase {
+    explicit AcceptAwaiter(AsyncSocket& listener) : IoAwaiterBase(listener, EPOLLIN) {}
+    bool attempt() override {
+        for (;;) {
+            int fd = accept4(socket.fd(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd >= 0) {
+                result = fd;
+                return true;
+            }
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return false;
+            // Out of fds: the connection stays in the backlog and its edge
+            // has already fired, so poll again on a timer instead
+            if (errno == EMFILE || errno == ENFILE) {
+                socket.reactor().retryLater(socket);
+                return false;
+            }
+            result = -errno;
+            return true;
+        }
+    }
+};
+
+inline ReadAwaiter async_read(AsyncSocket& s, char* buffer, size_t len) { return {s, buffer, len}; }
+inline WriteAwaiter async_write(AsyncSocket& s, const char* data, size_t len) { return {s, data, len}; }
+inline AcceptAwaiter async_accept(AsyncSocket& listener) { return AcceptAwaiter(listener); }
+
+// Echo server written as straight-line coroutines on N reactor threads.
+// It speaks the same protocol as TCPServer. A session's frame (about
+// BUFFER_SIZE bytes, from SessionFrames) is its whole per-connection cost, so
+// 100k idle sessions take ~130 MB and no threads. Backpressure is
+// implicit: a session does not read again until its echo has been written.
+class CoroutineTCPServer {
+public:
+    CoroutineTCPServer(int port, size_t num_loops) {
+        if (num_loops == 0) num_loops = 1;
+        try {
+            for (size_t i = 0; i < num_loops; ++i) {
+                auto loop = std::make_unique<Loop>();
+                loop->listen_fd = createReusePortListener(port);
+                loops_.push_back(std::move(loop));
+            }
+        } catch (...) {
+            for (auto& loop : loops_) close(loop->listen_fd);
+            throw;
+        }
+    }
+
+    // Before start() the listeners are still owned here; afterwards each
+    // accept loop's AsyncSocket owns (and closes) its listener
+    ~CoroutineTCPServer() {
+        stop();
+        if (!started_) {
+            for (auto& loop : loops_) close(loop->listen_fd);
+        }
+    }
+
+    void start() {
+        if (started_) return;
+        started_ = true;
+        for (auto& loop : loops_) {
+            loop->thread = std::thread([this, &loop = *loop] {
+                // The listener and every session live on this thread
+                acceptLoop(loop);
+                loop.reactor.run();
+            });
+        }
+    }
+
+    void stop() {
+        for (auto& loop : loops_) loop->reactor.stop();
+        for (auto& loop : loops_) {
+            if (loop->thread.joinable()) loop->thread.join();
+        }
+    }
+
+    size_t loopCount() const { return loops_.size(); }
+    uint64_t accepted() const {
+        uint64_t total = 0;
+        for (const auto& loop : loops_) total += loop->accepted.load(std::memory_order_relaxed);
+        return total;
+    }
+
+private:
+    struct Loop {
+        Reactor reactor;
+        int listen_fd = -1;
+        std::thread thread;
+        std::atomic<uint64_t> accepted{0};
+    };
+
+    std::vector<std::unique_ptr<Loop>> loops_;
+    bool started_ = false;
+
+    static int createReusePortListener(int port) {
+        int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) throw std::runtime_error("Socket creation failed");
+        int opt = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = INADDR_ANY;
+        addr.sin_port = htons(port);
+        if (bind(fd, (const struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, LISTEN_BACKLOG) < 0) {
+            close(fd);
+            throw std::runtime_error("Bind/listen failed");
+        }
+        return fd;
+    }
+
+    session_task acceptLoop(Loop& loop) {
+        AsyncSocket listener(loop.reactor, loop.listen_fd);
+        for (;;) {
+            ssize_t fd = co_await async_accept(listener);
+            if (fd == -ECANCELED) break;
+            if (fd < 0) continue;
+            int opt = 1;
+            setsockopt(static_cast<int>(fd), IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+            loop.accepted.fetch_add(1, std::memory_order_relaxed);
+            session(loop.reactor, static_cast<int>(fd));  // Runs until its first suspension
+        }
+    }
+
+    static session_task session(Reactor& reactor, int fd) {
+        AsyncSocket socket(reactor, fd);
+        // The reply prefix sits right before the receive area, so the echo
+        // goes out with a single send and no copy
+        static constexpr char kPrefix[] = "Echo: ";
+        constexpr size_t kPrefixLen = sizeof(kPrefix) - 1;
+        char buffer[kPrefixLen + BUFFER_SIZE];
+        std::memcpy(buffer, kPrefix, kPrefixLen);
+
+        for (;;) {
+            ssize_t n = co_await async_read(socket, buffer + kPrefixLen, BUFFER_SIZE - 1);
+            if (n <= 0) break;
+            if (std::string_view(buffer + kPrefixLen, n) == "exit") break;
+            if (co_await async_write(socket, buffer, kPrefixLen + n) < 0) break;
+        }
+    }
+};
+
+#endif  // __cplusplus >= 202002L
+
 class TCPClient {
 private:
     int client_fd;
@@ -277,14 +1187,240 @@ void demonstrateTCPCommunication() {
     }
 }
 
+// Load generator used to compare the two servers. Each client thread owns a
+// slice of the connections. It sends one message on every connection, then
+// collects every echo, so all connections have a request in flight at once.
+struct LoadResult {
+    size_t connections = 0;
+    uint64_t round_trips = 0;
+    double seconds = 0;
+    bool ok = true;
+};
+
+LoadResult runEchoLoad(int port, size_t connections, size_t rounds, size_t threads) {
+    std::atomic<uint64_t> completed{0};
+    std::atomic<bool> ok{true};
+    std::atomic<size_t> connected{0};
+    std::atomic<bool> go{false};
+
+    auto worker = [&](size_t first, size_t count) {
+        std::vector<int> fds;
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        inet_pton(AF_INET, SERVER_IP, &addr.sin_addr);
+
+        for (size_t i = 0; i < count; ++i) {
+            int fd = socket(AF_INET, SOCK_STREAM, 0);
+            if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+                if (fd >= 0) close(fd);
+                ok = false;
+                break;
+            }
+            int opt = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+            fds.push_back(fd);
+        }
+        connected.fetch_add(1);
+        while (!go.load()) std::this_thread::yield();
+
+        char buffer[BUFFER_SIZE];
+        for (size_t round = 0; round < rounds && ok.load(std::memory_order_relaxed); ++round) {
+            for (size_t i = 0; i < fds.size(); ++i) {
+                std::string msg = "conn-" + std::to_string(first + i) + "-round-" + std::to_string(round);
+                if (send(fds[i], msg.data(), msg.size(), MSG_NOSIGNAL) != (ssize_t)msg.size()) ok = false;
+            }
+            for (size_t i = 0; i < fds.size(); ++i) {
+                std::string expected = "Echo: conn-" + std::to_string(first + i) + "-round-" + std::to_string(round);
+                size_t got = 0;
+                while (got < expected.size()) {
+                    ssize_t n = recv(fds[i], buffer + got, expected.size() - got, 0);
+                    if (n <= 0) { ok = false; break; }
+                    got += n;
+                }
+                if (got != expected.size() || expected.compare(0, got, buffer, got) != 0) ok = false;
+                else completed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        for (int fd : fds) close(fd);
+    };
+
+    std::vector<std::thread> workers;
+    size_t per_thread = (connections + threads - 1) / threads;
+    for (size_t t = 0, first = 0; t < threads && first < connections; ++t, first += per_thread) {
+        workers.emplace_back(worker, first, std::min(per_thread, connections - first));
+    }
+    while (connected.load() < workers.size()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    auto start = std::chrono::steady_clock::now();
+    go = true;
+    for (auto& w : workers) w.join();
+    auto end = std::chrono::steady_clock::now();
+
+    LoadResult result;
+    result.connections = connections;
+    result.round_trips = completed.load();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    result.ok = ok.load();
+    return result;
+}
+
+void printLoadResult(const char* name, const LoadResult& r, size_t server_threads) {
+    std::cout << name << ": " << r.connections << " connections, " << r.round_trips
+              << " round trips in " << r.seconds * 1000 << " ms ("
+              << (r.seconds > 0 ? r.round_trips / r.seconds / 1000 : 0) << " K echoes/s) using "
+              << server_threads << " server threads" << (r.ok ? "" : "  [ERRORS]") << std::endl;
+}
+
+// Raises the soft fd limit to the hard limit; each connection costs two fds
+// (client and server side) when both run in this process
+void raiseFileLimit() {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+// Runs both servers in-process against the same load: same messages, same
+// echo protocol, same number of concurrent connections
+void benchmarkServers(size_t connections, size_t rounds) {
+    std::cout << "\n=== Thread-per-connection vs epoll reactor ===" << std::endl;
+    raiseFileLimit();
+    const size_t client_threads = 4;
+
+    {
+        ThreadedTCPServer server(PORT + 1, false);
+        std::thread acceptor(&ThreadedTCPServer::start, &server);
+        LoadResult r = runEchoLoad(PORT + 1, connections, rounds, client_threads);
+        server.stop();
+        acceptor.join();
+        printLoadResult("Threaded", r, connections + 1);
+    }
+
+    {
+        TCPServer server(PORT + 2, std::max(1u, std::thread::hardware_concurrency() / 2), false);
+        server.start();
+        LoadResult r = runEchoLoad(PORT + 2, connections, rounds, client_threads);
+        TCPServer::Stats stats = server.stats();
+        server.stop();
+        printLoadResult("Epoll   ", r, server.loopCount());
+        std::cout << "  accepted " << stats.accepted << ", in " << stats.bytes_in
+                  << " bytes, out " << stats.bytes_out << " bytes, backpressure pauses "
+                  << stats.backpressure_pauses << ", " << stats.epoll_batches << " epoll batches at "
+                  << (stats.epoll_batches ? stats.dispatch_ns / 1000.0 / stats.epoll_batches : 0) << " us each"
+                  << std::endl;
+    }
+
+#if __cplusplus >= 202002L
+    {
+        CoroutineTCPServer server(PORT + 3, std::max(1u, std::thread::hardware_concurrency() / 2));
+        server.start();
+        LoadResult r = runEchoLoad(PORT + 3, connections, rounds, client_threads);
+        server.stop();
+        printLoadResult("Coro    ", r, server.loopCount());
+    }
+#endif
+}
+
+#if __cplusplus >= 202002L
+
+// Resident set size in bytes, from /proc/self/statm
+size_t residentBytes() {
+    long pages = 0, resident = 0;
+    if (FILE* f = fopen("/proc/self/statm", "r")) {
+        if (fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+        fclose(f);
+    }
+    return static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+// Opens `sessions` connections to a one-thread coroutine server, keeps
+// them all open at once, echoes once on each, and reports the user-space
+// memory each idle session costs. Kernel socket buffers are not included.
+void benchmarkIdleSessions(size_t sessions) {
+    std::cout << "\n=== Idle sessions on one coroutine reactor ===" << std::endl;
+    raiseFileLimit();
+    // Client and server ends share this process's fd table. Past the limit
+    // the listener would keep hitting EMFILE and only accept on retries.
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+        size_t fit = limit.rlim_cur > 64 ? (limit.rlim_cur - 64) / 2 : 0;
+        if (sessions > fit) {
+            std::cout << "fd limit " << limit.rlim_cur << " allows " << fit << " in-process sessions" << std::endl;
+            sessions = fit;
+        }
+    }
+
+    CoroutineTCPServer server(PORT + 4, 1);
+    server.start();
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(PORT + 4);
+    inet_pton(AF_INET, SERVER_IP, &addr.sin_addr);
+
+    // Client sockets live in the kernel, so the RSS growth from here on is
+    // the server's per-session frames, socket objects and buffers
+    std::vector<int> fds;
+    fds.reserve(sessions);
+    size_t before = residentBytes();
+    for (size_t i = 0; i < sessions; ++i) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+            if (fd >= 0) close(fd);
+            std::cout << "Stopped at " << i << " connections: " << strerror(errno) << std::endl;
+            break;
+        }
+        fds.push_back(fd);
+    }
+    while (server.accepted() < fds.size()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    size_t after = residentBytes();
+
+    size_t echoed = 0;
+    char reply[64];
+    for (int fd : fds) {
+        if (send(fd, "ping", 4, MSG_NOSIGNAL) != 4) continue;
+        size_t got = 0;
+        while (got < 10) {
+            ssize_t n = recv(fd, reply + got, sizeof(reply) - got, 0);
+            if (n <= 0) break;
+            got += n;
+        }
+        if (got == 10 && std::memcmp(reply, "Echo: ping", 10) == 0) ++echoed;
+    }
+    for (int fd : fds) close(fd);
+    server.stop();
+
+    std::cout << fds.size() << " concurrent sessions on 1 server thread, " << echoed << " echoed; ~"
+              << (after > before ? (after - before) / std::max<size_t>(1, fds.size()) : 0)
+              << " bytes of RSS per session" << std::endl;
+}
+
+#endif  // __cplusplus >= 202002L
+
 // Signal handler for graceful shutdown
 volatile sig_atomic_t shutdown_requested = 0;
 
-void signal_handler(int signal) {
+void signal_handler(int) {
     shutdown_requested = 1;
     std::cout << "\nShutdown requested..." << std::endl;
 }
 
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [server|threaded-server|coro-server|client|demo|bench|bench-idle]" << std::endl;
+    std::cout << "  server          - Run the epoll TCP server" << std::endl;
+    std::cout << "  threaded-server - Run the thread-per-connection TCP server" << std::endl;
+    std::cout << "  client          - Run as interactive TCP client" << std::endl;
+    std::cout << "  demo            - Run automated demonstration (requires server running)" << std::endl;
+    std::cout << "  bench [conns] [rounds] - Compare the servers in-process" << std::endl;
+#if __cplusplus >= 202002L
+    std::cout << "  coro-server     - Run the coroutine TCP server (C++20)" << std::endl;
+    std::cout << "  bench-idle [sessions] - Hold many idle coroutine sessions on one thread (C++20)" << std::endl;
+#endif
+}
+
 int main(int argc, char* argv[]) {
     // Set up signal handler for graceful shutdown
     signal(SIGINT, signal_handler);
@@ -297,10 +1433,58 @@ int main(int argc, char* argv[]) {
             try {
                 TCPServer server;
                 server.start();
+                while (!shutdown_requested) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                }
+                TCPServer::Stats stats = server.stats();
+                server.stop();
+                std::cout << "Served " << stats.accepted << " connections, " << stats.bytes_in << " bytes in, "
+                          << stats.bytes_out << " bytes out" << std::endl;
             } catch (const std::exception& e) {
                 std::cerr << "Server error: " << e.what() << std::endl;
                 return 1;
             }
+        } else if (mode == "threaded-server") {
+            try {
+                ThreadedTCPServer server;
+                server.start();
+            } catch (const std::exception& e) {
+                std::cerr << "Server error: " << e.what() << std::endl;
+                return 1;
+            }
+        } else if (mode == "bench") {
+            size_t connections = argc > 2 ? std::stoul(argv[2]) : 1000;
+            size_t rounds = argc > 3 ? std::stoul(argv[3]) : 200;
+            try {
+                benchmarkServers(connections, rounds);
+            } catch (const std::exception& e) {
+                std::cerr << "Benchmark error: " << e.what() << std::endl;
+                return 1;
+            }
+#if __cplusplus >= 202002L
+        } else if (mode == "coro-server") {
+            try {
+                CoroutineTCPServer server(PORT, std::thread::hardware_concurrency());
+                server.start();
+                std::cout << "Coroutine TCP server (" << server.loopCount() << " reactors) listening on port "
+                          << PORT << std::endl;
+                while (!shutdown_requested) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                }
+                server.stop();
+            } catch (const std::exception& e) {
+                std::cerr << "Server error: " << e.what() << std::endl;
+                return 1;
+            }
+        } else if (mode == "bench-idle") {
+            size_t sessions = argc > 2 ? std::stoul(argv[2]) : 5000;
+            try {
+                benchmarkIdleSessions(sessions);
+            } catch (const std::exception& e) {
+                std::cerr << "Benchmark error: " << e.what() << std::endl;
+                return 1;
+            }
+#endif
         } else if (mode == "client") {
             try {
                 TCPClient client;
@@ -315,17 +1499,11 @@ int main(int argc, char* argv[]) {
             std::this_thread::sleep_for(std::chrono::seconds(2));
             demonstrateTCPCommunication();
         } else {
-            std::cout << "Usage: " << argv[0] << " [server|client|demo]" << std::endl;
-            std::cout << "  server - Run as TCP server" << std::endl;
-            std::cout << "  client - Run as interactive TCP client" << std::endl;
-            std::cout << "  demo   - Run automated demonstration (requires server running)" << std::endl;
+            printUsage(argv[0]);
             return 1;
         }
     } else {
-        std::cout << "Usage: " << argv[0] << " [server|client|demo]" << std::endl;
-        std::cout << "  server - Run as TCP server" << std::endl;
-        std::cout << "  client - Run as interactive TCP client" << std::endl;
-        std::cout << "  demo   - Run automated demonstration (requires server running)" << std::endl;
+        printUsage(argv[0]);
         return 1;
     }
     
@@ -336,10 +1514,12 @@ int main(int argc, char* argv[]) {
 COMPILATION AND USAGE:
 
 1. Compile the program:
-   g++ -std=c++11 -o tcp_program tcp_client_server.cpp -pthread
+   g++ -std=c++17 -O2 -o tcp_program tcp_client_server.cpp -pthread
+   (-std=c++20 adds the coroutine server, coro-server and bench-idle)
 
 2. Run the server (in one terminal):
-   ./tcp_program server
+   ./tcp_program server            (epoll reactor)
+   ./tcp_program threaded-server   (one thread per connection)
 
 3. Run the client (in another terminal):
    ./tcp_program client
@@ -347,6 +1527,12 @@ COMPILATION AND USAGE:
 4. Or run the automated demo:
    ./tcp_program demo
 
+5. Compare the servers under many concurrent connections:
+   ./tcp_program bench 1000 200
+
+6. Hold many idle coroutine sessions on one reactor thread (C++20):
+   ./tcp_program bench-idle 5000
+
 KEY CONCEPTS DEMONSTRATED:
 
 1. Socket Creation:
@@ -373,8 +1559,17 @@ KEY CONCEPTS DEMONSTRATED:
    - Flow control and congestion control
 
 5. Advanced Features:
-   - Multi-threaded server for concurrent client handling
+   - Thread-per-connection baseline (ThreadedTCPServer)
+   - epoll reactor (TCPServer): N loop threads, one SO_REUSEPORT listener each
+   - Non-blocking sockets with edge-triggered events, drained until EAGAIN
+   - Per-connection read/write buffers and high/low water mark backpressure
+   - C++20 coroutine server (CoroutineTCPServer): session_task sessions,
+     async_accept/async_read/async_write awaitables resumed by an epoll
+     reactor, session frames recycled through per-thread free lists,
+     accepts retried on a timer when the process is out of fds
    - Signal handling for graceful shutdown
+   - Per-loop relaxed atomic counters: bytes, backpressure pauses and time
+     per epoll batch, summed by stats()
    - Socket options (SO_REUSEADDR)
    - Connection state management
 
@@ -385,7 +1580,10 @@ KEY CONCEPTS DEMONSTRATED:
    - Resource cleanup
 
 7. Practical Considerations:
-   - Thread management for concurrent connections
+   - Thread-per-connection costs a stack and context switches per client;
+     a reactor's cost is per event, so it scales to thousands of sockets
+   - Edge-triggered fds must be drained fully or events are lost
+   - Raise RLIMIT_NOFILE for large connection counts
    - Proper connection lifecycle management
    - Graceful shutdown procedures
    - Address reuse configuration
@@ -4,6 +4,17 @@
 #include <memory>
 #include <typeinfo>
 #include <stdexcept>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <type_traits>
+#include <variant>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 // Abstract base class for polymorphism demonstration
 class Shape {
@@ -484,6 +495,26 @@ void demonstrateCompileTimePolymorphism() {
     std::cout << std::endl;
 }
 
+// Data-oriented shapes: the same three kinds as plain parameter records.
+// ShapeRecord is the array-of-structures form, one variant per shape
+// with no heap allocation and no vtable. ShapeBatch is the
+// structure-of-arrays form: each parameter lives in its own contiguous
+// array, so a kernel streams through memory and processes several shapes
+// per instruction.
+struct CircleParams {
+    double radius;
+};
+
+struct RectangleParams {
+    double width, height;
+};
+
+struct TriangleParams {
+    double side1, side2, side3;
+};
+
+using ShapeRecord = std::variant<CircleParams, RectangleParams, TriangleParams>;
+
 // Polymorphic factory pattern
 class ShapeFactory {
 public:
@@ -501,6 +532,20 @@ public:
                 throw std::invalid_argument("Unknown shape type");
         }
     }
+    
+    // The same defaults as plain records, for ShapeBatch
+    static ShapeRecord createRecord(ShapeType type) {
+        switch (type) {
+            case ShapeType::CIRCLE:
+                return CircleParams{1.0};
+            case ShapeType::RECTANGLE:
+                return RectangleParams{2.0, 3.0};
+            case ShapeType::TRIANGLE:
+                return TriangleParams{3.0, 4.0, 5.0};
+            default:
+                throw std::invalid_argument("Unknown shape type");
+        }
+    }
 };
 
 void demonstratePolymorphicFactory() {
@@ -521,6 +566,336 @@ void demonstratePolymorphicFactory() {
     }
 }
 
+constexpr double kShapePi = 3.14159;  // Same value as Circle::PI, so both paths agree
+
+double area(const ShapeRecord& record) {
+    return std::visit([](const auto& s) -> double {
+        using T = std::decay_t<decltype(s)>;
+        if constexpr (std::is_same_v<T, CircleParams>) {
+            return kShapePi * s.radius * s.radius;
+        } else if constexpr (std::is_same_v<T, RectangleParams>) {
+            return s.width * s.height;
+        } else {
+            double p = (s.side1 + s.side2 + s.side3) / 2;
+            return std::sqrt(p * (p - s.side1) * (p - s.side2) * (p - s.side3));
+        }
+    }, record);
+}
+
+double perimeter(const ShapeRecord& record) {
+    return std::visit([](const auto& s) -> double {
+        using T = std::decay_t<decltype(s)>;
+        if constexpr (std::is_same_v<T, CircleParams>) {
+            return 2 * kShapePi * s.radius;
+        } else if constexpr (std::is_same_v<T, RectangleParams>) {
+            return 2 * (s.width + s.height);
+        } else {
+            return s.side1 + s.side2 + s.side3;
+        }
+    }, record);
+}
+
+// Bridge back to the virtual hierarchy
+std::unique_ptr<Shape> toShape(const ShapeRecord& record) {
+    return std::visit([](const auto& s) -> std::unique_ptr<Shape> {
+        using T = std::decay_t<decltype(s)>;
+        if constexpr (std::is_same_v<T, CircleParams>) {
+            return std::make_unique<Circle>(s.radius);
+        } else if constexpr (std::is_same_v<T, RectangleParams>) {
+            return std::make_unique<Rectangle>(s.width, s.height);
+        } else {
+            return std::make_unique<Triangle>(s.side1, s.side2, s.side3);
+        }
+    }, record);
+}
+
+// The batch kernels below are written against Lanes, a GCC/Clang vector
+// of doubles as wide as the build allows: 2 with SSE2, 4 with -mavx, 8
+// with -mavx512f. A ShapeBatch column is a std::vector<double>, only
+// 8-byte aligned, so Lanes is declared with that alignment (and
+// may_alias), and a kernel reads or writes a run of a column in place
+// through lanesAt() instead of copying it in and out.
+#if defined(__AVX512F__)
+constexpr size_t kShapeLaneBytes = 64;
+#elif defined(__AVX__)
+constexpr size_t kShapeLaneBytes = 32;
+#else
+constexpr size_t kShapeLaneBytes = 16;
+#endif
+typedef double Lanes __attribute__((vector_size(kShapeLaneBytes), aligned(alignof(double)), may_alias));
+constexpr size_t kShapeLanes = kShapeLaneBytes / sizeof(double);
+
+inline const Lanes& lanesAt(const double* p) { return *reinterpret_cast<const Lanes*>(p); }
+inline Lanes& lanesAt(double* p) { return *reinterpret_cast<Lanes*>(p); }
+
+// Heron's formula is the one kernel that needs more than + - * /
+inline Lanes sqrtLanes(Lanes v) {
+#if defined(__AVX512F__)
+    // Full-mask form: GCC 12 warns about the unmasked one's pass-through operand
+    return reinterpret_cast<Lanes>(_mm512_maskz_sqrt_pd(0xFF, reinterpret_cast<__m512d>(v)));
+#elif defined(__AVX__)
+    return reinterpret_cast<Lanes>(_mm256_sqrt_pd(reinterpret_cast<__m256d>(v)));
+#elif defined(__SSE2__)
+    return reinterpret_cast<Lanes>(_mm_sqrt_pd(reinterpret_cast<__m128d>(v)));
+#else
+    for (size_t lane = 0; lane < kShapeLanes; ++lane) v[lane] = std::sqrt(v[lane]);
+    return v;
+#endif
+}
+
+// Calls `wide` for each full group of kShapeLanes shapes in [0, n), then
+// `single` for the leftover shapes
+template<typename WideOp, typename SingleOp>
+void forEachShape(size_t n, WideOp wide, SingleOp single) {
+    size_t i = 0;
+    for (; i + kShapeLanes <= n; i += kShapeLanes) wide(i);
+    for (; i < n; ++i) single(i);
+}
+
+class ShapeBatch {
+private:
+    std::vector<double> radii_;
+    std::vector<double> widths_, heights_;
+    std::vector<double> sides1_, sides2_, sides3_;
+
+public:
+    void reserve(size_t circles, size_t rectangles, size_t triangles) {
+        radii_.reserve(circles);
+        widths_.reserve(rectangles);
+        heights_.reserve(rectangles);
+        sides1_.reserve(triangles);
+        sides2_.reserve(triangles);
+        sides3_.reserve(triangles);
+    }
+
+    void addCircle(double radius) { radii_.push_back(radius); }
+
+    void addRectangle(double width, double height) {
+        widths_.push_back(width);
+        heights_.push_back(height);
+    }
+
+    void addTriangle(double side1, double side2, double side3) {
+        sides1_.push_back(side1);
+        sides2_.push_back(side2);
+        sides3_.push_back(side3);
+    }
+
+    void add(const ShapeRecord& record) {
+        std::visit([this](const auto& s) {
+            using T = std::decay_t<decltype(s)>;
+            if constexpr (std::is_same_v<T, CircleParams>) {
+                addCircle(s.radius);
+            } else if constexpr (std::is_same_v<T, RectangleParams>) {
+                addRectangle(s.width, s.height);
+            } else {
+                addTriangle(s.side1, s.side2, s.side3);
+            }
+        }, record);
+    }
+
+    static ShapeBatch fromRecords(const std::vector<ShapeRecord>& records) {
+        size_t counts[3] = {};
+        for (const auto& record : records) ++counts[record.index()];
+        ShapeBatch batch;
+        batch.reserve(counts[0], counts[1], counts[2]);
+        for (const auto& record : records) batch.add(record);
+        return batch;
+    }
+
+    // Shapes come back grouped by kind, in batch order
+    std::vector<ShapeRecord> toRecords() const {
+        std::vector<ShapeRecord> records;
+        records.reserve(size());
+        for (double r : radii_) records.push_back(CircleParams{r});
+        for (size_t i = 0; i < widths_.size(); ++i) records.push_back(RectangleParams{widths_[i], heights_[i]});
+        for (size_t i = 0; i < sides1_.size(); ++i) {
+            records.push_back(TriangleParams{sides1_[i], sides2_[i], sides3_[i]});
+        }
+        return records;
+    }
+
+    size_t circleCount() const { return radii_.size(); }
+    size_t rectangleCount() const { return widths_.size(); }
+    size_t triangleCount() const { return sides1_.size(); }
+    size_t size() const { return circleCount() + rectangleCount() + triangleCount(); }
+
+    size_t memoryBytes() const {
+        return sizeof(double) * (radii_.capacity() + widths_.capacity() + heights_.capacity() +
+                                 sides1_.capacity() + sides2_.capacity() + sides3_.capacity());
+    }
+
+    // Batch order: every circle, then every rectangle, then every
+    // triangle. `out` must hold size() doubles.
+    void areas(double* out) const {
+        const double* r = radii_.data();
+        forEachShape(circleCount(),
+                      [&](size_t i) { lanesAt(out + i) = kShapePi * lanesAt(r + i) * lanesAt(r + i); },
+                      [&](size_t i) { out[i] = kShapePi * r[i] * r[i]; });
+        out += circleCount();
+
+        const double* w = widths_.data();
+        const double* h = heights_.data();
+        forEachShape(rectangleCount(),
+                      [&](size_t i) { lanesAt(out + i) = lanesAt(w + i) * lanesAt(h + i); },
+                      [&](size_t i) { out[i] = w[i] * h[i]; });
+        out += rectangleCount();
+
+        // Heron's formula
+        const double* a = sides1_.data();
+        const double* b = sides2_.data();
+        const double* c = sides3_.data();
+        forEachShape(triangleCount(),
+                      [&](size_t i) {
+                          const Lanes &la = lanesAt(a + i), &lb = lanesAt(b + i), &lc = lanesAt(c + i);
+                          Lanes s = (la + lb + lc) / 2;
+                          lanesAt(out + i) = sqrtLanes(s * (s - la) * (s - lb) * (s - lc));
+                      },
+                      [&](size_t i) {
+                          double s = (a[i] + b[i] + c[i]) / 2;
+                          out[i] = std::sqrt(s * (s - a[i]) * (s - b[i]) * (s - c[i]));
+                      });
+    }
+
+    void perimeters(double* out) const {
+        const double* r = radii_.data();
+        forEachShape(circleCount(),
+                      [&](size_t i) { lanesAt(out + i) = 2 * kShapePi * lanesAt(r + i); },
+                      [&](size_t i) { out[i] = 2 * kShapePi * r[i]; });
+        out += circleCount();
+
+        const double* w = widths_.data();
+        const double* h = heights_.data();
+        forEachShape(rectangleCount(),
+                      [&](size_t i) { lanesAt(out + i) = 2 * (lanesAt(w + i) + lanesAt(h + i)); },
+                      [&](size_t i) { out[i] = 2 * (w[i] + h[i]); });
+        out += rectangleCount();
+
+        const double* a = sides1_.data();
+        const double* b = sides2_.data();
+        const double* c = sides3_.data();
+        forEachShape(triangleCount(),
+                      [&](size_t i) { lanesAt(out + i) = lanesAt(a + i) + lanesAt(b + i) + lanesAt(c + i); },
+                      [&](size_t i) { out[i] = a[i] + b[i] + c[i]; });
+    }
+
+    std::vector<double> areas() const {
+        std::vector<double> out(size());
+        areas(out.data());
+        return out;
+    }
+
+    std::vector<double> perimeters() const {
+        std::vector<double> out(size());
+        perimeters(out.data());
+        return out;
+    }
+};
+
+void demonstrateShapeBatch() {
+    std::cout << "=== Structure-of-Arrays Shape Batch ===\n\n";
+    
+    std::vector<ShapeRecord> records = {
+        CircleParams{5.0}, RectangleParams{4.0, 6.0}, TriangleParams{3.0, 4.0, 5.0}, CircleParams{2.5},
+        ShapeFactory::createRecord(ShapeFactory::ShapeType::RECTANGLE),
+    };
+    ShapeBatch batch = ShapeBatch::fromRecords(records);
+    auto areas = batch.areas();
+    auto perimeters = batch.perimeters();
+    auto grouped = batch.toRecords();
+    
+    std::cout << batch.circleCount() << " circles, " << batch.rectangleCount() << " rectangles, "
+              << batch.triangleCount() << " triangles (batch order groups them by kind):\n";
+    for (size_t i = 0; i < grouped.size(); ++i) {
+        auto shape = toShape(grouped[i]);
+        std::cout << "  " << shape->getName() << ": area " << areas[i] << " (virtual " << shape->area()
+                  << "), perimeter " << perimeters[i] << " (virtual " << shape->perimeter() << ")\n";
+    }
+    std::cout << std::endl;
+}
+
+void demonstrateShapeBatchPerformance() {
+    std::cout << "=== Virtual vs Variant vs SoA Shape Kernels ===\n\n";
+    constexpr size_t count = 1 << 20;
+    constexpr int runs = 5;
+    
+    // Records arrive with kinds mixed, as they would from a parser
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> kind(0, 2);
+    std::uniform_real_distribution<double> length(1.0, 10.0);
+    std::vector<ShapeRecord> records;
+    records.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        switch (kind(gen)) {
+            case 0: records.push_back(CircleParams{length(gen)}); break;
+            case 1: records.push_back(RectangleParams{length(gen), length(gen)}); break;
+            default: {
+                double a = length(gen), b = length(gen);
+                records.push_back(TriangleParams{a, b, std::max(a, b)});  // Always a valid triangle
+                break;
+            }
+        }
+    }
+    
+    std::vector<std::unique_ptr<Shape>> shapes;
+    shapes.reserve(count);
+    for (const auto& record : records) shapes.push_back(toShape(record));
+    ShapeBatch batch = ShapeBatch::fromRecords(records);
+    std::vector<double> outAreas(count), outPerimeters(count);
+    
+    auto best = [&](const auto& body) {
+        double ms = 1e300;
+        for (int r = 0; r < runs; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            body();
+            ms = std::min(ms, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        return ms;
+    };
+    auto total = [&] {
+        double sum = 0;
+        for (double a : outAreas) sum += a;
+        return sum;
+    };
+    
+    double virtualMs = best([&] {
+        for (size_t i = 0; i < count; ++i) {
+            outAreas[i] = shapes[i]->area();
+            outPerimeters[i] = shapes[i]->perimeter();
+        }
+    });
+    double virtualTotal = total();
+    double variantMs = best([&] {
+        for (size_t i = 0; i < count; ++i) {
+            outAreas[i] = area(records[i]);
+            outPerimeters[i] = perimeter(records[i]);
+        }
+    });
+    double variantTotal = total();
+    double soaMs = best([&] {
+        batch.areas(outAreas.data());
+        batch.perimeters(outPerimeters.data());
+    });
+    double soaTotal = total();
+    
+    // Heap estimate: the object plus a 16-byte allocator header, plus the owning pointer
+    size_t virtualBytes = 0;
+    for (const auto& record : records) {
+        size_t object = record.index() == 0 ? sizeof(Circle) : record.index() == 1 ? sizeof(Rectangle) : sizeof(Triangle);
+        virtualBytes += object + 16 + sizeof(std::unique_ptr<Shape>);
+    }
+    
+    std::printf("%zu shapes, area + perimeter, %zu doubles per SIMD op, best of %d\n", count, kShapeLanes, runs);
+    std::printf("  %-34s %8.2f ms %6.2f ns/shape %5.1f B/shape\n", "vector<unique_ptr<Shape>> virtual",
+                virtualMs, virtualMs * 1e6 / count, double(virtualBytes) / count);
+    std::printf("  %-34s %8.2f ms %6.2f ns/shape %5.1f B/shape\n", "vector<variant> + std::visit",
+                variantMs, variantMs * 1e6 / count, double(sizeof(ShapeRecord)));
+    std::printf("  %-34s %8.2f ms %6.2f ns/shape %5.1f B/shape\n", "ShapeBatch SoA kernels",
+                soaMs, soaMs * 1e6 / count, double(batch.memoryBytes()) / count);
+    std::printf("  SoA speedup over virtual: %.1fx; total area %.6e / %.6e / %.6e\n\n", virtualMs / soaMs,
+                virtualTotal, variantTotal, soaTotal);
+}
+
 int main() {
     demonstrateBasicPolymorphism();
     demonstrateAnimalPolymorphism();
@@ -529,6 +904,8 @@ int main() {
     demonstrateVirtualFunctionPerformance();
     demonstrateCompileTimePolymorphism();
     demonstratePolymorphicFactory();
+    demonstrateShapeBatch();
+    demonstrateShapeBatchPerformance();
     
     std::cout << "=== Key Polymorphism Concepts ===\n";
     std::cout << "1. Runtime polymorphism through virtual functions\n";
@@ -539,6 +916,7 @@ int main() {
     std::cout << "6. Compile-time polymorphism through templates\n";
     std::cout << "7. Factory pattern for polymorphic object creation\n";
     std::cout << "8. Performance considerations of virtual calls\n";
+    std::cout << "9. Structure-of-arrays batches for bulk work on millions of objects\n";
     
     return 0;
 }
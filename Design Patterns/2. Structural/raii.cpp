@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 #include <chrono>
+#include <mutex>
+#include <thread>
 
 // RAII Demonstration - Resource Acquisition Is Initialization
 
@@ -52,9 +54,17 @@ public:
         return *this;
     }
     
+    // Buffered: std::endl or flush() per line would cost one write() syscall
+    // per line. The destructor's close() flushes whatever is left.
     void write(const std::string& data) {
         if (file_.is_open()) {
-            file_ << data << std::endl;
+            file_ << data << '\n';
+        }
+    }
+
+    // For callers that need the data visible to other readers now
+    void flush() {
+        if (file_.is_open()) {
             file_.flush();
         }
     }
@@ -117,19 +127,22 @@ public:
 };
 
 // 4. Custom RAII Timer for Performance Measurement
+// steady_clock, not high_resolution_clock: the latter may be the wall clock,
+// which jumps when NTP adjusts it. For repeatable numbers use a benchmark
+// harness (warmup, many runs, median), as in the Multithreading benchmarks.
 class ScopedTimer {
 private:
     std::string name_;
-    std::chrono::high_resolution_clock::time_point start_;
+    std::chrono::steady_clock::time_point start_;
 
 public:
     explicit ScopedTimer(const std::string& name) 
-        : name_(name), start_(std::chrono::high_resolution_clock::now()) {
+        : name_(name), start_(std::chrono::steady_clock::now()) {
         std::cout << "Timer started: " << name_ << std::endl;
     }
     
     ~ScopedTimer() {
-        auto end = std::chrono::high_resolution_clock::now();
+        auto end = std::chrono::steady_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start_);
         std::cout << "Timer finished: " << name_ 
                   << " (Duration: " << duration.count() << " microseconds)" << std::endl;
@@ -4,6 +4,19 @@
 #include <algorithm>
 #include <string>
 #include <functional>
+#include <deque>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <utility>
 
 // Forward declaration
 class Observer;
@@ -25,77 +38,382 @@ public:
     virtual std::string getName() const = 0;
 };
 
+// Price and previous price always change together
+struct PriceSnapshot {
+    double price;
+    double previousPrice;
+};
+
+// Sequence lock for the quote: readers copy both prices without writing
+// shared memory, and retry if a write overlapped. The writer makes the
+// sequence odd, stores, then makes it even again. This is SeqLock<T> from
+// 02_mutex_synchronization.cpp cut down to the one value Stock keeps; the
+// demo files build on their own, so the primitive is not shared.
+class QuoteSeqLock {
+    std::atomic<uint64_t> sequence_{0};
+    std::atomic<double> price_;
+    std::atomic<double> previousPrice_;
+
+public:
+    explicit QuoteSeqLock(const PriceSnapshot& initial)
+        : price_(initial.price), previousPrice_(initial.previousPrice) {}
+
+    // Single writer (the thread that owns the subject)
+    void store(const PriceSnapshot& value) {
+        uint64_t seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        price_.store(value.price, std::memory_order_relaxed);
+        previousPrice_.store(value.previousPrice, std::memory_order_relaxed);
+        sequence_.store(seq + 2, std::memory_order_release);
+    }
+
+    PriceSnapshot load() const {
+        for (;;) {
+            uint64_t before = sequence_.load(std::memory_order_acquire);
+            if (before & 1) continue;
+            PriceSnapshot value{price_.load(std::memory_order_relaxed),
+                                previousPrice_.load(std::memory_order_relaxed)};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == before) return value;
+        }
+    }
+};
+
+// Subscriber registry built for large fan-out. notify() used to walk a
+// vector<weak_ptr> and lock() every entry: two atomic read-modify-writes
+// per observer per tick, plus erasing dead entries from the middle.
+// - Writers (subscribe/unsubscribe, any thread) edit a dense array under a
+//   mutex. Removal is swap-and-pop through an id -> index map, so it is O(1)
+// - Readers never see that array. They get an immutable snapshot, published
+//   copy-on-write: changes only mark it stale, and the next snapshot() call
+//   rebuilds it once, however many subscriptions changed in between
+// - The registry itself keeps only weak references, so subscribing never
+//   extends an observer's life. Each rebuild locks every entry once and
+//   drops the ones that expired without unsubscribing
+// - A snapshot holds the strong references it locked, so an observer lives
+//   until the last notification that can reach it has finished (RCU-style
+//   deferred reclamation). That includes the published snapshot: an
+//   observer released without unsubscribing is freed at the next rebuild.
+//   A notify costs one atomic shared_ptr load, not one per observer, and
+//   then walks a contiguous array of raw pointers.
+class ObserverRegistry {
+public:
+    struct Snapshot {
+        std::vector<Observer*> observers;                 // Walked by notify
+        std::vector<std::shared_ptr<Observer>> owners;    // Locked at rebuild; keeps them alive
+    };
+
+    uint64_t add(std::shared_ptr<Observer> observer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t id = nextId_++;
+        index_[id] = ids_.size();
+        ids_.push_back(id);
+        entries_.push_back(std::move(observer));
+        markStale();
+        return id;
+    }
+
+    bool remove(uint64_t id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(id);
+        if (it == index_.end()) return false;
+        eraseSlot(it->second);
+        markStale();
+        return true;
+    }
+
+    // Notifications already running on an older snapshot still reach an
+    // observer that was just removed; new ones do not
+    std::shared_ptr<const Snapshot> snapshot() {
+        if (stale_.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stale_.load(std::memory_order_relaxed)) {
+                auto fresh = std::make_shared<Snapshot>();
+                fresh->owners.reserve(entries_.size());
+                fresh->observers.reserve(entries_.size());
+                for (size_t slot = 0; slot < entries_.size();) {
+                    if (auto owner = entries_[slot].lock()) {
+                        fresh->observers.push_back(owner.get());
+                        fresh->owners.push_back(std::move(owner));
+                        ++slot;
+                    } else {
+                        eraseSlot(slot);  // Expired without unsubscribing; the last entry moves here
+                    }
+                }
+                size_.store(ids_.size(), std::memory_order_relaxed);
+                std::atomic_store_explicit(&published_, std::shared_ptr<const Snapshot>(std::move(fresh)),
+                                           std::memory_order_release);
+                stale_.store(false, std::memory_order_relaxed);
+            }
+        }
+        return std::atomic_load_explicit(&published_, std::memory_order_acquire);
+    }
+
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+private:
+    // Swap-and-pop; the caller holds mutex_
+    void eraseSlot(size_t slot) {
+        size_t last = ids_.size() - 1;
+        index_.erase(ids_[slot]);
+        if (slot != last) {
+            ids_[slot] = ids_[last];
+            entries_[slot] = std::move(entries_[last]);
+            index_[ids_[slot]] = slot;
+        }
+        ids_.pop_back();
+        entries_.pop_back();
+    }
+
+    void markStale() {
+        size_.store(ids_.size(), std::memory_order_relaxed);
+        stale_.store(true, std::memory_order_release);
+    }
+
+    std::mutex mutex_;
+    std::vector<uint64_t> ids_;                           // Parallel to entries_
+    std::vector<std::weak_ptr<Observer>> entries_;
+    std::unordered_map<uint64_t, size_t> index_;          // id -> slot
+    uint64_t nextId_ = 1;
+    std::shared_ptr<const Snapshot> published_ = std::make_shared<Snapshot>();
+    std::atomic<bool> stale_{false};
+    std::atomic<size_t> size_{0};
+};
+
+// Move-only subscription token. Destroying it (or calling reset) ends the
+// subscription; it is safe to outlive the subject.
+class Subscription {
+private:
+    std::weak_ptr<ObserverRegistry> registry_;
+    uint64_t id_ = 0;
+
+public:
+    Subscription() = default;
+    Subscription(std::weak_ptr<ObserverRegistry> registry, uint64_t id)
+        : registry_(std::move(registry)), id_(id) {}
+
+    Subscription(Subscription&& other) noexcept
+        : registry_(std::move(other.registry_)), id_(std::exchange(other.id_, 0)) {}
+
+    Subscription& operator=(Subscription&& other) noexcept {
+        if (this != &other) {
+            reset();
+            registry_ = std::move(other.registry_);
+            id_ = std::exchange(other.id_, 0);
+        }
+        return *this;
+    }
+
+    Subscription(const Subscription&) = delete;
+    Subscription& operator=(const Subscription&) = delete;
+
+    ~Subscription() { reset(); }
+
+    void reset() {
+        if (id_ != 0) {
+            if (auto registry = registry_.lock()) registry->remove(id_);
+            registry_.reset();
+            id_ = 0;
+        }
+    }
+
+    bool active() const { return id_ != 0 && !registry_.expired(); }
+};
+
+// Minimal fixed-size worker pool for asynchronous notification. The full
+// pool (typed queues, metrics, futures) is Multithreading/06_thread_pool.cpp.
+class NotificationPool {
+private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable workAvailable_;
+    std::condition_variable idle_;
+    size_t active_ = 0;
+    bool stop_ = false;
+
+public:
+    explicit NotificationPool(size_t threads) {
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this] {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        workAvailable_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                        if (stop_ && tasks_.empty()) return;
+                        task = std::move(tasks_.front());
+                        tasks_.pop_front();
+                        ++active_;
+                    }
+                    task();
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (--active_ == 0 && tasks_.empty()) idle_.notify_all();
+                }
+            });
+        }
+    }
+
+    ~NotificationPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        workAvailable_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        workAvailable_.notify_one();
+    }
+
+    // Returns once every submitted task, and everything they submitted, has run
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return tasks_.empty() && active_ == 0; });
+    }
+};
+
 // Concrete Subject - Stock Price Monitor
 class Stock : public Subject {
 private:
-    std::vector<std::weak_ptr<Observer>> observers_;
+    std::shared_ptr<ObserverRegistry> observers_ = std::make_shared<ObserverRegistry>();
+    // Tokens for observers added through attach(); owner thread only
+    std::vector<std::pair<Observer*, Subscription>> attached_;
     std::string symbol_;
-    double price_;
-    double previousPrice_;
+    // Pull-model readers (dashboards, risk checks) may poll from other
+    // threads; they get a consistent pair without taking a lock
+    QuoteSeqLock quote_;
+
+    // Asynchronous dispatch (see dispatchOn)
+    NotificationPool* pool_ = nullptr;
+    size_t batchSize_ = 256;
+    std::atomic<uint64_t> ticks_{0};
+    std::atomic<bool> roundScheduled_{false};
+    std::atomic<uint64_t> rounds_{0};
 
 public:
     explicit Stock(const std::string& symbol, double initialPrice = 0.0)
-        : symbol_(symbol), price_(initialPrice), previousPrice_(initialPrice) {}
+        : symbol_(symbol), quote_(PriceSnapshot{initialPrice, initialPrice}) {}
+
+    // Thread-safe. The observer receives notifications until the token is
+    // destroyed or reset, or until the caller's last reference to it goes;
+    // the subject does not keep it alive.
+    [[nodiscard]] Subscription subscribe(std::shared_ptr<Observer> observer) {
+        uint64_t id = observers_->add(std::move(observer));
+        return Subscription(observers_, id);
+    }
 
     void attach(std::shared_ptr<Observer> observer) override {
-        observers_.push_back(observer);
+        attached_.emplace_back(observer.get(), subscribe(observer));
         std::cout << "Attached observer: " << observer->getName() 
                   << " to stock: " << symbol_ << std::endl;
     }
 
     void detach(std::shared_ptr<Observer> observer) override {
-        observers_.erase(
-            std::remove_if(observers_.begin(), observers_.end(),
-                [&observer](const std::weak_ptr<Observer>& weak_obs) {
-                    auto shared_obs = weak_obs.lock();
-                    return !shared_obs || shared_obs == observer;
-                }),
-            observers_.end());
+        attached_.erase(
+            std::remove_if(attached_.begin(), attached_.end(),
+                [&observer](const auto& entry) { return entry.first == observer.get(); }),
+            attached_.end());
         std::cout << "Detached observer: " << observer->getName() 
                   << " from stock: " << symbol_ << std::endl;
     }
 
     void notify() override {
+        PriceSnapshot quote = quote_.load();
         std::cout << "\nNotifying observers of " << symbol_ 
-                  << " price change: $" << previousPrice_ 
-                  << " -> $" << price_ << std::endl;
+                  << " price change: $" << quote.previousPrice 
+                  << " -> $" << quote.price << std::endl;
         
-        // Clean up expired weak_ptrs and notify valid observers
-        auto it = observers_.begin();
-        while (it != observers_.end()) {
-            if (auto observer = it->lock()) {
-                observer->update(this);
-                ++it;
-            } else {
-                it = observers_.erase(it);  // Remove expired weak_ptr
-            }
+        auto snapshot = observers_->snapshot();
+        for (Observer* observer : snapshot->observers) {
+            observer->update(this);
         }
     }
 
+    // From now on setPrice() returns immediately and notifications run on
+    // `pool`, `batchSize` observers per task. One round runs at a time per
+    // stock, and a round delivers the latest price: ticks that arrive while
+    // one is in flight are coalesced into a single follow-up round.
+    // Observers must be thread-safe (batches run in parallel, and other
+    // stocks may notify them concurrently). Call pool.waitIdle() before
+    // destroying the stock.
+    void dispatchOn(NotificationPool& pool, size_t batchSize = 256) {
+        pool_ = &pool;
+        batchSize_ = std::max<size_t>(batchSize, 1);
+    }
+
     void setPrice(double newPrice) {
-        if (newPrice != price_) {
-            previousPrice_ = price_;
-            price_ = newPrice;
-            notify();
+        double price = quote_.load().price;
+        if (newPrice != price) {
+            quote_.store(PriceSnapshot{newPrice, price});
+            if (pool_) {
+                ticks_.fetch_add(1);
+                if (!roundScheduled_.exchange(true)) startRound();
+            } else {
+                notify();
+            }
         }
     }
 
     // Getters
     const std::string& getSymbol() const { return symbol_; }
-    double getPrice() const { return price_; }
-    double getPreviousPrice() const { return previousPrice_; }
-    double getPriceChange() const { return price_ - previousPrice_; }
+    PriceSnapshot getQuote() const { return quote_.load(); }
+    double getPrice() const { return quote_.load().price; }
+    double getPreviousPrice() const { return quote_.load().previousPrice; }
+    double getPriceChange() const {
+        PriceSnapshot quote = quote_.load();
+        return quote.price - quote.previousPrice;
+    }
     double getPriceChangePercent() const { 
-        return previousPrice_ != 0 ? (getPriceChange() / previousPrice_) * 100 : 0; 
+        PriceSnapshot quote = quote_.load();
+        return quote.previousPrice != 0 ? ((quote.price - quote.previousPrice) / quote.previousPrice) * 100 : 0; 
     }
     
-    size_t getObserverCount() const {
-        // Count valid observers
-        size_t count = 0;
-        for (const auto& weak_obs : observers_) {
-            if (weak_obs.lock()) ++count;
+    size_t getObserverCount() const { return observers_->size(); }
+    uint64_t getTickCount() const { return ticks_.load(std::memory_order_relaxed); }
+    uint64_t getRoundCount() const { return rounds_.load(std::memory_order_relaxed); }
+
+private:
+    void startRound() {
+        uint64_t seen = ticks_.load(std::memory_order_acquire);
+        rounds_.fetch_add(1, std::memory_order_relaxed);
+        auto snapshot = observers_->snapshot();
+        size_t count = snapshot->observers.size();
+        if (count == 0) {
+            finishRound(seen);
+            return;
+        }
+        size_t batches = (count + batchSize_ - 1) / batchSize_;
+        auto remaining = std::make_shared<std::atomic<size_t>>(batches);
+        for (size_t begin = 0; begin < count; begin += batchSize_) {
+            size_t end = std::min(begin + batchSize_, count);
+            pool_->submit([this, snapshot, remaining, seen, begin, end] {
+                for (size_t i = begin; i < end; ++i) snapshot->observers[i]->update(this);
+                if (remaining->fetch_sub(1, std::memory_order_acq_rel) == 1) finishRound(seen);
+            });
+        }
+    }
+
+    // Runs on whichever batch finished last
+    void finishRound(uint64_t seen) {
+        if (ticks_.load(std::memory_order_acquire) != seen) {
+            startRound();  // Prices moved during the round: deliver the latest one
+            return;
+        }
+        // A tick that landed between the check and the store saw a round
+        // still scheduled and left it to us. This is a store followed by a
+        // load on another variable, the one pattern acquire/release does
+        // not order, so these operations (and setPrice's) are seq_cst.
+        roundScheduled_.store(false);
+        if (ticks_.load() != seen && !roundScheduled_.exchange(true)) {
+            startRound();
         }
-        return count;
     }
 };
 
@@ -396,7 +714,8 @@ void demonstrateObserverLifecycle() {
         auto tempAlgorithm = std::make_shared<TradingAlgorithm>("ScalpBot", 2.0, -1.5);
         
         stock->attach(tempInvestor);
-        stock->attach(tempAlgorithm);
+        // The token, not the subject, owns this subscription
+        Subscription algorithmSubscription = stock->subscribe(tempAlgorithm);
         
         std::cout << "Observers attached. Count: " << stock->getObserverCount() << std::endl;
         
@@ -408,7 +727,7 @@ void demonstrateObserverLifecycle() {
         
         stock->setPrice(195.0);  // Only algorithm should be notified
         
-    }  // Observers go out of scope here
+    }  // The token and the observers go out of scope here
     
     std::cout << "\nAfter observers went out of scope:" << std::endl;
     std::cout << "Observer count: " << stock->getObserverCount() << std::endl;
@@ -416,6 +735,284 @@ void demonstrateObserverLifecycle() {
     stock->setPrice(180.0);  // Should have no observers to notify
 }
 
+// Fan-out to many remote subscribers. The update is encoded once, and every
+// subscriber queue holds a pointer to the same immutable bytes. Each queue
+// is bounded. A subscriber that falls behind gets only the latest update per
+// symbol (coalescing); if its queue is still full, the oldest update is
+// dropped. WebSocketBroadcastHub in Concepts/Networking/web_socket.cpp
+// applies the same design to real sockets.
+class SubscriberQueue {
+private:
+    struct Entry {
+        std::string symbol;
+        std::shared_ptr<const std::string> message;
+    };
+
+    std::string name_;
+    size_t capacity_;
+    size_t coalesceAt_;
+    std::deque<Entry> queue_;
+    size_t delivered_ = 0;
+    size_t coalesced_ = 0;
+    size_t dropped_ = 0;
+
+public:
+    SubscriberQueue(const std::string& name, size_t capacity, size_t coalesceAt)
+        : name_(name), capacity_(capacity), coalesceAt_(coalesceAt) {}
+
+    void push(const std::string& symbol, std::shared_ptr<const std::string> message) {
+        if (queue_.size() >= coalesceAt_) {
+            for (auto it = queue_.rbegin(); it != queue_.rend(); ++it) {
+                if (it->symbol == symbol) {
+                    it->message = std::move(message);  // Latest price replaces the stale one
+                    ++coalesced_;
+                    return;
+                }
+            }
+        }
+        if (queue_.size() >= capacity_) {
+            queue_.pop_front();
+            ++dropped_;
+        }
+        queue_.push_back({symbol, std::move(message)});
+    }
+
+    // The consumer reads at its own pace
+    void drain(size_t max) {
+        for (size_t i = 0; i < max && !queue_.empty(); ++i) {
+            queue_.pop_front();
+            ++delivered_;
+        }
+    }
+
+    void printStats() const {
+        std::cout << "  " << name_ << ": delivered " << delivered_ << ", queued " << queue_.size()
+                  << ", coalesced " << coalesced_ << ", dropped " << dropped_ << std::endl;
+    }
+};
+
+class MarketDataBroadcaster : public Observer {
+private:
+    std::vector<std::shared_ptr<SubscriberQueue>> subscribers_;
+    size_t encodes_ = 0;
+    size_t fanOut_ = 0;
+
+public:
+    void addSubscriber(std::shared_ptr<SubscriberQueue> subscriber) {
+        subscribers_.push_back(subscriber);
+    }
+
+    void update(Subject* subject) override {
+        if (auto stock = dynamic_cast<Stock*>(subject)) {
+            // Encode once, share everywhere
+            char text[96];
+            snprintf(text, sizeof(text), "{\"symbol\":\"%s\",\"price\":%.2f}",
+                     stock->getSymbol().c_str(), stock->getPrice());
+            auto message = std::make_shared<const std::string>(text);
+            ++encodes_;
+
+            for (auto& subscriber : subscribers_) {
+                subscriber->push(stock->getSymbol(), message);
+                ++fanOut_;
+            }
+        }
+    }
+
+    std::string getName() const override { return "MarketDataBroadcaster"; }
+    size_t getEncodes() const { return encodes_; }
+    size_t getFanOut() const { return fanOut_; }
+};
+
+void demonstrateBroadcastFanOut() {
+    std::cout << "\n=== Encode-Once Broadcast with Bounded Queues ===\n\n";
+
+    auto apple = std::make_unique<Stock>("AAPL", 150.0);
+    auto microsoft = std::make_unique<Stock>("MSFT", 300.0);
+    auto broadcaster = std::make_shared<MarketDataBroadcaster>();
+    apple->attach(broadcaster);
+    microsoft->attach(broadcaster);
+
+    // capacity 4, coalescing once 2 messages are waiting
+    auto fast = std::make_shared<SubscriberQueue>("fast client   ", 4, 2);
+    auto slow = std::make_shared<SubscriberQueue>("slow client   ", 4, 2);
+    auto stalled = std::make_shared<SubscriberQueue>("stalled client", 4, 2);
+    broadcaster->addSubscriber(fast);
+    broadcaster->addSubscriber(slow);
+    broadcaster->addSubscriber(stalled);
+
+    for (int tick = 1; tick <= 6; ++tick) {
+        apple->setPrice(150.0 + tick);
+        microsoft->setPrice(300.0 - tick);
+        fast->drain(10);                    // Keeps up
+        if (tick % 3 == 0) slow->drain(1);  // Falls behind
+    }                                       // stalled never reads
+
+    std::cout << "\nEncoded " << broadcaster->getEncodes() << " messages once each, shared by "
+              << broadcaster->getFanOut() << " queue entries" << std::endl;
+    fast->printStats();
+    slow->printStats();
+    stalled->printStats();
+}
+
+// Pull model across threads: pollers read the quote while the owning thread
+// keeps publishing. Every pair they see is one that setPrice stored.
+void demonstrateConcurrentQuoteReaders() {
+    std::cout << "\n--- Lock-Free Quote Readers (SeqLock) ---\n";
+
+    Stock stock("NVDA", 100.0);
+    std::atomic<bool> stop{false};
+    std::atomic<long> reads{0};
+    std::atomic<long> inconsistent{0};
+    std::vector<std::thread> pollers;
+    for (int i = 0; i < 4; ++i) {
+        pollers.emplace_back([&]() {
+            long local = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                PriceSnapshot quote = stock.getQuote();
+                // Prices step by +1, so the previous price is always one less
+                if (quote.price != 100.0 && quote.previousPrice != quote.price - 1.0) {
+                    inconsistent.fetch_add(1, std::memory_order_relaxed);
+                }
+                ++local;
+            }
+            reads.fetch_add(local);
+        });
+    }
+
+    for (int step = 1; step <= 5; ++step) {
+        stock.setPrice(100.0 + step);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    stop = true;
+    for (auto& poller : pollers) poller.join();
+
+    std::cout << "4 pollers made " << reads.load() << " reads, " << inconsistent.load()
+              << " inconsistent (expected 0), without writing shared memory" << std::endl;
+}
+
+// Cheap observer for fan-out measurements. The counter is atomic because
+// asynchronous rounds run batches on several threads.
+class CountingObserver : public Observer {
+private:
+    std::atomic<uint64_t> updates_{0};
+    std::atomic<double> lastPrice_{0.0};
+
+public:
+    void update(Subject* subject) override {
+        updates_.fetch_add(1, std::memory_order_relaxed);
+        if (auto stock = static_cast<Stock*>(subject)) {
+            lastPrice_.store(stock->getPrice(), std::memory_order_relaxed);
+        }
+    }
+
+    std::string getName() const override { return "CountingObserver"; }
+    uint64_t getUpdates() const { return updates_.load(std::memory_order_relaxed); }
+    double getLastPrice() const { return lastPrice_.load(std::memory_order_relaxed); }
+};
+
+// Per-observer cost of one notification: the old weak_ptr walk against a
+// snapshot walk, over the same observers
+void demonstrateLargeFanOut() {
+    std::cout << "\n=== Fan-Out to 10,000 Subscribers ===\n\n";
+    constexpr size_t kObservers = 10000;
+    constexpr int kNotifications = 200;
+
+    std::vector<std::shared_ptr<CountingObserver>> observers;
+    std::vector<std::weak_ptr<Observer>> weakList;
+    ObserverRegistry registry;
+    std::vector<uint64_t> ids;
+    for (size_t i = 0; i < kObservers; ++i) {
+        observers.push_back(std::make_shared<CountingObserver>());
+        weakList.push_back(observers.back());
+        ids.push_back(registry.add(observers.back()));
+    }
+
+    auto nsPerUpdate = [&](auto&& notifyOnce) {
+        auto start = std::chrono::steady_clock::now();
+        for (int n = 0; n < kNotifications; ++n) notifyOnce();
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+        return elapsed.count() / (kNotifications * kObservers);
+    };
+
+    double weakNs = nsPerUpdate([&] {
+        for (const auto& weak : weakList) {
+            if (auto observer = weak.lock()) observer->update(nullptr);
+        }
+    });
+    double snapshotNs = nsPerUpdate([&] {
+        auto snapshot = registry.snapshot();
+        for (Observer* observer : snapshot->observers) observer->update(nullptr);
+    });
+
+    // Unsubscribing half of them: O(1) swap-and-pop each, one rebuild after
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kObservers; i += 2) registry.remove(ids[i]);
+    size_t remaining = registry.snapshot()->observers.size();
+    double removeUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("weak_ptr::lock() per observer: %6.2f ns/update\n", weakNs);
+    std::printf("snapshot of raw pointers:      %6.2f ns/update\n", snapshotNs);
+    std::printf("%zu unsubscribes + one snapshot rebuild: %.0f us (%zu left)\n",
+                kObservers / 2, removeUs, remaining);
+}
+
+// Bursts of ticks on a stock dispatched to a pool, while another thread
+// keeps subscribing and unsubscribing. Rounds deliver the latest price, so
+// far fewer rounds than ticks run, and every observer ends on the final one.
+void demonstrateAsyncDispatch() {
+    std::cout << "\n=== Asynchronous Batched Dispatch with Coalescing ===\n\n";
+    constexpr size_t kObservers = 2000;
+    constexpr int kBursts = 20;
+    constexpr int kTicksPerBurst = 500;
+    constexpr int kTicks = kBursts * kTicksPerBurst;
+
+    NotificationPool pool(2);
+    Stock stock("AMD", 100.0);
+    stock.dispatchOn(pool, 256);
+
+    std::vector<std::shared_ptr<CountingObserver>> observers;
+    std::vector<Subscription> subscriptions;
+    for (size_t i = 0; i < kObservers; ++i) {
+        observers.push_back(std::make_shared<CountingObserver>());
+        subscriptions.push_back(stock.subscribe(observers.back()));
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> churned{0};
+    std::thread churn([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            Subscription temporary = stock.subscribe(std::make_shared<CountingObserver>());
+            churned.fetch_add(1, std::memory_order_relaxed);
+        }  // Unsubscribed here, possibly mid-round
+    });
+
+    int tick = 0;
+    for (int burst = 0; burst < kBursts; ++burst) {
+        for (int i = 0; i < kTicksPerBurst; ++i) {
+            ++tick;
+            stock.setPrice(100.0 + tick * 0.01);
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+    stop = true;
+    churn.join();
+    pool.waitIdle();
+
+    uint64_t updates = 0;
+    size_t onFinalPrice = 0;
+    for (const auto& observer : observers) {
+        updates += observer->getUpdates();
+        if (observer->getLastPrice() == stock.getPrice()) ++onFinalPrice;
+    }
+    std::printf("%d ticks in %d bursts -> %llu notification rounds in batches of 256\n",
+                kTicks, kBursts, static_cast<unsigned long long>(stock.getRoundCount()));
+    std::printf("%llu updates delivered to %zu observers (%llu without coalescing)\n",
+                static_cast<unsigned long long>(updates), kObservers,
+                static_cast<unsigned long long>(kTicks) * kObservers);
+    std::printf("%zu/%zu observers saw the final price $%.2f; %d subscribe/unsubscribe pairs ran concurrently\n",
+                onFinalPrice, kObservers, stock.getPrice(), churned.load());
+}
+
 void demonstrateObserverPattern() {
     std::cout << "=== Observer Pattern Demonstration ===\n\n";
     
@@ -423,6 +1020,10 @@ void demonstrateObserverPattern() {
     demonstrateFunctionObserver();
     demonstrateTemplateObservable();
     demonstrateObserverLifecycle();
+    demonstrateBroadcastFanOut();
+    demonstrateConcurrentQuoteReaders();
+    demonstrateLargeFanOut();
+    demonstrateAsyncDispatch();
     
     std::cout << "\n=== Observer Pattern Benefits ===\n";
     std::cout << "✓ Loose coupling between subject and observers\n";
@@ -430,7 +1031,10 @@ void demonstrateObserverPattern() {
     std::cout << "✓ Automatic notification of state changes\n";
     std::cout << "✓ Support for multiple observers\n";
     std::cout << "✓ Extensible - new observer types can be added easily\n";
-    std::cout << "✓ Memory safety with weak_ptr usage\n";
+    std::cout << "✓ Subscription tokens end subscriptions; the subject holds observers weakly\n";
+    std::cout << "✓ Fan-out scales when updates are encoded once and shared\n";
+    std::cout << "✓ Pull-model reads can be lock-free with a seqlocked snapshot\n";
+    std::cout << "✓ Async dispatch keeps fan-out off the publisher and coalesces stale ticks\n";
 }
 
 int main() {
@@ -6,6 +6,18 @@
 #include <algorithm>
 #include <random>
 #include <chrono>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
 
 // Strategy Interface
 class SortStrategy {
@@ -70,56 +82,39 @@ public:
 
 class MergeSort : public SortStrategy {
 private:
-    void mergeSort(std::vector<int>& data, int left, int right) {
-        if (left < right) {
-            int mid = left + (right - left) / 2;
-            mergeSort(data, left, mid);
-            mergeSort(data, mid + 1, right);
-            merge(data, left, mid, right);
-        }
+    // One buffer for every level, reused across sorts. Only the left half
+    // of a merge is copied out; the merge writes back over the input.
+    std::vector<int> scratch_;
+    
+    void mergeSort(std::vector<int>& data, size_t left, size_t right) {
+        if (right - left < 2) return;
+        size_t mid = left + (right - left) / 2;
+        mergeSort(data, left, mid);
+        mergeSort(data, mid, right);
+        if (data[mid - 1] <= data[mid]) return;  // Halves already in order
+        merge(data, left, mid, right);
     }
     
-    void merge(std::vector<int>& data, int left, int mid, int right) {
-        int n1 = mid - left + 1;
-        int n2 = right - mid;
-        
-        std::vector<int> leftArr(n1), rightArr(n2);
-        
-        for (int i = 0; i < n1; i++) leftArr[i] = data[left + i];
-        for (int j = 0; j < n2; j++) rightArr[j] = data[mid + 1 + j];
+    void merge(std::vector<int>& data, size_t left, size_t mid, size_t right) {
+        std::copy(data.begin() + left, data.begin() + mid, scratch_.begin());
+        size_t i = 0, n1 = mid - left;
+        size_t j = mid, k = left;
         
-        int i = 0, j = 0, k = left;
-        
-        while (i < n1 && j < n2) {
-            if (leftArr[i] <= rightArr[j]) {
-                data[k] = leftArr[i];
-                i++;
-            } else {
-                data[k] = rightArr[j];
-                j++;
-            }
-            k++;
+        // k stays below j, so no unread right-half element is overwritten
+        while (i < n1 && j < right) {
+            data[k++] = data[j] < scratch_[i] ? data[j++] : scratch_[i++];
         }
-        
         while (i < n1) {
-            data[k] = leftArr[i];
-            i++;
-            k++;
-        }
-        
-        while (j < n2) {
-            data[k] = rightArr[j];
-            j++;
-            k++;
+            data[k++] = scratch_[i++];
         }
+        // Whatever is left of the right half is already in place
     }
 
 public:
     void sort(std::vector<int>& data) override {
         std::cout << "Performing Merge Sort..." << std::endl;
-        if (!data.empty()) {
-            mergeSort(data, 0, static_cast<int>(data.size()) - 1);
-        }
+        scratch_.resize(data.size() / 2 + 1);
+        mergeSort(data, 0, data.size());
     }
     
     std::string getName() const override { return "Merge Sort"; }
@@ -135,6 +130,881 @@ public:
     std::string getName() const override { return "std::sort"; }
 };
 
+// ===== SORT KERNELS FOR LARGE BATCHES =====
+//
+// The strategies below wrap templated kernels that work on raw arrays of
+// arithmetic keys. The virtual call happens once per sort, not once per
+// comparison, so the Strategy interface costs nothing where it matters.
+
+// --- Sorting networks for small partitions (SIMD) ---
+//
+// A bitonic network sorts a whole register at once: each stage pairs every
+// lane with lane i^j (one permute), takes min and max of the pairs, and a
+// blend keeps the max in lanes that should hold the larger value. 8 ints
+// take 6 stages, 16 take 10, with no branches at all. The kernels are
+// compiled for AVX2/AVX-512 with target attributes and picked at run time,
+// so the binary still runs on CPUs without them.
+
+// Lane i keeps the max of its pair when (i & j) and (i & k) disagree; in
+// the final merge (k == lanes) that is simply the upper lane of each pair
+constexpr int bitonicMaxLanes(int lanes, int k, int j) {
+    int mask = 0;
+    for (int i = 0; i < lanes; ++i) {
+        if (((i & j) != 0) != ((i & k) != 0)) mask |= 1 << i;
+    }
+    return mask;
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define STRATEGY_HAVE_X86_NETWORKS 1
+
+template <int K, int J>
+__attribute__((target("avx2"))) inline __m256i bitonicStage8(__m256i v) {
+    const __m256i partner = _mm256_setr_epi32(0 ^ J, 1 ^ J, 2 ^ J, 3 ^ J, 4 ^ J, 5 ^ J, 6 ^ J, 7 ^ J);
+    __m256i p = _mm256_permutevar8x32_epi32(v, partner);
+    return _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), bitonicMaxLanes(8, K, J));
+}
+
+__attribute__((target("avx2"))) inline __m256i bitonicMerge8(__m256i v) {
+    v = bitonicStage8<8, 4>(v);
+    v = bitonicStage8<8, 2>(v);
+    return bitonicStage8<8, 1>(v);
+}
+
+__attribute__((target("avx2"))) inline __m256i bitonicSort8(__m256i v) {
+    v = bitonicStage8<2, 1>(v);
+    v = bitonicStage8<4, 2>(v);
+    v = bitonicStage8<4, 1>(v);
+    return bitonicMerge8(v);
+}
+
+// Up to 16 ints: sort two registers, reverse one so the pair is bitonic,
+// split it into low and high halves with one min/max, merge each half
+__attribute__((target("avx2"))) void networkSortInt16Avx2(int* data, size_t n) {
+    alignas(32) int buffer[16];
+    for (size_t i = 0; i < 16; ++i) buffer[i] = i < n ? data[i] : std::numeric_limits<int>::max();
+    __m256i a = bitonicSort8(_mm256_load_si256(reinterpret_cast<const __m256i*>(buffer)));
+    __m256i b = bitonicSort8(_mm256_load_si256(reinterpret_cast<const __m256i*>(buffer + 8)));
+    b = _mm256_permutevar8x32_epi32(b, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    __m256i low = bitonicMerge8(_mm256_min_epi32(a, b));
+    __m256i high = bitonicMerge8(_mm256_max_epi32(a, b));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(buffer), low);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(buffer + 8), high);
+    std::copy(buffer, buffer + n, data);
+}
+
+// Full-mask forms of permute/min/max: the same instructions, but GCC 12
+// warns about the undefined pass-through operand of the unmasked ones
+constexpr __mmask16 kAllLanes16 = 0xFFFF;
+
+__attribute__((target("avx512f"))) inline __m512i min16(__m512i a, __m512i b) {
+    return _mm512_maskz_min_epi32(kAllLanes16, a, b);
+}
+
+__attribute__((target("avx512f"))) inline __m512i max16(__m512i a, __m512i b) {
+    return _mm512_maskz_max_epi32(kAllLanes16, a, b);
+}
+
+__attribute__((target("avx512f"))) inline __m512i permute16(__m512i index, __m512i v) {
+    return _mm512_maskz_permutexvar_epi32(kAllLanes16, index, v);
+}
+
+template <int K, int J>
+__attribute__((target("avx512f"))) inline __m512i bitonicStage16(__m512i v) {
+    const __m512i partner = _mm512_setr_epi32(0 ^ J, 1 ^ J, 2 ^ J, 3 ^ J, 4 ^ J, 5 ^ J, 6 ^ J, 7 ^ J,
+                                              8 ^ J, 9 ^ J, 10 ^ J, 11 ^ J, 12 ^ J, 13 ^ J, 14 ^ J, 15 ^ J);
+    __m512i p = permute16(partner, v);
+    return _mm512_mask_mov_epi32(min16(v, p), static_cast<__mmask16>(bitonicMaxLanes(16, K, J)), max16(v, p));
+}
+
+__attribute__((target("avx512f"))) inline __m512i bitonicMerge16(__m512i v) {
+    v = bitonicStage16<16, 8>(v);
+    v = bitonicStage16<16, 4>(v);
+    v = bitonicStage16<16, 2>(v);
+    return bitonicStage16<16, 1>(v);
+}
+
+__attribute__((target("avx512f"))) inline __m512i bitonicSort16(__m512i v) {
+    v = bitonicStage16<2, 1>(v);
+    v = bitonicStage16<4, 2>(v);
+    v = bitonicStage16<4, 1>(v);
+    v = bitonicStage16<8, 4>(v);
+    v = bitonicStage16<8, 2>(v);
+    v = bitonicStage16<8, 1>(v);
+    return bitonicMerge16(v);
+}
+
+// Up to 32 ints. Masked loads pad missing lanes with INT_MAX, so nothing
+// is copied through a buffer.
+__attribute__((target("avx512f"))) void networkSortInt32Avx512(int* data, size_t n) {
+    const __m512i padding = _mm512_set1_epi32(std::numeric_limits<int>::max());
+    __mmask16 maskA = static_cast<__mmask16>(n >= 16 ? 0xFFFF : (1u << n) - 1);
+    __mmask16 maskB = static_cast<__mmask16>(n <= 16 ? 0 : n >= 32 ? 0xFFFF : (1u << (n - 16)) - 1);
+    __m512i a = bitonicSort16(_mm512_mask_loadu_epi32(padding, maskA, data));
+    __m512i b = bitonicSort16(_mm512_mask_loadu_epi32(padding, maskB, data + 16));
+    b = permute16(_mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0), b);
+    _mm512_mask_storeu_epi32(data, maskA, bitonicMerge16(min16(a, b)));
+    _mm512_mask_storeu_epi32(data + 16, maskB, bitonicMerge16(max16(a, b)));
+}
+#endif
+
+// Widest network this CPU runs, chosen once
+struct SmallSortKernel {
+    void (*sort)(int*, size_t) = nullptr;
+    size_t maxSize = 0;
+    const char* name = "insertion sort";
+};
+
+inline const SmallSortKernel& smallSortKernel() {
+    static const SmallSortKernel kernel = [] {
+        SmallSortKernel k;
+#ifdef STRATEGY_HAVE_X86_NETWORKS
+        if (__builtin_cpu_supports("avx512f")) {
+            k = {networkSortInt32Avx512, 32, "AVX-512 bitonic network"};
+        } else if (__builtin_cpu_supports("avx2")) {
+            k = {networkSortInt16Avx2, 16, "AVX2 bitonic network"};
+        }
+#endif
+        return k;
+    }();
+    return kernel;
+}
+
+// --- pdqsort: pattern-defeating quicksort ---
+//
+// Introsort refined the way Orson Peters' pdqsort does it:
+// - Partitioning is branchless in blocks of 64 (BlockQuicksort): the
+//   comparisons only record offsets, and the swaps happen afterwards, so
+//   random keys cause no branch mispredictions
+// - The pivot is a median of 3, or a pseudo-median of 9 (ninther) above 128
+//   elements
+// - A partition that needed no swaps gets a bounded insertion sort, so
+//   sorted and nearly sorted input is O(n)
+// - When the pivot equals the element left of the partition, equal keys
+//   are gathered in one pass instead of being partitioned over and over
+// - Each badly unbalanced partition shuffles a few elements to break the
+//   pattern; after log2(n) of them it falls back to heapsort (O(n log n))
+// - Small partitions go to the SIMD network above (int keys) or to an
+//   insertion sort
+namespace pdq {
+
+constexpr ptrdiff_t kSmallSortThreshold = 24;
+constexpr ptrdiff_t kNintherThreshold = 128;
+constexpr ptrdiff_t kPartialInsertionSortLimit = 8;
+constexpr size_t kBlockSize = 64;
+
+template <typename T>
+void insertionSort(T* begin, T* end) {
+    if (begin == end) return;
+    for (T* cur = begin + 1; cur != end; ++cur) {
+        T* sift = cur;
+        T* siftPrev = cur - 1;
+        if (*sift < *siftPrev) {
+            T tmp = *sift;
+            do {
+                *sift-- = *siftPrev;
+            } while (sift != begin && tmp < *--siftPrev);
+            *sift = tmp;
+        }
+    }
+}
+
+// For partitions that are not leftmost: the element before `begin` is at
+// most every element of the partition, so it acts as a sentinel
+template <typename T>
+void unguardedInsertionSort(T* begin, T* end) {
+    if (begin == end) return;
+    for (T* cur = begin + 1; cur != end; ++cur) {
+        T* sift = cur;
+        T* siftPrev = cur - 1;
+        if (*sift < *siftPrev) {
+            T tmp = *sift;
+            do {
+                *sift-- = *siftPrev;
+            } while (tmp < *--siftPrev);
+            *sift = tmp;
+        }
+    }
+}
+
+// Gives up (returns false) after moving more than a few elements
+template <typename T>
+bool partialInsertionSort(T* begin, T* end) {
+    if (begin == end) return true;
+    ptrdiff_t moved = 0;
+    for (T* cur = begin + 1; cur != end; ++cur) {
+        T* sift = cur;
+        T* siftPrev = cur - 1;
+        if (*sift < *siftPrev) {
+            T tmp = *sift;
+            do {
+                *sift-- = *siftPrev;
+            } while (sift != begin && tmp < *--siftPrev);
+            *sift = tmp;
+            moved += cur - sift;
+        }
+        if (moved > kPartialInsertionSortLimit) return false;
+    }
+    return true;
+}
+
+template <typename T>
+void smallSort(T* begin, T* end, bool leftmost) {
+    if constexpr (std::is_same_v<T, int>) {
+        const SmallSortKernel& kernel = smallSortKernel();
+        if (static_cast<size_t>(end - begin) <= kernel.maxSize) {
+            kernel.sort(begin, static_cast<size_t>(end - begin));
+            return;
+        }
+    }
+    if (leftmost) {
+        insertionSort(begin, end);
+    } else {
+        unguardedInsertionSort(begin, end);
+    }
+}
+
+template <typename T>
+inline void sort2(T* a, T* b) {
+    if (*b < *a) std::iter_swap(a, b);
+}
+
+template <typename T>
+inline void sort3(T* a, T* b, T* c) {
+    sort2(a, b);
+    sort2(b, c);
+    sort2(a, b);
+}
+
+template <typename T>
+inline void swapOffsets(T* first, T* last, const unsigned char* offsetsL, const unsigned char* offsetsR,
+                        size_t count, bool useSwaps) {
+    if (useSwaps) {
+        // Equal counts on both sides: plain swaps keep the permutation valid
+        for (size_t i = 0; i < count; ++i) std::iter_swap(first + offsetsL[i], last - offsetsR[i]);
+    } else if (count > 0) {
+        // Otherwise a cyclic rotation does it with one move per element
+        T* l = first + offsetsL[0];
+        T* r = last - offsetsR[0];
+        T tmp = *l;
+        *l = *r;
+        for (size_t i = 1; i < count; ++i) {
+            l = first + offsetsL[i];
+            *r = *l;
+            r = last - offsetsR[i];
+            *l = *r;
+        }
+        *r = tmp;
+    }
+}
+
+// Partitions [begin, end) around *begin; elements equal to the pivot go
+// right. Returns the pivot's final position and whether the range was
+// already partitioned.
+template <typename T>
+std::pair<T*, bool> partitionRightBranchless(T* begin, T* end) {
+    T pivot = *begin;
+    T* first = begin;
+    T* last = end;
+
+    // The median-of-3 guarantees an element >= pivot on the right and one
+    // <= pivot on the left, so these scans need no bounds checks
+    while (*++first < pivot) {
+    }
+    if (first - 1 == begin) {
+        while (first < last && !(*--last < pivot)) {
+        }
+    } else {
+        while (!(*--last < pivot)) {
+        }
+    }
+
+    bool alreadyPartitioned = first >= last;
+    if (!alreadyPartitioned) {
+        std::iter_swap(first, last);
+        ++first;
+
+        alignas(64) unsigned char offsetsL[kBlockSize];
+        alignas(64) unsigned char offsetsR[kBlockSize];
+        T* baseL = first;
+        T* baseR = last;
+        size_t countL = 0, countR = 0, startL = 0, startR = 0;
+
+        while (first < last) {
+            // Refill whichever side has no pending misplaced elements
+            size_t unknown = static_cast<size_t>(last - first);
+            size_t splitL = countL == 0 ? (countR == 0 ? unknown / 2 : unknown) : 0;
+            size_t splitR = countR == 0 ? unknown - splitL : 0;
+
+            // The comparison result is added to the count, not branched on
+            if (splitL >= kBlockSize) {
+                for (size_t i = 0; i < kBlockSize;) {
+                    for (int unroll = 0; unroll < 8; ++unroll) {
+                        offsetsL[countL] = static_cast<unsigned char>(i++);
+                        countL += !(*first < pivot);
+                        ++first;
+                    }
+                }
+            } else {
+                for (size_t i = 0; i < splitL;) {
+                    offsetsL[countL] = static_cast<unsigned char>(i++);
+                    countL += !(*first < pivot);
+                    ++first;
+                }
+            }
+
+            if (splitR >= kBlockSize) {
+                for (size_t i = 0; i < kBlockSize;) {
+                    for (int unroll = 0; unroll < 8; ++unroll) {
+                        offsetsR[countR] = static_cast<unsigned char>(++i);
+                        countR += *--last < pivot;
+                    }
+                }
+            } else {
+                for (size_t i = 0; i < splitR;) {
+                    offsetsR[countR] = static_cast<unsigned char>(++i);
+                    countR += *--last < pivot;
+                }
+            }
+
+            size_t count = std::min(countL, countR);
+            swapOffsets(baseL, baseR, offsetsL + startL, offsetsR + startR, count, countL == countR);
+            countL -= count;
+            countR -= count;
+            startL += count;
+            startR += count;
+            if (countL == 0) {
+                startL = 0;
+                baseL = first;
+            }
+            if (countR == 0) {
+                startR = 0;
+                baseR = last;
+            }
+        }
+
+        // One side may still hold misplaced elements; move them across
+        if (countL) {
+            while (countL--) std::iter_swap(baseL + offsetsL[startL + countL], --last);
+            first = last;
+        }
+        if (countR) {
+            while (countR--) std::iter_swap(baseR - offsetsR[startR + countR], first), ++first;
+            last = first;
+        }
+    }
+
+    T* pivotPos = first - 1;
+    *begin = *pivotPos;
+    *pivotPos = pivot;
+    return {pivotPos, alreadyPartitioned};
+}
+
+// Elements equal to the pivot go left. Used when the pivot equals the
+// element before the partition: everything equal to it is then already in
+// its final place, and the next partition starts after the run.
+template <typename T>
+T* partitionLeft(T* begin, T* end) {
+    T pivot = *begin;
+    T* first = begin;
+    T* last = end;
+
+    while (pivot < *--last) {
+    }
+    if (last + 1 == end) {
+        while (first < last && !(pivot < *++first)) {
+        }
+    } else {
+        while (!(pivot < *++first)) {
+        }
+    }
+
+    while (first < last) {
+        std::iter_swap(first, last);
+        while (pivot < *--last) {
+        }
+        while (!(pivot < *++first)) {
+        }
+    }
+
+    T* pivotPos = last;
+    *begin = *pivotPos;
+    *pivotPos = pivot;
+    return pivotPos;
+}
+
+template <typename T>
+void sortLoop(T* begin, T* end, int badAllowed, bool leftmost) {
+    for (;;) {
+        ptrdiff_t size = end - begin;
+        if (size < kSmallSortThreshold) {
+            smallSort(begin, end, leftmost);
+            return;
+        }
+
+        ptrdiff_t half = size / 2;
+        if (size > kNintherThreshold) {
+            sort3(begin, begin + half, end - 1);
+            sort3(begin + 1, begin + (half - 1), end - 2);
+            sort3(begin + 2, begin + (half + 1), end - 3);
+            sort3(begin + (half - 1), begin + half, begin + (half + 1));
+            std::iter_swap(begin, begin + half);
+        } else {
+            sort3(begin + half, begin, end - 1);
+        }
+
+        if (!leftmost && !(*(begin - 1) < *begin)) {
+            begin = partitionLeft(begin, end) + 1;
+            continue;
+        }
+
+        auto [pivotPos, alreadyPartitioned] = partitionRightBranchless(begin, end);
+        ptrdiff_t sizeL = pivotPos - begin;
+        ptrdiff_t sizeR = end - (pivotPos + 1);
+
+        if (sizeL < size / 8 || sizeR < size / 8) {
+            if (--badAllowed == 0) {
+                std::make_heap(begin, end);
+                std::sort_heap(begin, end);
+                return;
+            }
+            // Swap a few elements into new places to break up the pattern
+            if (sizeL >= kSmallSortThreshold) {
+                std::iter_swap(begin, begin + sizeL / 4);
+                std::iter_swap(pivotPos - 1, pivotPos - sizeL / 4);
+                if (sizeL > kNintherThreshold) {
+                    std::iter_swap(begin + 1, begin + (sizeL / 4 + 1));
+                    std::iter_swap(begin + 2, begin + (sizeL / 4 + 2));
+                    std::iter_swap(pivotPos - 2, pivotPos - (sizeL / 4 + 1));
+                    std::iter_swap(pivotPos - 3, pivotPos - (sizeL / 4 + 2));
+                }
+            }
+            if (sizeR >= kSmallSortThreshold) {
+                std::iter_swap(pivotPos + 1, pivotPos + (1 + sizeR / 4));
+                std::iter_swap(end - 1, end - sizeR / 4);
+                if (sizeR > kNintherThreshold) {
+                    std::iter_swap(pivotPos + 2, pivotPos + (2 + sizeR / 4));
+                    std::iter_swap(pivotPos + 3, pivotPos + (3 + sizeR / 4));
+                    std::iter_swap(end - 2, end - (1 + sizeR / 4));
+                    std::iter_swap(end - 3, end - (2 + sizeR / 4));
+                }
+            }
+        } else if (alreadyPartitioned && partialInsertionSort(begin, pivotPos) &&
+                   partialInsertionSort(pivotPos + 1, end)) {
+            return;
+        }
+
+        // Recurse into the left side, loop on the right
+        sortLoop(begin, pivotPos, badAllowed, leftmost);
+        begin = pivotPos + 1;
+        leftmost = false;
+    }
+}
+
+}  // namespace pdq
+
+template <typename T>
+void pdqSort(T* begin, T* end) {
+    static_assert(std::is_arithmetic_v<T>, "pdqSort's branchless partition is for arithmetic keys");
+    if (end - begin < 2) return;
+    int badAllowed = 0;
+    for (size_t n = static_cast<size_t>(end - begin); n > 1; n >>= 1) ++badAllowed;
+    pdq::sortLoop(begin, end, badAllowed, true);
+}
+
+// --- LSD radix sort ---
+//
+// Keys are mapped to unsigned integers that sort the same way: signed ints
+// flip the sign bit; floats flip the sign bit when positive and every bit
+// when negative. Then one stable counting pass per byte. One read of the
+// input builds all the histograms, a pass is skipped when every key has
+// the same byte there (small ranges skip the high bytes), and the passes
+// ping-pong between the data and a single scratch buffer.
+template <typename T>
+struct RadixKey {
+    static_assert(std::is_arithmetic_v<T>, "radix sort needs integer or floating-point keys");
+    using Bits = std::conditional_t<sizeof(T) <= 4, uint32_t, uint64_t>;
+
+    static Bits encode(T value) {
+        if constexpr (std::is_floating_point_v<T>) {
+            Bits bits;
+            std::memcpy(&bits, &value, sizeof(T));
+            constexpr Bits kSign = Bits(1) << (sizeof(T) * 8 - 1);
+            return bits & kSign ? ~bits : bits | kSign;
+        } else if constexpr (std::is_signed_v<T>) {
+            constexpr Bits kSign = Bits(1) << (sizeof(T) * 8 - 1);
+            return static_cast<Bits>(static_cast<std::make_unsigned_t<T>>(value)) ^ kSign;
+        } else {
+            return static_cast<Bits>(value);
+        }
+    }
+};
+
+template <typename T>
+void radixSort(std::vector<T>& data, std::vector<T>& scratch) {
+    constexpr int kPasses = sizeof(T);
+    const size_t n = data.size();
+    if (n < 2) return;
+    scratch.resize(n);
+
+    std::vector<std::array<size_t, 256>> counts(kPasses);
+    for (auto& table : counts) table.fill(0);
+    for (const T& value : data) {
+        auto key = RadixKey<T>::encode(value);
+        for (int pass = 0; pass < kPasses; ++pass) ++counts[pass][(key >> (8 * pass)) & 0xFF];
+    }
+
+    T* src = data.data();
+    T* dst = scratch.data();
+    for (int pass = 0; pass < kPasses; ++pass) {
+        const auto& count = counts[pass];
+        const int shift = 8 * pass;
+        if (count[(RadixKey<T>::encode(src[0]) >> shift) & 0xFF] == n) continue;
+
+        size_t offsets[256];
+        size_t sum = 0;
+        for (int digit = 0; digit < 256; ++digit) {
+            offsets[digit] = sum;
+            sum += count[digit];
+        }
+        for (size_t i = 0; i < n; ++i) {
+            dst[offsets[(RadixKey<T>::encode(src[i]) >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+    if (src != data.data()) std::memcpy(data.data(), src, n * sizeof(T));
+}
+
+// --- Parallel merge sort ---
+
+// Fixed workers plus the calling thread run the indices of one parallelFor
+// at a time. crtp.cpp's expression templates use a per-call variant. The
+// full pool (task queues, futures, metrics) is Multithreading/06_thread_pool.cpp.
+class SortThreadPool {
+private:
+    struct Job {
+        const std::function<void(size_t)>* body;
+        size_t count;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> remaining;
+        Job(const std::function<void(size_t)>* b, size_t c) : body(b), count(c), remaining(c) {}
+    };
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable jobReady_;
+    std::condition_variable jobDone_;
+    std::shared_ptr<Job> job_;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+
+    // A straggler from an earlier job only ever touches that job's own
+    // counters, so it can never run an index of the next one
+    void runIndices(const std::shared_ptr<Job>& job) {
+        size_t i;
+        while ((i = job->next.fetch_add(1, std::memory_order_relaxed)) < job->count) {
+            (*job->body)(i);
+            if (job->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                jobDone_.notify_all();
+            }
+        }
+    }
+
+public:
+    explicit SortThreadPool(size_t workers) {
+        for (size_t w = 0; w < workers; ++w) {
+            workers_.emplace_back([this] {
+                uint64_t seen = 0;
+                for (;;) {
+                    std::shared_ptr<Job> job;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        jobReady_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                        if (stop_) return;
+                        seen = generation_;
+                        job = job_;
+                    }
+                    runIndices(job);
+                }
+            });
+        }
+    }
+
+    ~SortThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        jobReady_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    size_t concurrency() const { return workers_.size() + 1; }
+
+    void parallelFor(size_t count, const std::function<void(size_t)>& body) {
+        if (count == 0) return;
+        auto job = std::make_shared<Job>(&body, count);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = job;
+            ++generation_;
+        }
+        jobReady_.notify_all();
+        runIndices(job);
+        std::unique_lock<std::mutex> lock(mutex_);
+        jobDone_.wait(lock, [&] { return job->remaining.load(std::memory_order_acquire) == 0; });
+    }
+};
+
+// Merge path: the split of a merge of a and b such that the first `diagonal`
+// outputs are a[0, i) and b[0, diagonal - i). Ties come from `a`, which
+// keeps the merge stable.
+template <typename T>
+size_t mergePathSplit(const T* a, size_t sizeA, const T* b, size_t sizeB, size_t diagonal) {
+    size_t low = diagonal > sizeB ? diagonal - sizeB : 0;
+    size_t high = std::min(diagonal, sizeA);
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (!(b[diagonal - mid - 1] < a[mid])) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Sorts one chunk per pool thread with pdqSort, then merges pairs of runs
+// round by round, ping-ponging between the data and one scratch buffer.
+// Every merge is cut into equal slices along the merge path, so the last
+// rounds (one or two huge merges) still keep every thread busy.
+template <typename T>
+void parallelMergeSort(std::vector<T>& data, std::vector<T>& scratch, SortThreadPool& pool) {
+    constexpr size_t kSerialCutoff = 1 << 15;
+    const size_t n = data.size();
+    const size_t threads = pool.concurrency();
+    if (n <= kSerialCutoff || threads == 1) {
+        pdqSort(data.data(), data.data() + n);
+        return;
+    }
+    scratch.resize(n);
+
+    std::vector<size_t> bounds;  // Run i is [bounds[i], bounds[i + 1])
+    for (size_t c = 0; c <= threads; ++c) bounds.push_back(n * c / threads);
+    T* src = data.data();
+    T* dst = scratch.data();
+    pool.parallelFor(threads, [&](size_t c) { pdqSort(src + bounds[c], src + bounds[c + 1]); });
+
+    while (bounds.size() > 2) {
+        size_t runs = bounds.size() - 1;
+        size_t pairs = runs / 2;
+        size_t slices = std::max<size_t>(1, threads / pairs);
+        std::vector<size_t> merged;
+        for (size_t r = 0; r < runs; r += 2) merged.push_back(bounds[r]);
+        merged.push_back(n);
+
+        pool.parallelFor(pairs * slices + (runs % 2), [&](size_t task) {
+            if (task == pairs * slices) {  // Odd run out: carried over unchanged
+                std::copy(src + bounds[runs - 1], src + n, dst + bounds[runs - 1]);
+                return;
+            }
+            size_t pair = task / slices;
+            size_t slice = task % slices;
+            const T* a = src + bounds[2 * pair];
+            const T* b = src + bounds[2 * pair + 1];
+            size_t sizeA = bounds[2 * pair + 1] - bounds[2 * pair];
+            size_t sizeB = bounds[2 * pair + 2] - bounds[2 * pair + 1];
+            size_t from = (sizeA + sizeB) * slice / slices;
+            size_t to = (sizeA + sizeB) * (slice + 1) / slices;
+            size_t i0 = mergePathSplit(a, sizeA, b, sizeB, from);
+            size_t i1 = mergePathSplit(a, sizeA, b, sizeB, to);
+            std::merge(a + i0, a + i1, b + (from - i0), b + (to - i1), dst + bounds[2 * pair] + from);
+        });
+        bounds = std::move(merged);
+        std::swap(src, dst);
+    }
+    if (src != data.data()) {
+        pool.parallelFor(threads, [&](size_t c) {
+            std::copy(src + n * c / threads, src + n * (c + 1) / threads, data.data() + n * c / threads);
+        });
+    }
+}
+
+// --- Benchmark-driven selection ---
+
+template <typename T>
+std::vector<T> randomKeys(size_t n, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::vector<T> keys(n);
+    if constexpr (std::is_floating_point_v<T>) {
+        std::uniform_real_distribution<T> dis(-1e6, 1e6);
+        for (auto& key : keys) key = dis(gen);
+    } else {
+        std::uniform_int_distribution<T> dis(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+        for (auto& key : keys) key = dis(gen);
+    }
+    return keys;
+}
+
+// Best of several runs on a fresh copy of `input`, in ns per key. Small
+// inputs repeat more so each measurement covers about a million keys.
+template <typename T, typename Kernel>
+double sortNsPerKey(const std::vector<T>& input, Kernel&& kernel) {
+    int runs = static_cast<int>(std::clamp<size_t>((1 << 20) / std::max<size_t>(input.size(), 1), 3, 2000));
+    double best = 1e300;
+    std::vector<T> work;
+    for (int r = 0; r < runs; ++r) {
+        work = input;
+        auto start = std::chrono::steady_clock::now();
+        kernel(work);
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, ns);
+    }
+    return best / static_cast<double>(std::max<size_t>(input.size(), 1));
+}
+
+// Picks a sort kernel per key type and input size. calibrate() times every
+// candidate on random keys at sizes 2^6, 2^9, ... and keeps the fastest
+// for each; sort() then uses the winner of the nearest calibrated size.
+template <typename T>
+class SortSelector {
+public:
+    struct Candidate {
+        std::string name;
+        std::function<void(std::vector<T>&)> sort;
+    };
+
+    explicit SortSelector(std::vector<Candidate> candidates) : candidates_(std::move(candidates)) {}
+
+    void calibrate(size_t maxSize, std::ostream* report = nullptr) {
+        winners_.clear();
+        for (size_t size = 64; size <= maxSize; size <<= 3) {
+            std::vector<T> input = randomKeys<T>(size, static_cast<uint32_t>(size));
+            size_t best = 0;
+            double bestNs = 1e300;
+            for (size_t c = 0; c < candidates_.size(); ++c) {
+                double ns = sortNsPerKey(input, candidates_[c].sort);
+                if (ns < bestNs) {
+                    bestNs = ns;
+                    best = c;
+                }
+            }
+            winners_.push_back({size, best});
+            if (report) {
+                char line[128];
+                std::snprintf(line, sizeof(line), "  n=%-9zu -> %-20s %6.2f ns/key\n", size,
+                              candidates_[best].name.c_str(), bestNs);
+                *report << line;
+            }
+        }
+    }
+
+    const Candidate& choose(size_t n) const {
+        if (winners_.empty()) return candidates_.front();
+        size_t pick = winners_.front().second;
+        for (const auto& [size, candidate] : winners_) {
+            if (size / 2 <= n) pick = candidate;  // Nearest in log scale
+        }
+        return candidates_[pick];
+    }
+
+    void sort(std::vector<T>& data) const { choose(data.size()).sort(data); }
+
+private:
+    std::vector<Candidate> candidates_;
+    std::vector<std::pair<size_t, size_t>> winners_;  // (calibrated size, candidate)
+};
+
+// The kernels every selector chooses from. The pool is shared, so all
+// parallel sorts in the process use the same threads.
+inline SortThreadPool& sortPool() {
+    static SortThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+template <typename T>
+std::vector<typename SortSelector<T>::Candidate> sortCandidates() {
+    // Each kernel owns its scratch buffer, so two different kernels never
+    // touch the same memory
+    auto radixScratch = std::make_shared<std::vector<T>>();
+    auto mergeScratch = std::make_shared<std::vector<T>>();
+    return {
+        {"pdqsort", [](std::vector<T>& v) { pdqSort(v.data(), v.data() + v.size()); }},
+        {"std::sort", [](std::vector<T>& v) { std::sort(v.begin(), v.end()); }},
+        {"LSD radix", [radixScratch](std::vector<T>& v) { radixSort(v, *radixScratch); }},
+        {"parallel merge", [mergeScratch](std::vector<T>& v) { parallelMergeSort(v, *mergeScratch, sortPool()); }},
+    };
+}
+
+class PdqSort : public SortStrategy {
+public:
+    void sort(std::vector<int>& data) override {
+        std::cout << "Performing pdqsort (branchless blocks, " << smallSortKernel().name
+                  << " below " << pdq::kSmallSortThreshold << ")..." << std::endl;
+        pdqSort(data.data(), data.data() + data.size());
+    }
+    
+    std::string getName() const override { return "pdqsort"; }
+};
+
+class RadixSort : public SortStrategy {
+private:
+    std::vector<int> scratch_;
+
+public:
+    void sort(std::vector<int>& data) override {
+        std::cout << "Performing LSD Radix Sort (8-bit digits)..." << std::endl;
+        radixSort(data, scratch_);
+    }
+    
+    std::string getName() const override { return "LSD Radix Sort"; }
+};
+
+class ParallelMergeSort : public SortStrategy {
+private:
+    std::vector<int> scratch_;
+
+public:
+    void sort(std::vector<int>& data) override {
+        std::cout << "Performing Parallel Merge Sort on " << sortPool().concurrency() << " threads..." << std::endl;
+        parallelMergeSort(data, scratch_, sortPool());
+    }
+    
+    std::string getName() const override { return "Parallel Merge Sort"; }
+};
+
+// Delegates to whichever kernel the selector measured fastest for the
+// input size. The default selector calibrates once, quietly, up to 2^15
+// keys. A selector is not thread-safe: each kernel reuses its own scratch
+// buffer, so one kernel must not run twice at once.
+class AutoSort : public SortStrategy {
+private:
+    std::shared_ptr<SortSelector<int>> selector_;
+    
+    static std::shared_ptr<SortSelector<int>> defaultSelector() {
+        static auto selector = [] {
+            auto s = std::make_shared<SortSelector<int>>(sortCandidates<int>());
+            s->calibrate(1 << 15);
+            return s;
+        }();
+        return selector;
+    }
+
+public:
+    explicit AutoSort(std::shared_ptr<SortSelector<int>> selector = defaultSelector())
+        : selector_(std::move(selector)) {}
+    
+    void sort(std::vector<int>& data) override {
+        const auto& choice = selector_->choose(data.size());
+        std::cout << "Auto-selected " << choice.name << " for " << data.size() << " keys..." << std::endl;
+        choice.sort(data);
+    }
+    
+    std::string getName() const override { return "Auto (benchmark-selected)"; }
+};
+
 // Context class
 class Sorter {
 private:
@@ -220,76 +1090,549 @@ PaymentProcessor createBankTransferProcessor() {
 }
 
 // Template-based Strategy Pattern
+//
+// Codecs write into caller-provided buffers and keep no state between
+// calls. One instance can serve every thread, and compressing a batch
+// allocates nothing. decompress() throws std::runtime_error on corrupt
+// input rather than reading or writing out of bounds.
 template<typename T>
 class CompressionStrategy {
 public:
+    static_assert(std::is_trivially_copyable_v<T>, "codecs copy elements as raw bytes");
+
     virtual ~CompressionStrategy() = default;
-    virtual std::vector<T> compress(const std::vector<T>& data) = 0;
-    virtual std::vector<T> decompress(const std::vector<T>& data) = 0;
+    // Worst-case compress() output for `count` elements
+    virtual size_t maxCompressedSize(size_t count) const = 0;
+    // dst must hold maxCompressedSize(count) bytes; returns bytes written
+    virtual size_t compress(const T* data, size_t count, uint8_t* dst) const = 0;
+    // Decodes exactly `count` elements from all `size` bytes of src
+    virtual void decompress(const uint8_t* src, size_t size, T* dst, size_t count) const = 0;
     virtual std::string getName() const = 0;
 };
 
+namespace codec {
+
+[[noreturn]] inline void corrupt(const char* what) {
+    throw std::runtime_error(std::string("corrupt compressed data: ") + what);
+}
+
+inline uint8_t* putVarint(uint8_t* out, uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<uint8_t>(value) | 0x80;
+        value >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(value);
+    return out;
+}
+
+inline const uint8_t* getVarint(const uint8_t* in, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && in != end; shift += 7) {
+        uint8_t byte = *in++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return in;
+    }
+    corrupt("truncated varint");
+}
+
+inline uint32_t load32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// Little-endian on every host, so frames can cross machines
+inline void storeLE32(uint8_t* p, uint32_t value) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+inline uint32_t loadLE32(const uint8_t* p) {
+    return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+}
+
+}  // namespace codec
+
 template<typename T>
 class NoCompression : public CompressionStrategy<T> {
 public:
-    std::vector<T> compress(const std::vector<T>& data) override {
-        std::cout << "No compression applied" << std::endl;
-        return data;
+    size_t maxCompressedSize(size_t count) const override { return count * sizeof(T); }
+
+    size_t compress(const T* data, size_t count, uint8_t* dst) const override {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+        std::copy_n(bytes, count * sizeof(T), dst);
+        return count * sizeof(T);
     }
-    
-    std::vector<T> decompress(const std::vector<T>& data) override {
-        std::cout << "No decompression needed" << std::endl;
-        return data;
+
+    void decompress(const uint8_t* src, size_t size, T* dst, size_t count) const override {
+        if (size != count * sizeof(T)) codec::corrupt("size mismatch");
+        std::copy_n(src, size, reinterpret_cast<uint8_t*>(dst));
     }
-    
+
     std::string getName() const override { return "No Compression"; }
 };
 
+// Run-length encoding: (varint run length, raw element) pairs. Elements
+// are compared bytewise, so NaNs and -0.0 round-trip exactly. Good for
+// status codes and gauges that hold their value between samples.
+template<typename T>
+class RleCompression : public CompressionStrategy<T> {
+public:
+    // Runs of one are the worst case: a 1-byte length per element
+    size_t maxCompressedSize(size_t count) const override { return count * (sizeof(T) + 1); }
+
+    size_t compress(const T* data, size_t count, uint8_t* dst) const override {
+        uint8_t* out = dst;
+        size_t i = 0;
+        while (i < count) {
+            size_t run = 1;
+            while (i + run < count && std::memcmp(&data[i + run], &data[i], sizeof(T)) == 0) ++run;
+            out = codec::putVarint(out, run);
+            std::memcpy(out, &data[i], sizeof(T));
+            out += sizeof(T);
+            i += run;
+        }
+        return static_cast<size_t>(out - dst);
+    }
+
+    void decompress(const uint8_t* src, size_t size, T* dst, size_t count) const override {
+        const uint8_t* in = src;
+        const uint8_t* end = src + size;
+        size_t produced = 0;
+        while (in != end) {
+            uint64_t run;
+            in = codec::getVarint(in, end, run);
+            if (run == 0 || run > count - produced) codec::corrupt("run overflows output");
+            if (static_cast<size_t>(end - in) < sizeof(T)) codec::corrupt("truncated run value");
+            T value;
+            std::memcpy(&value, in, sizeof(T));
+            in += sizeof(T);
+            std::fill_n(dst + produced, run, value);
+            produced += run;
+        }
+        if (produced != count) codec::corrupt("element count mismatch");
+    }
+
+    std::string getName() const override { return "RLE"; }
+};
+
+// Delta + zigzag + varint for integer series. Counters and timestamps
+// change by small amounts, so each delta usually fits in one or two
+// bytes. Zigzag maps small negative deltas to small unsigned values.
+// The deltas wrap around, so any sequence round-trips.
+template<typename T>
+class DeltaVarintCompression : public CompressionStrategy<T> {
+    static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "delta coding needs integer elements");
+
+    using U = std::make_unsigned_t<T>;
+    static constexpr int kBits = sizeof(T) * 8;
+    static constexpr uint64_t kMask = kBits == 64 ? ~uint64_t(0) : (uint64_t(1) << kBits) - 1;
+
+public:
+    size_t maxCompressedSize(size_t count) const override { return count * ((kBits + 6) / 7); }
+
+    size_t compress(const T* data, size_t count, uint8_t* dst) const override {
+        uint8_t* out = dst;
+        U prev = 0;
+        for (size_t i = 0; i < count; ++i) {
+            U cur = static_cast<U>(data[i]);
+            uint64_t delta = static_cast<U>(cur - prev);
+            uint64_t sign = (delta >> (kBits - 1)) & 1;
+            out = codec::putVarint(out, ((delta << 1) & kMask) ^ (sign ? kMask : 0));
+            prev = cur;
+        }
+        return static_cast<size_t>(out - dst);
+    }
+
+    void decompress(const uint8_t* src, size_t size, T* dst, size_t count) const override {
+        const uint8_t* in = src;
+        const uint8_t* end = src + size;
+        U prev = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t zigzag;
+            in = codec::getVarint(in, end, zigzag);
+            uint64_t delta = ((zigzag >> 1) ^ (0 - (zigzag & 1))) & kMask;
+            prev = static_cast<U>(prev + static_cast<U>(delta));
+            dst[i] = static_cast<T>(prev);
+        }
+        if (in != end) codec::corrupt("trailing bytes");
+    }
+
+    std::string getName() const override { return "Delta+Varint"; }
+};
+
+// LZ4 block format over the raw bytes: sequences of (token, literals,
+// 2-byte offset, match length), with a 4K-entry hash table of recent
+// 4-byte strings kept on the stack. Matches are found with one probe per
+// position, and the probe step grows on incompressible input, so it
+// runs at memory-copy speed rather than chasing the best ratio. The
+// decoder checks every length and offset against both buffers.
 template<typename T>
-class SimpleCompression : public CompressionStrategy<T> {
+class Lz4Compression : public CompressionStrategy<T> {
+    static constexpr int kHashBits = 12;
+    static constexpr size_t kMinMatch = 4;
+    static constexpr size_t kLastLiterals = 5;   // Format rule: the block ends with literals
+    static constexpr size_t kMatchStartLimit = 12;
+    static constexpr size_t kMaxOffset = 65535;
+
+    static uint32_t hash(uint32_t sequence) { return (sequence * 2654435761u) >> (32 - kHashBits); }
+
+    static uint8_t* putLength(uint8_t* out, size_t length) {
+        for (; length >= 255; length -= 255) *out++ = 255;
+        *out++ = static_cast<uint8_t>(length);
+        return out;
+    }
+
+    static uint8_t* emitSequence(uint8_t* out, const uint8_t* literals, size_t literalLength,
+                                 size_t offset, size_t matchLength) {
+        size_t extraMatch = matchLength - kMinMatch;
+        uint8_t* token = out++;
+        *token = static_cast<uint8_t>(std::min<size_t>(literalLength, 15) << 4);
+        if (literalLength >= 15) out = putLength(out, literalLength - 15);
+        std::copy_n(literals, literalLength, out);
+        out += literalLength;
+        if (offset == 0) return out;  // Final literal-only sequence
+        *out++ = static_cast<uint8_t>(offset);
+        *out++ = static_cast<uint8_t>(offset >> 8);
+        *token |= static_cast<uint8_t>(std::min<size_t>(extraMatch, 15));
+        if (extraMatch >= 15) out = putLength(out, extraMatch - 15);
+        return out;
+    }
+
+    static size_t getLength(const uint8_t*& in, const uint8_t* end, size_t length) {
+        if (length != 15) return length;
+        uint8_t byte;
+        do {
+            if (in == end) codec::corrupt("truncated length");
+            byte = *in++;
+            length += byte;
+        } while (byte == 255);
+        return length;
+    }
+
 public:
-    std::vector<T> compress(const std::vector<T>& data) override {
-        std::cout << "Applying simple compression (removing duplicates)" << std::endl;
-        std::vector<T> compressed;
-        for (const auto& item : data) {
-            if (std::find(compressed.begin(), compressed.end(), item) == compressed.end()) {
-                compressed.push_back(item);
+    size_t maxCompressedSize(size_t count) const override {
+        size_t bytes = count * sizeof(T);
+        return bytes + bytes / 255 + 16;
+    }
+
+    size_t compress(const T* data, size_t count, uint8_t* dst) const override {
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(data);
+        const size_t size = count * sizeof(T);
+        const uint8_t* end = src + size;
+        const uint8_t* anchor = src;
+        uint8_t* out = dst;
+
+        if (size > kMatchStartLimit) {
+            uint32_t table[1 << kHashBits] = {};  // Positions relative to src
+            const uint8_t* matchEnd = end - kLastLiterals;
+            const uint8_t* matchStartEnd = end - kMatchStartLimit;
+            const uint8_t* ip = src + 1;
+            unsigned misses = 0;
+
+            while (ip < matchStartEnd) {
+                uint32_t sequence = codec::load32(ip);
+                uint32_t& slot = table[hash(sequence)];
+                const uint8_t* ref = src + slot;
+                slot = static_cast<uint32_t>(ip - src);
+                if (static_cast<size_t>(ip - ref) > kMaxOffset || codec::load32(ref) != sequence) {
+                    ip += 1 + (misses++ >> 6);  // Skip faster through incompressible data
+                    continue;
+                }
+                misses = 0;
+                while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+                    --ip;
+                    --ref;
+                }
+                const uint8_t* matchEndPos = ip + kMinMatch;
+                const uint8_t* refPos = ref + kMinMatch;
+                while (matchEndPos < matchEnd && *matchEndPos == *refPos) {
+                    ++matchEndPos;
+                    ++refPos;
+                }
+                out = emitSequence(out, anchor, static_cast<size_t>(ip - anchor), static_cast<size_t>(ip - ref),
+                                   static_cast<size_t>(matchEndPos - ip));
+                ip = anchor = matchEndPos;
+                if (ip < matchStartEnd) table[hash(codec::load32(ip - 2))] = static_cast<uint32_t>(ip - 2 - src);
             }
         }
-        return compressed;
+        out = emitSequence(out, anchor, static_cast<size_t>(end - anchor), 0, kMinMatch);
+        return static_cast<size_t>(out - dst);
     }
-    
-    std::vector<T> decompress(const std::vector<T>& data) override {
-        std::cout << "Simple decompression (data as-is)" << std::endl;
-        return data;
+
+    void decompress(const uint8_t* src, size_t size, T* dst, size_t count) const override {
+        const uint8_t* in = src;
+        const uint8_t* inEnd = src + size;
+        uint8_t* const outStart = reinterpret_cast<uint8_t*>(dst);
+        uint8_t* out = outStart;
+        uint8_t* const outEnd = outStart + count * sizeof(T);
+
+        while (in != inEnd) {
+            uint8_t token = *in++;
+            size_t literalLength = getLength(in, inEnd, token >> 4);
+            if (literalLength > static_cast<size_t>(inEnd - in) || literalLength > static_cast<size_t>(outEnd - out)) {
+                codec::corrupt("literals overflow");
+            }
+            std::copy_n(in, literalLength, out);
+            in += literalLength;
+            out += literalLength;
+            if (in == inEnd) break;
+
+            if (inEnd - in < 2) codec::corrupt("truncated offset");
+            size_t offset = size_t(in[0]) | size_t(in[1]) << 8;
+            in += 2;
+            if (offset == 0 || offset > static_cast<size_t>(out - outStart)) codec::corrupt("bad match offset");
+            size_t matchLength = getLength(in, inEnd, token & 15) + kMinMatch;
+            if (matchLength > static_cast<size_t>(outEnd - out)) codec::corrupt("match overflows output");
+
+            const uint8_t* match = out - offset;
+            if (offset >= matchLength) {
+                std::memcpy(out, match, matchLength);
+                out += matchLength;
+            } else if (offset >= 8) {
+                // Overlapping, but every 8-byte step reads bytes already written
+                for (size_t i = 0; i < matchLength; i += 8) {
+                    std::memcpy(out + i, match + i, std::min<size_t>(8, matchLength - i));
+                }
+                out += matchLength;
+            } else {
+                // Short period: repeat the last `offset` bytes one at a time
+                for (size_t i = 0; i < matchLength; ++i) *out++ = match[i];
+            }
+        }
+        if (out != outEnd) codec::corrupt("element count mismatch");
+    }
+
+    std::string getName() const override { return "LZ4 block"; }
+};
+
+// --- Framed streams ---
+//
+// A stream is a sequence of frames: element count (u32 LE), payload
+// bytes (u32 LE), payload. Frames decode independently, so a reader can
+// start as soon as the first one arrives, and large inputs compress
+// block-parallel into the same format.
+constexpr size_t kFrameHeaderSize = 8;
+
+template<typename T>
+size_t maxFramedSize(const CompressionStrategy<T>& strategy, size_t count, size_t chunkElements) {
+    size_t frames = (count + chunkElements - 1) / chunkElements;
+    return frames * (kFrameHeaderSize + strategy.maxCompressedSize(chunkElements));
+}
+
+template<typename T>
+size_t writeFrame(const CompressionStrategy<T>& strategy, const T* data, size_t count, uint8_t* dst) {
+    size_t payload = strategy.compress(data, count, dst + kFrameHeaderSize);
+    codec::storeLE32(dst, static_cast<uint32_t>(count));
+    codec::storeLE32(dst + 4, static_cast<uint32_t>(payload));
+    return kFrameHeaderSize + payload;
+}
+
+// Accepts any number of elements per write() and emits one frame per full
+// chunk. Only a partial chunk is copied (into the pending buffer); full
+// chunks compress straight from the caller's data.
+template<typename T>
+class StreamCompressor {
+private:
+    const CompressionStrategy<T>& strategy_;
+    size_t chunkElements_;
+    std::vector<T> pending_;
+
+    void requireCapacity(size_t count, size_t capacity) const {
+        if (capacity < maxOutputSize(count)) throw std::length_error("StreamCompressor: output buffer too small");
+    }
+
+public:
+    StreamCompressor(const CompressionStrategy<T>& strategy, size_t chunkElements = 1 << 14)
+        : strategy_(strategy), chunkElements_(std::clamp<size_t>(chunkElements, 1, std::numeric_limits<uint32_t>::max())) {
+        pending_.reserve(chunkElements_);
+    }
+
+    // Buffer size that write() of `count` more elements (or flush() when
+    // count is 0) is guaranteed to fit in
+    size_t maxOutputSize(size_t count) const {
+        return maxFramedSize(strategy_, pending_.size() + count, chunkElements_);
+    }
+
+    // Returns bytes written to dst; a tail shorter than a chunk stays pending
+    size_t write(const T* data, size_t count, uint8_t* dst, size_t capacity) {
+        requireCapacity(count, capacity);
+        size_t written = 0;
+        if (!pending_.empty()) {
+            size_t take = std::min(count, chunkElements_ - pending_.size());
+            pending_.insert(pending_.end(), data, data + take);
+            data += take;
+            count -= take;
+            if (pending_.size() < chunkElements_) return 0;
+            written += writeFrame(strategy_, pending_.data(), pending_.size(), dst);
+            pending_.clear();
+        }
+        for (; count >= chunkElements_; data += chunkElements_, count -= chunkElements_) {
+            written += writeFrame(strategy_, data, chunkElements_, dst + written);
+        }
+        pending_.assign(data, data + count);
+        return written;
+    }
+
+    // Emits the pending partial chunk, if any
+    size_t flush(uint8_t* dst, size_t capacity) {
+        requireCapacity(0, capacity);
+        if (pending_.empty()) return 0;
+        size_t written = writeFrame(strategy_, pending_.data(), pending_.size(), dst);
+        pending_.clear();
+        return written;
     }
-    
-    std::string getName() const override { return "Simple Compression"; }
 };
 
+// Decodes every complete frame in [src, src + size) that fits in dst and
+// returns the element count. `consumed` is how many input bytes those
+// frames used; a partial frame at the end is left for the next call.
+template<typename T>
+size_t decompressFrames(const CompressionStrategy<T>& strategy, const uint8_t* src, size_t size,
+                        T* dst, size_t capacity, size_t& consumed) {
+    size_t produced = 0;
+    consumed = 0;
+    while (size - consumed >= kFrameHeaderSize) {
+        const uint8_t* frame = src + consumed;
+        size_t count = codec::loadLE32(frame);
+        size_t payload = codec::loadLE32(frame + 4);
+        if (size - consumed - kFrameHeaderSize < payload || capacity - produced < count) break;
+        strategy.decompress(frame + kFrameHeaderSize, payload, dst + produced, count);
+        produced += count;
+        consumed += kFrameHeaderSize + payload;
+    }
+    return produced;
+}
+
+// Total elements in a complete framed buffer
+inline size_t framedElementCount(const uint8_t* src, size_t size) {
+    size_t total = 0;
+    for (size_t pos = 0; pos < size;) {
+        if (size - pos < kFrameHeaderSize) codec::corrupt("truncated frame header");
+        size_t payload = codec::loadLE32(src + pos + 4);
+        if (size - pos - kFrameHeaderSize < payload) codec::corrupt("truncated frame");
+        total += codec::loadLE32(src + pos);
+        pos += kFrameHeaderSize + payload;
+    }
+    return total;
+}
+
+// --- Block-parallel mode ---
+//
+// Frames are independent, so blocks compress concurrently on the sort
+// pool. Block i writes at i * (worst-case frame size) inside dst itself,
+// then one left-to-right memmove pass closes the gaps. No block ever
+// moves right, so this needs no staging buffer.
+template<typename T>
+size_t compressParallel(const CompressionStrategy<T>& strategy, const T* data, size_t count,
+                        uint8_t* dst, size_t capacity, SortThreadPool& pool, size_t blockElements = 1 << 16) {
+    if (capacity < maxFramedSize(strategy, count, blockElements)) {
+        throw std::length_error("compressParallel: output buffer too small");
+    }
+    size_t blocks = (count + blockElements - 1) / blockElements;
+    size_t stride = kFrameHeaderSize + strategy.maxCompressedSize(blockElements);
+    std::vector<size_t> sizes(blocks);
+    pool.parallelFor(blocks, [&](size_t b) {
+        size_t first = b * blockElements;
+        sizes[b] = writeFrame(strategy, data + first, std::min(blockElements, count - first), dst + b * stride);
+    });
+    size_t written = 0;
+    for (size_t b = 0; b < blocks; ++b) {
+        if (written != b * stride) std::memmove(dst + written, dst + b * stride, sizes[b]);
+        written += sizes[b];
+    }
+    return written;
+}
+
+// Decodes a complete framed buffer into exactly `count` elements. One
+// pass over the headers finds every frame's input and output offset,
+// then the frames decode concurrently.
+template<typename T>
+void decompressParallel(const CompressionStrategy<T>& strategy, const uint8_t* src, size_t size,
+                        T* dst, size_t count, SortThreadPool& pool) {
+    struct Frame {
+        size_t input, payload, output, count;
+    };
+    std::vector<Frame> frames;
+    size_t output = 0;
+    for (size_t pos = 0; pos < size;) {
+        if (size - pos < kFrameHeaderSize) codec::corrupt("truncated frame header");
+        Frame frame{pos + kFrameHeaderSize, codec::loadLE32(src + pos + 4), output, codec::loadLE32(src + pos)};
+        if (size - frame.input < frame.payload) codec::corrupt("truncated frame");
+        if (count - output < frame.count) codec::corrupt("frames overflow output");
+        frames.push_back(frame);
+        output += frame.count;
+        pos = frame.input + frame.payload;
+    }
+    if (output != count) codec::corrupt("element count mismatch");
+
+    // The pool's workers must not unwind, so the first failure is carried
+    // back to the caller
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    pool.parallelFor(frames.size(), [&](size_t f) {
+        try {
+            strategy.decompress(src + frames[f].input, frames[f].payload, dst + frames[f].output, frames[f].count);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) error = std::current_exception();
+        }
+    });
+    if (error) std::rethrow_exception(error);
+}
+
+// Compresses into framed buffers the caller owns. Inputs at or above
+// the parallel threshold go block-parallel; smaller ones are framed on
+// the calling thread. Both produce the same format.
 template<typename T>
 class DataProcessor {
 private:
-    std::unique_ptr<CompressionStrategy<T>> strategy_;
+    std::unique_ptr<CompressionStrategy<T>> strategy_ = std::make_unique<NoCompression<T>>();
+    size_t chunkElements_ = 1 << 14;
+    size_t parallelThreshold_ = 1 << 20;
 
 public:
     void setCompressionStrategy(std::unique_ptr<CompressionStrategy<T>> strategy) {
         strategy_ = std::move(strategy);
     }
-    
-    std::vector<T> processAndCompress(const std::vector<T>& data) {
-        if (strategy_) {
-            std::cout << "Using " << strategy_->getName() << std::endl;
-            return strategy_->compress(data);
+
+    void setParallelThreshold(size_t elements) { parallelThreshold_ = elements; }
+
+    const CompressionStrategy<T>& strategy() const { return *strategy_; }
+
+    size_t maxCompressedSize(size_t count) const { return maxFramedSize(*strategy_, count, chunkElements_); }
+
+    // dst must hold maxCompressedSize(count) bytes; returns bytes written
+    size_t processAndCompress(const T* data, size_t count, uint8_t* dst, size_t capacity) {
+        if (count >= parallelThreshold_) {
+            return compressParallel(*strategy_, data, count, dst, capacity, sortPool(), chunkElements_);
         }
-        return data;
+        StreamCompressor<T> stream(*strategy_, chunkElements_);
+        size_t written = stream.write(data, count, dst, capacity);
+        return written + stream.flush(dst + written, capacity - written);
     }
-    
-    std::vector<T> decompress(const std::vector<T>& data) {
-        if (strategy_) {
-            return strategy_->decompress(data);
+
+    // Reuses `out`'s capacity across calls
+    void processAndCompress(const std::vector<T>& data, std::vector<uint8_t>& out) {
+        out.resize(maxCompressedSize(data.size()));
+        out.resize(processAndCompress(data.data(), data.size(), out.data(), out.size()));
+    }
+
+    // Decodes a complete framed buffer; returns elements written
+    size_t decompress(const uint8_t* src, size_t size, T* dst, size_t capacity) {
+        size_t count = framedElementCount(src, size);
+        if (count > capacity) throw std::length_error("DataProcessor: output buffer too small");
+        if (count >= parallelThreshold_) {
+            decompressParallel(*strategy_, src, size, dst, count, sortPool());
+            return count;
         }
-        return data;
+        size_t consumed = 0;
+        decompressFrames(*strategy_, src, size, dst, count, consumed);
+        return count;
+    }
+
+    void decompress(const std::vector<uint8_t>& in, std::vector<T>& out) {
+        out.resize(framedElementCount(in.data(), in.size()));
+        decompress(in.data(), in.size(), out.data(), out.size());
     }
 };
 
@@ -385,6 +1728,10 @@ void demonstrateBasicStrategy() {
     strategies.push_back(std::make_unique<QuickSort>());
     strategies.push_back(std::make_unique<MergeSort>());
     strategies.push_back(std::make_unique<StdSort>());
+    strategies.push_back(std::make_unique<PdqSort>());
+    strategies.push_back(std::make_unique<RadixSort>());
+    strategies.push_back(std::make_unique<ParallelMergeSort>());
+    strategies.push_back(std::make_unique<AutoSort>());
     
     for (auto& strategy : strategies) {
         auto dataCopy = testData;
@@ -432,29 +1779,54 @@ void demonstrateTemplateStrategy() {
     for (int num : data) {
         std::cout << num << " ";
     }
-    std::cout << " (size: " << data.size() << ")\n\n";
+    std::cout << " (" << data.size() * sizeof(int) << " bytes)\n\n";
     
     DataProcessor<int> processor;
+    std::vector<std::unique_ptr<CompressionStrategy<int>>> strategies;
+    strategies.push_back(std::make_unique<NoCompression<int>>());
+    strategies.push_back(std::make_unique<RleCompression<int>>());
+    strategies.push_back(std::make_unique<DeltaVarintCompression<int>>());
+    strategies.push_back(std::make_unique<Lz4Compression<int>>());
     
-    // No compression
-    std::cout << "--- No Compression Strategy ---" << std::endl;
-    processor.setCompressionStrategy(std::make_unique<NoCompression<int>>());
-    auto result1 = processor.processAndCompress(data);
-    std::cout << "Compressed data: ";
-    for (int num : result1) {
-        std::cout << num << " ";
+    // The output buffers are reused across strategies
+    std::vector<uint8_t> compressed;
+    std::vector<int> restored;
+    for (auto& strategy : strategies) {
+        std::string name = strategy->getName();
+        processor.setCompressionStrategy(std::move(strategy));
+        processor.processAndCompress(data, compressed);
+        processor.decompress(compressed, restored);
+        std::cout << "--- " << name << " ---" << std::endl;
+        std::cout << "Compressed size: " << compressed.size() << " bytes (incl. "
+                  << kFrameHeaderSize << "-byte frame header), round trip "
+                  << (restored == data ? "OK" : "FAILED") << "\n\n";
     }
-    std::cout << " (size: " << result1.size() << ")\n\n";
     
-    // Simple compression
-    std::cout << "--- Simple Compression Strategy ---" << std::endl;
-    processor.setCompressionStrategy(std::make_unique<SimpleCompression<int>>());
-    auto result2 = processor.processAndCompress(data);
-    std::cout << "Compressed data: ";
-    for (int num : result2) {
-        std::cout << num << " ";
+    // Streaming: samples arrive a few at a time, frames leave per chunk
+    std::cout << "--- Streaming Delta+Varint, 4-element chunks ---" << std::endl;
+    DeltaVarintCompression<int> delta;
+    StreamCompressor<int> stream(delta, 4);
+    std::vector<uint8_t> wire(stream.maxOutputSize(data.size()));
+    size_t written = 0;
+    for (size_t i = 0; i < data.size(); i += 3) {
+        size_t n = std::min<size_t>(3, data.size() - i);
+        size_t bytes = stream.write(data.data() + i, n, wire.data() + written, wire.size() - written);
+        std::cout << "write(" << n << ") -> " << bytes << " bytes" << std::endl;
+        written += bytes;
     }
-    std::cout << " (size: " << result2.size() << ")\n\n";
+    written += stream.flush(wire.data() + written, wire.size() - written);
+    
+    // The reader decodes whatever complete frames have arrived
+    std::vector<int> received(data.size());
+    size_t produced = 0, offset = 0;
+    for (size_t arrived : {written / 2, written}) {
+        size_t consumed = 0;
+        produced += decompressFrames(delta, wire.data() + offset, arrived - offset, received.data() + produced,
+                                     received.size() - produced, consumed);
+        offset += consumed;
+        std::cout << "reader saw " << arrived << " bytes -> " << produced << " elements decoded" << std::endl;
+    }
+    std::cout << "Streamed round trip " << (received == data ? "OK" : "FAILED") << "\n\n";
 }
 
 void demonstrateVariantStrategy() {
@@ -528,6 +1900,166 @@ void demonstrateStrategySelection() {
     }
 }
 
+// Benchmark mode: every kernel on several key distributions, then the
+// per-size winners the selector would use for int and float keys
+template <typename T>
+void benchmarkKeyType(const char* label, const std::vector<T>& input) {
+    std::vector<T> expected = input;
+    std::sort(expected.begin(), expected.end());
+    std::printf("  %-22s", label);
+    for (const auto& candidate : sortCandidates<T>()) {
+        std::vector<T> check = input;
+        candidate.sort(check);
+        double ns = sortNsPerKey(input, candidate.sort);
+        std::printf(" %9.2f%s", ns, check == expected ? " " : "!");
+    }
+    std::printf("\n");
+}
+
+void demonstrateSortBenchmark() {
+    std::cout << "=== Sort Strategy Benchmark ===\n\n";
+    
+    // Small-partition kernel: 16-key sorts
+    {
+        constexpr size_t kArrays = 200000;
+        std::vector<int> keys = randomKeys<int>(kArrays * 16, 16);
+        std::vector<int> viaNetwork = keys, viaInsertion = keys;
+        const SmallSortKernel& kernel = smallSortKernel();
+        auto t0 = std::chrono::steady_clock::now();
+        if (kernel.sort) {
+            for (size_t a = 0; a < kArrays; ++a) kernel.sort(viaNetwork.data() + a * 16, 16);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        for (size_t a = 0; a < kArrays; ++a) pdq::insertionSort(viaInsertion.data() + a * 16, viaInsertion.data() + a * 16 + 16);
+        auto t2 = std::chrono::steady_clock::now();
+        std::printf("16-key sorts: %s %.1f ns, insertion sort %.1f ns (%s)\n\n", kernel.name,
+                    std::chrono::duration<double, std::nano>(t1 - t0).count() / kArrays,
+                    std::chrono::duration<double, std::nano>(t2 - t1).count() / kArrays,
+                    !kernel.sort || viaNetwork == viaInsertion ? "results match" : "MISMATCH");
+    }
+    
+    std::cout << "ns/key (\"!\" marks a wrong result), " << sortPool().concurrency() << " thread(s):\n";
+    std::printf("  %-22s %10s %10s %10s %10s\n", "input", "pdqsort", "std::sort", "LSD radix", "par. merge");
+    for (size_t n : {size_t(10000), size_t(1) << 20}) {
+        std::printf("  n = %zu\n", n);
+        benchmarkKeyType("int32 uniform", randomKeys<int>(n, 1));
+        
+        std::vector<int> fewUnique = randomKeys<int>(n, 2);
+        for (int& key : fewUnique) key &= 15;
+        benchmarkKeyType("int32 16 distinct", fewUnique);
+        
+        std::vector<int> nearlySorted(n);
+        for (size_t i = 0; i < n; ++i) nearlySorted[i] = static_cast<int>(i);
+        for (size_t i = 0; i < n / 100; ++i) std::swap(nearlySorted[(i * 7919) % n], nearlySorted[(i * 104729) % n]);
+        benchmarkKeyType("int32 1% swapped", nearlySorted);
+        
+        benchmarkKeyType("float uniform", randomKeys<float>(n, 3));
+        benchmarkKeyType("int64 uniform", randomKeys<int64_t>(n, 4));
+    }
+    
+    std::cout << "\nSelector calibration (fastest kernel per size):\n int32:\n";
+    SortSelector<int> intSelector(sortCandidates<int>());
+    intSelector.calibrate(1 << 21, &std::cout);
+    std::cout << " float:\n";
+    SortSelector<float> floatSelector(sortCandidates<float>());
+    floatSelector.calibrate(1 << 21, &std::cout);
+    std::cout << std::endl;
+}
+
+// Compression benchmark: ratio and MB/s (of uncompressed data) for each
+// codec on telemetry-shaped inputs, through the streaming path on one
+// thread and through the block-parallel path on the pool
+double bestSeconds(int runs, const std::function<void()>& body) {
+    double best = 1e300;
+    for (int r = 0; r < runs; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+template <typename T>
+void benchmarkCodec(const char* label, const CompressionStrategy<T>& strategy, const std::vector<T>& input) {
+    constexpr size_t kChunk = 1 << 16;
+    const double megabytes = static_cast<double>(input.size() * sizeof(T)) / 1e6;
+    std::vector<uint8_t> compressed(maxFramedSize(strategy, input.size(), kChunk));
+    std::vector<T> restored(input.size());
+    size_t bytes = 0;
+    
+    double streamCompress = bestSeconds(5, [&] {
+        StreamCompressor<T> stream(strategy, kChunk);
+        bytes = stream.write(input.data(), input.size(), compressed.data(), compressed.size());
+        bytes += stream.flush(compressed.data() + bytes, compressed.size() - bytes);
+    });
+    double streamDecompress = bestSeconds(5, [&] {
+        size_t consumed = 0;
+        decompressFrames(strategy, compressed.data(), bytes, restored.data(), restored.size(), consumed);
+    });
+    bool ok = restored == input;
+    
+    double parallelCompress = bestSeconds(5, [&] {
+        bytes = compressParallel(strategy, input.data(), input.size(), compressed.data(), compressed.size(),
+                                 sortPool(), kChunk);
+    });
+    std::fill(restored.begin(), restored.end(), T{});
+    double parallelDecompress = bestSeconds(5, [&] {
+        decompressParallel(strategy, compressed.data(), bytes, restored.data(), restored.size(), sortPool());
+    });
+    ok = ok && restored == input;
+    
+    std::printf("  %-18s %-15s %6.2fx %9.0f %9.0f %9.0f %9.0f %s\n", label, strategy.getName().c_str(),
+                megabytes * 1e6 / static_cast<double>(bytes), megabytes / streamCompress,
+                megabytes / streamDecompress, megabytes / parallelCompress, megabytes / parallelDecompress,
+                ok ? "" : "ROUND TRIP FAILED");
+}
+
+void demonstrateCompressionBenchmark() {
+    std::cout << "=== Compression Strategy Benchmark ===\n\n";
+    constexpr size_t kSamples = 1 << 22;
+    std::mt19937 gen(42);
+    
+    // Monotonic counter with small increments (bytes sent, request ids)
+    std::vector<int64_t> counter(kSamples);
+    std::uniform_int_distribution<int> step(0, 40);
+    for (size_t i = 1; i < kSamples; ++i) counter[i] = counter[i - 1] + step(gen);
+    
+    // Gauge that holds each reading for a while (queue depth, status code)
+    std::vector<int32_t> gauge(kSamples);
+    std::uniform_int_distribution<int> hold(1, 64), level(0, 500);
+    for (size_t i = 0; i < kSamples;) {
+        int value = level(gen);
+        for (int h = hold(gen); h > 0 && i < kSamples; --h) gauge[i++] = value;
+    }
+    
+    // Log lines: fixed templates with varying numbers
+    std::vector<uint8_t> logText;
+    static const char* const kTemplates[] = {
+        "INFO  request served path=/api/v1/orders status=200 latency_us=%d\n",
+        "WARN  slow upstream host=db-%d.internal retry=1\n",
+        "INFO  cache hit key=session:%d ttl=300\n",
+    };
+    std::uniform_int_distribution<int> pick(0, 2), number(0, 99999);
+    char line[128];
+    while (logText.size() < kSamples * 4) {
+        int length = std::snprintf(line, sizeof(line), kTemplates[pick(gen)], number(gen));
+        logText.insert(logText.end(), line, line + length);
+    }
+    
+    std::cout << sortPool().concurrency() << " thread(s); MB/s of uncompressed data\n";
+    std::printf("  %-18s %-15s %7s %9s %9s %9s %9s\n", "input", "codec", "ratio", "stream-c", "stream-d",
+                "par-c", "par-d");
+    benchmarkCodec("int64 counter", NoCompression<int64_t>(), counter);
+    benchmarkCodec("int64 counter", DeltaVarintCompression<int64_t>(), counter);
+    benchmarkCodec("int64 counter", Lz4Compression<int64_t>(), counter);
+    benchmarkCodec("int32 held gauge", RleCompression<int32_t>(), gauge);
+    benchmarkCodec("int32 held gauge", DeltaVarintCompression<int32_t>(), gauge);
+    benchmarkCodec("int32 held gauge", Lz4Compression<int32_t>(), gauge);
+    benchmarkCodec("log text", RleCompression<uint8_t>(), logText);
+    benchmarkCodec("log text", Lz4Compression<uint8_t>(), logText);
+    std::cout << std::endl;
+}
+
 void demonstrateStrategyPattern() {
     std::cout << "=== Strategy Pattern Demonstration ===\n\n";
     
@@ -536,6 +2068,8 @@ void demonstrateStrategyPattern() {
     demonstrateTemplateStrategy();
     demonstrateVariantStrategy();
     demonstrateStrategySelection();
+    demonstrateSortBenchmark();
+    demonstrateCompressionBenchmark();
     
     std::cout << "=== Strategy Pattern Benefits ===\n";
     std::cout << "✓ Algorithms can be switched at runtime\n";
@@ -544,6 +2078,7 @@ void demonstrateStrategyPattern() {
     std::cout << "✓ Each strategy is independently testable\n";
     std::cout << "✓ Follows Open/Closed Principle\n";
     std::cout << "✓ Supports both inheritance and functional approaches\n";
+    std::cout << "✓ A selector can pick the strategy from measurements instead of guesses\n";
 }
 
 int main() {
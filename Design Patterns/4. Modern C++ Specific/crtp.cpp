@@ -3,6 +3,17 @@
 #include <vector>
 #include <string>
 #include <type_traits>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
 
 // CRTP - Curiously Recurring Template Pattern
 // Base template class that takes derived class as template parameter
@@ -24,9 +35,13 @@ public:
                   << ", Area: " << area() << std::endl;
     }
     
-    // Static interface checking
-    static_assert(std::is_base_of_v<Shape<Derived>, Derived>, 
-                  "Derived must inherit from Shape<Derived>");
+protected:
+    // Static interface checking. In a member function body, because
+    // Derived is still incomplete while the class body is instantiated.
+    Shape() {
+        static_assert(std::is_base_of_v<Shape<Derived>, Derived>, 
+                      "Derived must inherit from Shape<Derived>");
+    }
 };
 
 class Circle : public Shape<Circle> {
@@ -143,13 +158,18 @@ class Logger : public Singleton<Logger> {
     
 private:
     Logger() {
-        std::cout << "Logger instance created" << std::endl;
+        std::cout << "Logger instance created\n";
     }
 
 public:
+    // '\n' rather than std::endl: lines collect in std::cout's buffer and
+    // reach the terminal in one write instead of one flush per message.
+    // For a logger shared by threads see AsyncLogBackend in singleton.cpp.
     void log(const std::string& message) {
-        std::cout << "[LOG]: " << message << std::endl;
+        std::cout << "[LOG]: " << message << '\n';
     }
+
+    void flush() { std::cout.flush(); }
 };
 
 class ConfigManager : public Singleton<ConfigManager> {
@@ -347,50 +367,188 @@ public:
     }
 };
 
-// Template specialization using CRTP
-template<>
-class Shape<Circle> {
-public:
-    void draw() {
-        static_cast<Circle*>(this)->drawImpl();
-    }
-    
-    double area() {
-        return static_cast<Circle*>(this)->areaImpl();
-    }
-    
-    // Specialized behavior for circles
-    void drawWithBorder() {
-        std::cout << "Drawing circle with decorative border" << std::endl;
-        static_cast<Circle*>(this)->drawImpl();
-    }
-};
-
 // Example 8: CRTP for Expression Templates (Advanced)
+//
+// `a + b * 2.0 - c` builds a tree of small nodes instead of temporary
+// vectors. Nothing is computed until the tree is assigned to a Vector or
+// reduced by sum()/dot()/norm(). The kernel then makes one pass over
+// memory: each node has a scalar operator[] and a SIMD packet(), so the
+// whole tree inlines into one vector loop. Nodes hold named Vectors by
+// reference and everything else by value. Temporaries, both sub-trees
+// and `Vector` rvalues, are moved into the tree, so `auto e = f() + v;`
+// cannot dangle.
 template<typename Derived>
 class Expression {
 public:
     const Derived& derived() const {
         return static_cast<const Derived&>(*this);
     }
-    
+
     Derived& derived() {
         return static_cast<Derived&>(*this);
     }
 };
 
+// Packet width is fixed at compile time, as in Eigen: 2 doubles with
+// plain SSE2, 4 with -mavx, 8 with -mavx512f
+#if defined(__AVX512F__)
+constexpr size_t kPacketBytes = 64;
+#elif defined(__AVX__)
+constexpr size_t kPacketBytes = 32;
+#else
+constexpr size_t kPacketBytes = 16;
+#endif
+using Packet = double __attribute__((vector_size(kPacketBytes)));
+constexpr size_t kPacketLanes = kPacketBytes / sizeof(double);
+
+inline Packet loadPacket(const double* p) {
+    Packet v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void storePacket(double* p, Packet v) {
+    std::memcpy(p, &v, sizeof(v));
+}
+
+inline double horizontalSum(Packet v) {
+    double total = 0;
+    for (size_t lane = 0; lane < kPacketLanes; ++lane) total += v[lane];
+    return total;
+}
+
+// Fork-join loop for the evaluation kernels: `threads` threads, the
+// caller included, claim indices from a shared counter. Threads start and
+// join on every call, which a 1M-element kernel easily amortizes. The
+// persistent pool is SortThreadPool in Design Patterns/3. Behavioral/strategy.cpp.
+inline void parallelFor(size_t count, size_t threads, const std::function<void(size_t)>& body) {
+    std::atomic<size_t> next{0};
+    auto run = [&] {
+        size_t i;
+        while ((i = next.fetch_add(1, std::memory_order_relaxed)) < count) body(i);
+    };
+    std::vector<std::thread> helpers;
+    for (size_t t = 1; t < std::min(threads, count); ++t) helpers.emplace_back(run);
+    run();
+    for (auto& helper : helpers) helper.join();
+}
+
+// Kernels work block by block. 4096 doubles is 32 KB per operand, so a
+// block is big enough to amortize scheduling and small enough that a
+// reduction's partial sums come out in a fixed order. That makes
+// results bit-identical for any thread count. Inputs below the parallel
+// threshold stay on the calling thread whatever `threads` says.
+constexpr size_t kExprBlockElements = 4096;
+constexpr size_t kExprParallelThreshold = 1 << 16;
+
+template<typename E>
+void evaluateInto(double* out, const E& expr, size_t n, size_t threads) {
+    auto block = [&](size_t b) {
+        size_t i = b * kExprBlockElements;
+        size_t end = std::min(n, i + kExprBlockElements);
+        for (; i + kPacketLanes <= end; i += kPacketLanes) storePacket(out + i, expr.packet(i));
+        for (; i < end; ++i) out[i] = expr[i];
+    };
+    size_t blocks = (n + kExprBlockElements - 1) / kExprBlockElements;
+    if (threads > 1 && n >= kExprParallelThreshold) {
+        parallelFor(blocks, threads, block);
+    } else {
+        for (size_t b = 0; b < blocks; ++b) block(b);
+    }
+}
+
+// Four independent accumulators hide the latency of the vector adds
+template<typename E>
+double sumBlock(const E& expr, size_t begin, size_t end) {
+    Packet acc0{}, acc1{}, acc2{}, acc3{};
+    size_t i = begin;
+    for (; i + 4 * kPacketLanes <= end; i += 4 * kPacketLanes) {
+        acc0 += expr.packet(i);
+        acc1 += expr.packet(i + kPacketLanes);
+        acc2 += expr.packet(i + 2 * kPacketLanes);
+        acc3 += expr.packet(i + 3 * kPacketLanes);
+    }
+    for (; i + kPacketLanes <= end; i += kPacketLanes) acc0 += expr.packet(i);
+    double total = horizontalSum((acc0 + acc1) + (acc2 + acc3));
+    for (; i < end; ++i) total += expr[i];
+    return total;
+}
+
+template<typename E>
+double sumExpression(const E& expr, size_t n, size_t threads) {
+    size_t blocks = (n + kExprBlockElements - 1) / kExprBlockElements;
+    std::vector<double> partials(blocks);
+    auto block = [&](size_t b) {
+        partials[b] = sumBlock(expr, b * kExprBlockElements, std::min(n, (b + 1) * kExprBlockElements));
+    };
+    if (threads > 1 && n >= kExprParallelThreshold) {
+        parallelFor(blocks, threads, block);
+    } else {
+        for (size_t b = 0; b < blocks; ++b) block(b);
+    }
+    double total = 0;
+    for (double partial : partials) total += partial;
+    return total;
+}
+
 class Vector : public Expression<Vector> {
 private:
     std::vector<double> data_;
 
 public:
+    static constexpr bool kIsScalar = false;
+
     explicit Vector(std::vector<double> data) : data_(std::move(data)) {}
-    
+    explicit Vector(size_t n, double value = 0.0) : data_(n, value) {}
+
+    // Evaluates the whole expression in one pass
+    template<typename E>
+    Vector(const Expression<E>& expr) : data_(expr.derived().size()) {
+        evaluateInto(data_.data(), expr.derived(), data_.size(), 1);
+    }
+
+    Vector(const Vector&) = default;
+    Vector(Vector&&) noexcept = default;
+    Vector& operator=(const Vector&) = default;
+    Vector& operator=(Vector&&) noexcept = default;
+
+    template<typename E>
+    Vector& operator=(const Expression<E>& expr) {
+        return assign(expr);
+    }
+
+    // Reuses this vector's storage. With threads > 1, large inputs are
+    // evaluated block-parallel. `v.assign(v * 2.0 + w)` is safe: element
+    // i is read only while element i is being written.
+    template<typename E>
+    Vector& assign(const Expression<E>& expr, size_t threads = 1) {
+        const E& e = expr.derived();
+        data_.resize(e.size());
+        evaluateInto(data_.data(), e, data_.size(), threads);
+        return *this;
+    }
+
+    template<typename E>
+    Vector& operator+=(const E& rhs);
+    template<typename E>
+    Vector& operator-=(const E& rhs);
+    template<typename E>
+    Vector& operator*=(const E& rhs);
+
     double operator[](size_t i) const { return data_[i]; }
     double& operator[](size_t i) { return data_[i]; }
-    
+    // Kernels only ask for whole packets inside the vector. Stating that
+    // lets GCC drop the packet path for a short vector of known size,
+    // instead of warning (-Warray-bounds) about a load it never runs.
+    Packet packet(size_t i) const {
+        if (i + kPacketLanes > data_.size()) __builtin_unreachable();
+        return loadPacket(data_.data() + i);
+    }
+
     size_t size() const { return data_.size(); }
-    
+    const double* data() const { return data_.data(); }
+    double* data() { return data_.data(); }
+
     void print() const {
         std::cout << "[";
         for (size_t i = 0; i < data_.size(); ++i) {
@@ -401,27 +559,166 @@ public:
     }
 };
 
-template<typename LHS, typename RHS>
-class VectorAdd : public Expression<VectorAdd<LHS, RHS>> {
+// A scalar operand, broadcast to every element
+class Scalar : public Expression<Scalar> {
 private:
-    const LHS& lhs_;
-    const RHS& rhs_;
+    double value_;
+    Packet broadcast_;
 
 public:
-    VectorAdd(const LHS& lhs, const RHS& rhs) : lhs_(lhs), rhs_(rhs) {}
-    
-    double operator[](size_t i) const {
-        return lhs_[i] + rhs_[i];
-    }
-    
-    size_t size() const {
-        return lhs_.size();
+    static constexpr bool kIsScalar = true;
+
+    Scalar(double value) : value_(value), broadcast_(Packet{} + value) {}
+
+    double operator[](size_t) const { return value_; }
+    Packet packet(size_t) const { return broadcast_; }
+    size_t size() const { return 0; }  // Takes the size of the other operand
+};
+
+struct AddOp {
+    template<typename V> static V apply(V a, V b) { return a + b; }
+};
+struct SubOp {
+    template<typename V> static V apply(V a, V b) { return a - b; }
+};
+struct MulOp {
+    template<typename V> static V apply(V a, V b) { return a * b; }
+};
+struct DivOp {
+    template<typename V> static V apply(V a, V b) { return a / b; }
+};
+struct NegOp {
+    template<typename V> static V apply(V a) { return -a; }
+};
+struct SquareOp {
+    template<typename V> static V apply(V a) { return a * a; }
+};
+
+// How a node stores an operand: named Vectors by reference, everything
+// else (numbers, sub-trees, Vector temporaries) by value
+template<typename T>
+using OperandStorage = std::conditional_t<
+    std::is_arithmetic_v<std::decay_t<T>>, Scalar,
+    std::conditional_t<std::is_same_v<std::decay_t<T>, Vector> && std::is_lvalue_reference_v<T>,
+                       const Vector&, std::decay_t<T>>>;
+
+template<typename Op, typename LHS, typename RHS>
+class VectorBinary : public Expression<VectorBinary<Op, LHS, RHS>> {
+private:
+    LHS lhs_;
+    RHS rhs_;
+    size_t size_;
+
+public:
+    static constexpr bool kIsScalar = false;
+
+    template<typename L, typename R>
+    VectorBinary(L&& lhs, R&& rhs)
+        : lhs_(std::forward<L>(lhs)), rhs_(std::forward<R>(rhs)),
+          size_(std::decay_t<LHS>::kIsScalar ? rhs_.size() : lhs_.size()) {
+        if (!std::decay_t<LHS>::kIsScalar && !std::decay_t<RHS>::kIsScalar && lhs_.size() != rhs_.size()) {
+            throw std::invalid_argument("vector expression: operand sizes differ");
+        }
     }
+
+    double operator[](size_t i) const { return Op::apply(lhs_[i], rhs_[i]); }
+    Packet packet(size_t i) const { return Op::apply(lhs_.packet(i), rhs_.packet(i)); }
+    size_t size() const { return size_; }
+};
+
+template<typename Op, typename E>
+class VectorUnary : public Expression<VectorUnary<Op, E>> {
+private:
+    E operand_;
+
+public:
+    static constexpr bool kIsScalar = false;
+
+    template<typename T>
+    explicit VectorUnary(T&& operand) : operand_(std::forward<T>(operand)) {}
+
+    double operator[](size_t i) const { return Op::apply(operand_[i]); }
+    Packet packet(size_t i) const { return Op::apply(operand_.packet(i)); }
+    size_t size() const { return operand_.size(); }
 };
 
 template<typename LHS, typename RHS>
-VectorAdd<LHS, RHS> operator+(const Expression<LHS>& lhs, const Expression<RHS>& rhs) {
-    return VectorAdd<LHS, RHS>(lhs.derived(), rhs.derived());
+using VectorAdd = VectorBinary<AddOp, LHS, RHS>;
+
+template<typename T>
+constexpr bool kIsExpression = std::is_base_of_v<Expression<std::decay_t<T>>, std::decay_t<T>>;
+
+// At least one side must be an expression; the other may be a number
+template<typename L, typename R>
+constexpr bool kIsOperandPair = (kIsExpression<L> || kIsExpression<R>) &&
+                                (kIsExpression<L> || std::is_arithmetic_v<std::decay_t<L>>) &&
+                                (kIsExpression<R> || std::is_arithmetic_v<std::decay_t<R>>);
+
+template<typename Op, typename L, typename R>
+auto makeBinary(L&& lhs, R&& rhs) {
+    return VectorBinary<Op, OperandStorage<L>, OperandStorage<R>>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template<typename L, typename R, typename = std::enable_if_t<kIsOperandPair<L, R>>>
+auto operator+(L&& lhs, R&& rhs) {
+    return makeBinary<AddOp>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template<typename L, typename R, typename = std::enable_if_t<kIsOperandPair<L, R>>>
+auto operator-(L&& lhs, R&& rhs) {
+    return makeBinary<SubOp>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template<typename L, typename R, typename = std::enable_if_t<kIsOperandPair<L, R>>>
+auto operator*(L&& lhs, R&& rhs) {
+    return makeBinary<MulOp>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template<typename L, typename R, typename = std::enable_if_t<kIsOperandPair<L, R>>>
+auto operator/(L&& lhs, R&& rhs) {
+    return makeBinary<DivOp>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template<typename E, typename = std::enable_if_t<kIsExpression<E>>>
+auto operator-(E&& operand) {
+    return VectorUnary<NegOp, OperandStorage<E>>(std::forward<E>(operand));
+}
+
+template<typename E, typename = std::enable_if_t<kIsExpression<E>>>
+auto squared(E&& operand) {
+    return VectorUnary<SquareOp, OperandStorage<E>>(std::forward<E>(operand));
+}
+
+template<typename E>
+Vector& Vector::operator+=(const E& rhs) {
+    return assign(*this + rhs);
+}
+
+template<typename E>
+Vector& Vector::operator-=(const E& rhs) {
+    return assign(*this - rhs);
+}
+
+template<typename E>
+Vector& Vector::operator*=(const E& rhs) {
+    return assign(*this * rhs);
+}
+
+// Reductions evaluate the tree inside the accumulation loop, so
+// dot(a - b, c) or norm(x - y) never materializes a vector
+template<typename E>
+double sum(const Expression<E>& expr, size_t threads = 1) {
+    return sumExpression(expr.derived(), expr.derived().size(), threads);
+}
+
+template<typename L, typename R>
+double dot(const Expression<L>& lhs, const Expression<R>& rhs, size_t threads = 1) {
+    return sum(lhs.derived() * rhs.derived(), threads);
+}
+
+template<typename E>
+double norm(const Expression<E>& expr, size_t threads = 1) {
+    return std::sqrt(sum(squared(expr.derived()), threads));
 }
 
 void demonstrateBasicCRTP() {
@@ -563,9 +860,90 @@ void demonstrateExpressionTemplates() {
         if (i < result.size() - 1) std::cout << ", ";
     }
     std::cout << "]" << std::endl;
+    
+    Vector mixed = (v1 + v2) * 2.0 - v3 / 4.0;
+    std::cout << "(v1 + v2) * 2 - v3 / 4: ";
+    mixed.print();
+    
+    // The temporary Vector is moved into the tree, so this does not dangle
+    auto owning = Vector({10.0, 20.0, 30.0}) - v1;
+    Vector fromTemporary = owning;
+    std::cout << "Vector({10, 20, 30}) - v1: ";
+    fromTemporary.print();
+    
+    std::cout << "dot(v1, v2) = " << dot(v1, v2) << ", norm(v2 - v1) = " << norm(v2 - v1)
+              << ", sum(-v3) = " << sum(-v3) << std::endl;
     std::cout << std::endl;
 }
 
+// Risk-style workload: mark-to-market P&L over n positions, then its
+// size-weighted total. The "eager" version is what an operator+ that
+// returns std::vector costs: one temporary per operation.
+std::vector<double> eagerOp(const std::vector<double>& a, const std::vector<double>& b, char op) {
+    std::vector<double> out(a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        switch (op) {
+            case '+': out[i] = a[i] + b[i]; break;
+            case '-': out[i] = a[i] - b[i]; break;
+            default: out[i] = a[i] * b[i]; break;
+        }
+    }
+    return out;
+}
+
+void demonstrateExpressionTemplateBenchmark() {
+    std::cout << "=== Expression Template Evaluation Benchmark ===\n\n";
+    constexpr size_t n = 1 << 22;
+    constexpr int kRuns = 5;
+    
+    std::vector<double> raw(n);
+    for (size_t i = 0; i < n; ++i) raw[i] = 1.0 + static_cast<double>(i % 1000) * 1e-3;
+    Vector price(raw), cost(raw), quantity(raw), fx(raw), pnl(n);
+    for (size_t i = 0; i < n; ++i) cost[i] *= 0.97;
+    std::vector<double> priceRaw(price.data(), price.data() + n), costRaw(cost.data(), cost.data() + n);
+    std::vector<double> quantityRaw = raw, fxRaw = raw;
+    
+    auto best = [&](const std::function<void()>& body) {
+        double ms = 1e300;
+        for (int r = 0; r < kRuns; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            body();
+            ms = std::min(ms, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        return ms;
+    };
+    
+    const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    double eagerTotal = 0, serialTotal = 0, parallelTotal = 0;
+    
+    double eager = best([&] {
+        auto spread = eagerOp(priceRaw, costRaw, '-');
+        auto notional = eagerOp(spread, quantityRaw, '*');
+        auto local = eagerOp(notional, fxRaw, '*');
+        auto weighted = eagerOp(local, quantityRaw, '*');
+        eagerTotal = 0;
+        for (double w : weighted) eagerTotal += w;
+    });
+    double serial = best([&] {
+        pnl.assign((price - cost) * quantity * fx);
+        serialTotal = dot(pnl, quantity);
+    });
+    double fused = best([&] { serialTotal = dot((price - cost) * quantity * fx, quantity); });
+    double parallel = best([&] {
+        pnl.assign((price - cost) * quantity * fx, threads);
+        parallelTotal = dot(pnl, quantity, threads);
+    });
+    
+    std::printf("n = %zu doubles, %zu-lane packets, %zu thread(s), best of %d\n", n, kPacketLanes,
+                threads, kRuns);
+    std::printf("  eager std::vector temporaries   %8.2f ms\n", eager);
+    std::printf("  expression template, serial     %8.2f ms\n", serial);
+    std::printf("  fused dot, no pnl vector        %8.2f ms\n", fused);
+    std::printf("  expression template, parallel   %8.2f ms\n", parallel);
+    std::printf("  totals: eager %.6e, serial %.6e, parallel %.6e (serial == parallel: %s)\n\n", eagerTotal,
+                serialTotal, parallelTotal, serialTotal == parallelTotal ? "yes" : "no");
+}
+
 void demonstrateCRTPBenefits() {
     std::cout << "=== CRTP Benefits Demonstration ===\n\n";
     
@@ -600,6 +978,7 @@ void demonstrateCRTP() {
     demonstrateInstanceCounting();
     demonstrateMixins();
     demonstrateExpressionTemplates();
+    demonstrateExpressionTemplateBenchmark();
     demonstrateCRTPBenefits();
 }
 
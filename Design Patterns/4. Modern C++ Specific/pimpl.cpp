@@ -208,10 +208,14 @@ public:
 
 class LoggerImpl {
 public:
+    // No std::endl: a flush per line would cost a write() per message.
+    // The impl owns the line format, so callers never see the change.
     void log(const std::string& message) {
-        std::cout << "[LOG]: " << message << std::endl;
+        std::cout << "[LOG]: " << message << '\n';
     }
     
+    void flush() { std::cout.flush(); }
+    
     void setLevel(int level) { level_ = level; }
     int getLevel() const { return level_; }
 
@@ -222,6 +226,7 @@ private:
 class Logger : public PimplBase<LoggerImpl> {
 public:
     void log(const std::string& message) { pImpl->log(message); }
+    void flush() { pImpl->flush(); }
     void setLevel(int level) { pImpl->setLevel(level); }
     int getLevel() const { return pImpl->getLevel(); }
 };
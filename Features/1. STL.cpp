@@ -8,7 +8,6 @@
 #include <unordered_map>
 #include <stack>
 #include <queue>
-#include <priority_queue>
 #include <algorithm>
 #include <numeric>
 #include <iterator>
@@ -17,6 +16,16 @@
 #include <memory>
 #include <chrono>
 #include <random>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 /*
  * COMPREHENSIVE C++ STL DEMONSTRATION
@@ -714,6 +723,768 @@ void demonstrateRealWorldExamples() {
     }
 }
 
+// =============================================================================
+// 11. FLAT CONTAINERS
+// =============================================================================
+//
+// Node-based containers (map, unordered_map) allocate every element
+// separately, and every lookup follows pointers to a node somewhere in the
+// heap. The containers below keep elements in contiguous arrays:
+// - FlatHashMap: SwissTable-style open addressing. One control byte per
+//   slot holds 7 bits of the hash, and a lookup compares 16 control
+//   bytes at once with SSE2 before touching any key.
+// - FlatMap / FlatSet: sorted vectors. Lookup is a binary search over
+//   contiguous keys, iteration is a linear scan, and an insert costs
+//   O(n). They suit read-mostly tables that are built once.
+// - ConcurrentFlatMap: FlatHashMaps in cache-line-aligned shards, each
+//   with its own reader-writer lock. Threads contend only when they touch
+//   the same shard.
+
+// libstdc++'s std::hash<integer> is the identity. Open addressing needs
+// every bit mixed, so both the slot (high bits) and the control byte
+// (low 7 bits) are taken from this finalizer's output.
+inline uint64_t hashMix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Bitmask queries over 16 control bytes; bit i stands for slot i
+struct ControlGroup {
+    static constexpr size_t kWidth = 16;
+
+#if defined(__SSE2__)
+    __m128i bytes;
+    explicit ControlGroup(const int8_t* ctrl) : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+    uint32_t match(int8_t h2) const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(h2))));
+    }
+    // Empty and deleted bytes are negative, full ones are 0..127
+    uint32_t matchEmptyOrDeleted() const { return static_cast<uint32_t>(_mm_movemask_epi8(bytes)); }
+#else
+    const int8_t* bytes;
+    explicit ControlGroup(const int8_t* ctrl) : bytes(ctrl) {}
+    uint32_t match(int8_t h2) const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kWidth; ++i) mask |= uint32_t(bytes[i] == h2) << i;
+        return mask;
+    }
+    uint32_t matchEmptyOrDeleted() const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kWidth; ++i) mask |= uint32_t(bytes[i] < 0) << i;
+        return mask;
+    }
+#endif
+};
+
+template<typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>>
+class FlatHashMap {
+public:
+    // Keys must not be modified through iterators
+    using value_type = std::pair<K, V>;
+
+private:
+    static constexpr int8_t kEmpty = -128;
+    static constexpr int8_t kDeleted = -2;
+    static constexpr size_t kGroup = ControlGroup::kWidth;
+    static constexpr size_t npos = ~size_t(0);
+
+    int8_t* ctrl_ = nullptr;
+    value_type* slots_ = nullptr;
+    size_t capacity_ = 0;     // 0, or a power of two >= kGroup
+    size_t size_ = 0;
+    size_t growthLeft_ = 0;   // Empty slots that may still be filled before a rehash (7/8 max load)
+    Hash hash_;
+    Eq eq_;
+
+    uint64_t hashOf(const K& key) const { return hashMix(static_cast<uint64_t>(hash_(key))); }
+    static int8_t h2(uint64_t h) { return static_cast<int8_t>(h & 0x7F); }
+    static uint32_t lowestBit(uint32_t mask) { return static_cast<uint32_t>(__builtin_ctz(mask)); }
+
+    // Probing visits whole groups in triangular order (g, g+1, g+3, ...),
+    // which reaches every group of a power-of-two table. It stops at the
+    // first group with an empty slot: an insert would have used that slot
+    // before moving on.
+    size_t findIndex(const K& key, uint64_t h) const {
+        if (capacity_ == 0) return npos;
+        size_t mask = capacity_ / kGroup - 1;
+        size_t group = (h >> 7) & mask;
+        for (size_t step = 1;; ++step) {
+            const int8_t* ctrl = ctrl_ + group * kGroup;
+            ControlGroup g(ctrl);
+            for (uint32_t m = g.match(h2(h)); m; m &= m - 1) {
+                size_t i = group * kGroup + lowestBit(m);
+                if (eq_(slots_[i].first, key)) return i;
+            }
+            if (g.match(kEmpty)) return npos;
+            group = (group + step) & mask;
+        }
+    }
+
+    size_t findInsertSlot(uint64_t h) const {
+        size_t mask = capacity_ / kGroup - 1;
+        size_t group = (h >> 7) & mask;
+        for (size_t step = 1;; ++step) {
+            uint32_t m = ControlGroup(ctrl_ + group * kGroup).matchEmptyOrDeleted();
+            if (m) return group * kGroup + lowestBit(m);
+            group = (group + step) & mask;
+        }
+    }
+
+    void rehash(size_t newCapacity) {
+        int8_t* oldCtrl = ctrl_;
+        value_type* oldSlots = slots_;
+        size_t oldCapacity = capacity_;
+
+        ctrl_ = new int8_t[newCapacity];
+        std::fill_n(ctrl_, newCapacity, kEmpty);
+        slots_ = std::allocator<value_type>().allocate(newCapacity);
+        capacity_ = newCapacity;
+        growthLeft_ = newCapacity - newCapacity / 8 - size_;
+
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldCtrl[i] < 0) continue;
+            uint64_t h = hashOf(oldSlots[i].first);
+            size_t slot = findInsertSlot(h);
+            new (&slots_[slot]) value_type(std::move(oldSlots[i]));
+            ctrl_[slot] = h2(h);
+            oldSlots[i].~value_type();
+        }
+        delete[] oldCtrl;
+        if (oldSlots) std::allocator<value_type>().deallocate(oldSlots, oldCapacity);
+    }
+
+    static size_t capacityFor(size_t count) {
+        size_t capacity = kGroup;
+        while (capacity - capacity / 8 < count) capacity *= 2;
+        return capacity;
+    }
+
+    template<typename KeyArg, typename... Args>
+    std::pair<value_type*, bool> emplaceKey(KeyArg&& key, Args&&... args) {
+        uint64_t h = hashOf(key);
+        size_t i = findIndex(key, h);
+        if (i != npos) return {&slots_[i], false};
+        if (growthLeft_ == 0) {
+            // Mostly tombstones: clean up in place; otherwise grow
+            rehash(capacity_ == 0 ? kGroup : size_ < capacity_ / 2 ? capacity_ : capacity_ * 2);
+        }
+        i = findInsertSlot(h);
+        new (&slots_[i]) value_type(std::piecewise_construct, std::forward_as_tuple(std::forward<KeyArg>(key)),
+                                    std::forward_as_tuple(std::forward<Args>(args)...));
+        if (ctrl_[i] == kEmpty) --growthLeft_;
+        ctrl_[i] = h2(h);
+        ++size_;
+        return {&slots_[i], true};
+    }
+
+public:
+    template<bool Const>
+    class Iterator {
+        using Map = std::conditional_t<Const, const FlatHashMap, FlatHashMap>;
+        Map* map_;
+        size_t index_;
+
+        void skipFree() {
+            while (index_ < map_->capacity_ && map_->ctrl_[index_] < 0) ++index_;
+        }
+
+    public:
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+        Iterator(Map* map, size_t index) : map_(map), index_(index) { skipFree(); }
+        reference operator*() const { return map_->slots_[index_]; }
+        auto* operator->() const { return &map_->slots_[index_]; }
+        Iterator& operator++() {
+            ++index_;
+            skipFree();
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const Iterator& other) const { return index_ != other.index_; }
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashMap() = default;
+
+    FlatHashMap(const FlatHashMap& other) : hash_(other.hash_), eq_(other.eq_) {
+        reserve(other.size_);
+        for (const auto& [key, value] : other) emplaceKey(key, value);
+    }
+
+    FlatHashMap(FlatHashMap&& other) noexcept { swap(other); }
+
+    FlatHashMap& operator=(FlatHashMap other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~FlatHashMap() {
+        clear();
+        delete[] ctrl_;
+        if (slots_) std::allocator<value_type>().deallocate(slots_, capacity_);
+    }
+
+    void swap(FlatHashMap& other) noexcept {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(growthLeft_, other.growthLeft_);
+        std::swap(hash_, other.hash_);
+        std::swap(eq_, other.eq_);
+    }
+
+    void reserve(size_t count) {
+        if (count > size_ + growthLeft_) rehash(capacityFor(count));
+    }
+
+    void clear() {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) slots_[i].~value_type();
+        }
+        if (ctrl_) std::fill_n(ctrl_, capacity_, kEmpty);
+        size_ = 0;
+        growthLeft_ = capacity_ - capacity_ / 8;
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+        auto [slot, inserted] = emplaceKey(key, std::forward<Args>(args)...);
+        return {iterator(this, static_cast<size_t>(slot - slots_)), inserted};
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        auto [slot, inserted] = emplaceKey(std::move(key), std::forward<Args>(args)...);
+        return {iterator(this, static_cast<size_t>(slot - slots_)), inserted};
+    }
+
+    template<typename M>
+    bool insert_or_assign(const K& key, M&& value) {
+        auto [slot, inserted] = emplaceKey(key, std::forward<M>(value));
+        if (!inserted) slot->second = std::forward<M>(value);
+        return inserted;
+    }
+
+    V& operator[](const K& key) { return emplaceKey(key).first->second; }
+
+    iterator find(const K& key) {
+        size_t i = findIndex(key, hashOf(key));
+        return i == npos ? end() : iterator(this, i);
+    }
+
+    const_iterator find(const K& key) const {
+        size_t i = findIndex(key, hashOf(key));
+        return i == npos ? end() : const_iterator(this, i);
+    }
+
+    bool contains(const K& key) const { return findIndex(key, hashOf(key)) != npos; }
+
+    // A slot whose group still has an empty byte can become empty again:
+    // no probe sequence ever continued past that group. Otherwise it
+    // becomes a tombstone.
+    size_t erase(const K& key) {
+        size_t i = findIndex(key, hashOf(key));
+        if (i == npos) return 0;
+        slots_[i].~value_type();
+        if (ControlGroup(ctrl_ + (i & ~(kGroup - 1))).match(kEmpty)) {
+            ctrl_[i] = kEmpty;
+            ++growthLeft_;
+        } else {
+            ctrl_[i] = kDeleted;
+        }
+        --size_;
+        return 1;
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, capacity_); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, capacity_); }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }
+    size_t memoryBytes() const { return capacity_ * (sizeof(value_type) + 1); }
+};
+
+// Branchless lower bound: the loop always runs log2(n) times, and the
+// comparison only selects the next base (a conditional move), so random
+// lookups cause no branch mispredictions
+template<typename K, typename Compare>
+size_t branchlessLowerBound(const K* data, size_t n, const K& key, Compare comp) {
+    if (n == 0) return 0;
+    const K* base = data;
+    while (n > 1) {
+        size_t half = n / 2;
+        base = comp(base[half], key) ? base + half : base;
+        n -= half;
+    }
+    return static_cast<size_t>(base - data) + comp(*base, key);
+}
+
+// Sorted keys and values in two parallel vectors, like C++23 std::flat_map.
+// Binary search touches only the key array, which stays dense in cache.
+template<typename K, typename V, typename Compare = std::less<K>>
+class FlatMap {
+private:
+    std::vector<K> keys_;
+    std::vector<V> values_;
+    Compare comp_;
+
+    size_t lowerBound(const K& key) const { return branchlessLowerBound(keys_.data(), keys_.size(), key, comp_); }
+    bool matches(size_t i, const K& key) const { return i < keys_.size() && !comp_(key, keys_[i]); }
+
+public:
+    FlatMap() = default;
+
+    // Bulk build: one sort instead of n O(n) inserts. For duplicate keys
+    // the first occurrence wins, as with std::map::insert.
+    explicit FlatMap(std::vector<std::pair<K, V>> items) {
+        std::stable_sort(items.begin(), items.end(),
+                         [this](const auto& a, const auto& b) { return comp_(a.first, b.first); });
+        keys_.reserve(items.size());
+        values_.reserve(items.size());
+        for (auto& [key, value] : items) {
+            if (!keys_.empty() && !comp_(keys_.back(), key)) continue;
+            keys_.push_back(std::move(key));
+            values_.push_back(std::move(value));
+        }
+    }
+
+    V* find(const K& key) {
+        size_t i = lowerBound(key);
+        return matches(i, key) ? &values_[i] : nullptr;
+    }
+
+    const V* find(const K& key) const {
+        size_t i = lowerBound(key);
+        return matches(i, key) ? &values_[i] : nullptr;
+    }
+
+    bool contains(const K& key) const { return matches(lowerBound(key), key); }
+
+    // O(n): shifts the tail of both arrays
+    template<typename M>
+    bool insert_or_assign(const K& key, M&& value) {
+        size_t i = lowerBound(key);
+        if (matches(i, key)) {
+            values_[i] = std::forward<M>(value);
+            return false;
+        }
+        keys_.insert(keys_.begin() + i, key);
+        values_.insert(values_.begin() + i, std::forward<M>(value));
+        return true;
+    }
+
+    V& operator[](const K& key) {
+        size_t i = lowerBound(key);
+        if (!matches(i, key)) {
+            keys_.insert(keys_.begin() + i, key);
+            values_.insert(values_.begin() + i, V{});
+        }
+        return values_[i];
+    }
+
+    size_t erase(const K& key) {
+        size_t i = lowerBound(key);
+        if (!matches(i, key)) return 0;
+        keys_.erase(keys_.begin() + i);
+        values_.erase(values_.begin() + i);
+        return 1;
+    }
+
+    const std::vector<K>& keys() const { return keys_; }
+    const std::vector<V>& values() const { return values_; }
+    std::vector<V>& values() { return values_; }
+    size_t size() const { return keys_.size(); }
+    bool empty() const { return keys_.empty(); }
+    size_t memoryBytes() const { return keys_.capacity() * sizeof(K) + values_.capacity() * sizeof(V); }
+};
+
+template<typename K, typename Compare = std::less<K>>
+class FlatSet {
+private:
+    std::vector<K> keys_;
+    Compare comp_;
+
+    size_t lowerBound(const K& key) const { return branchlessLowerBound(keys_.data(), keys_.size(), key, comp_); }
+
+public:
+    FlatSet() = default;
+
+    explicit FlatSet(std::vector<K> keys) : keys_(std::move(keys)) {
+        std::sort(keys_.begin(), keys_.end(), comp_);
+        keys_.erase(std::unique(keys_.begin(), keys_.end(),
+                                [this](const K& a, const K& b) { return !comp_(a, b) && !comp_(b, a); }),
+                    keys_.end());
+    }
+
+    bool contains(const K& key) const {
+        size_t i = lowerBound(key);
+        return i < keys_.size() && !comp_(key, keys_[i]);
+    }
+
+    bool insert(const K& key) {
+        size_t i = lowerBound(key);
+        if (i < keys_.size() && !comp_(key, keys_[i])) return false;
+        keys_.insert(keys_.begin() + i, key);
+        return true;
+    }
+
+    size_t erase(const K& key) {
+        size_t i = lowerBound(key);
+        if (i == keys_.size() || comp_(key, keys_[i])) return 0;
+        keys_.erase(keys_.begin() + i);
+        return 1;
+    }
+
+    auto begin() const { return keys_.begin(); }
+    auto end() const { return keys_.end(); }
+    size_t size() const { return keys_.size(); }
+    size_t memoryBytes() const { return keys_.capacity() * sizeof(K); }
+};
+
+// Striped locking: the top bits of the mixed hash pick a shard, and each
+// shard is a FlatHashMap behind its own shared_mutex. Readers of one
+// shard run in parallel, and writers block only that shard. Values are
+// copied out under the lock, so no reference outlives it.
+template<typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>>
+class ConcurrentFlatMap {
+private:
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        FlatHashMap<K, V, Hash, Eq> map;
+    };
+
+    std::unique_ptr<Shard[]> shards_;
+    unsigned shardBits_;
+    Hash hash_;
+
+    Shard& shardFor(const K& key) const {
+        uint64_t h = hashMix(static_cast<uint64_t>(hash_(key)));
+        return shards_[shardBits_ ? h >> (64 - shardBits_) : 0];
+    }
+
+public:
+    explicit ConcurrentFlatMap(size_t shards = 64) : shardBits_(0) {
+        while ((size_t(1) << shardBits_) < shards) ++shardBits_;
+        shards_ = std::make_unique<Shard[]>(size_t(1) << shardBits_);
+    }
+
+    template<typename M>
+    bool insert_or_assign(const K& key, M&& value) {
+        Shard& shard = shardFor(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.map.insert_or_assign(key, std::forward<M>(value));
+    }
+
+    bool find(const K& key, V& out) const {
+        Shard& shard = shardFor(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) return false;
+        out = it->second;
+        return true;
+    }
+
+    // Runs f(value) under the shard's exclusive lock; false if absent
+    template<typename F>
+    bool visit(const K& key, F&& f) {
+        Shard& shard = shardFor(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) return false;
+        f(it->second);
+        return true;
+    }
+
+    bool erase(const K& key) {
+        Shard& shard = shardFor(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.map.erase(key) != 0;
+    }
+
+    // Not a snapshot: shards are counted one after another
+    size_t size() const {
+        size_t total = 0;
+        for (size_t s = 0; s < (size_t(1) << shardBits_); ++s) {
+            std::shared_lock<std::shared_mutex> lock(shards_[s].mutex);
+            total += shards_[s].map.size();
+        }
+        return total;
+    }
+};
+
+// Counts bytes requested from the allocator, to measure node containers
+inline size_t g_countedBytes = 0;
+
+template<typename T>
+struct CountingAllocator {
+    using value_type = T;
+    CountingAllocator() = default;
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+    T* allocate(size_t n) {
+        g_countedBytes += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, size_t n) {
+        g_countedBytes -= n * sizeof(T);
+        std::allocator<T>().deallocate(p, n);
+    }
+    template<typename U>
+    bool operator==(const CountingAllocator<U>&) const { return true; }
+    template<typename U>
+    bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+void demonstrateFlatContainers() {
+    std::cout << "\n========== FLAT CONTAINERS ==========\n";
+
+    std::cout << "\n--- FLAT HASH MAP (SwissTable-style) ---\n";
+    FlatHashMap<std::string, int> symbols;
+    for (const char* name : {"AAPL", "MSFT", "GOOG", "AMZN", "NVDA"}) {
+        symbols[name] = static_cast<int>(symbols.size());
+    }
+    symbols.erase("GOOG");
+    symbols.try_emplace("META", 42);
+    std::cout << "Size: " << symbols.size() << ", capacity: " << symbols.capacity()
+              << ", MSFT -> " << symbols.find("MSFT")->second
+              << ", contains GOOG: " << (symbols.contains("GOOG") ? "yes" : "no") << std::endl;
+    std::cout << "Iteration order follows slots, not insertion: ";
+    for (const auto& [name, id] : symbols) std::cout << name << "=" << id << " ";
+    std::cout << std::endl;
+
+    std::cout << "\n--- FLAT MAP / FLAT SET (sorted vectors) ---\n";
+    FlatMap<int, std::string> sessions({{30, "carol"}, {10, "alice"}, {20, "bob"}, {10, "duplicate"}});
+    sessions.insert_or_assign(25, std::string("dave"));
+    std::cout << "Keys in order: ";
+    for (int key : sessions.keys()) std::cout << key << " ";
+    std::cout << "| 10 -> " << *sessions.find(10) << std::endl;
+
+    FlatSet<int> ports({443, 80, 8080, 80, 22});
+    std::cout << "FlatSet: ";
+    for (int port : ports) std::cout << port << " ";
+    std::cout << "| contains 8080: " << (ports.contains(8080) ? "yes" : "no") << std::endl;
+
+    std::cout << "\n--- CONCURRENT FLAT MAP (striped locks) ---\n";
+    ConcurrentFlatMap<int, long> counters(16);
+    for (int key = 0; key < 100; ++key) counters.insert_or_assign(key, 0L);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&counters] {
+            for (int i = 0; i < 1000; ++i) counters.visit(i % 100, [](long& value) { ++value; });
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    long hits = 0;
+    counters.find(7, hits);
+    std::cout << "4 threads x 1000 increments over " << counters.size() << " keys; key 7 = " << hits
+              << " (expected 40)" << std::endl;
+}
+
+template<typename F>
+double bestMs(F&& body, int runs = 3) {
+    double best = 1e300;
+    for (int r = 0; r < runs; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+void demonstrateFlatContainerPerformance() {
+    std::cout << "\n========== FLAT VS NODE CONTAINERS ==========\n";
+    constexpr size_t N = 1 << 20;
+
+    std::mt19937_64 gen(2024);
+    std::vector<uint64_t> keys(N);
+    for (auto& key : keys) key = gen();
+    // Half the queries hit, half miss, in random order
+    std::vector<uint64_t> queries(N);
+    for (size_t i = 0; i < N; ++i) queries[i] = (i & 1) ? gen() : keys[gen() % N];
+
+    using StdMap = std::map<uint64_t, uint64_t, std::less<uint64_t>,
+                            CountingAllocator<std::pair<const uint64_t, uint64_t>>>;
+    using StdUnordered = std::unordered_map<uint64_t, uint64_t, std::hash<uint64_t>, std::equal_to<uint64_t>,
+                                            CountingAllocator<std::pair<const uint64_t, uint64_t>>>;
+
+    std::printf("\n%zu uint64 -> uint64 entries; ns/op (best of 3); bytes requested from the allocator\n", N);
+    std::printf("  %-22s %10s %10s %10s %12s\n", "container", "insert", "lookup", "iterate", "bytes/entry");
+
+    auto report = [&](const char* name, double insertMs, double lookupMs, double iterateMs, size_t bytes,
+                      uint64_t checksum) {
+        std::printf("  %-22s %10.1f %10.1f %10.2f %12.1f   (checksum %llu)\n", name, insertMs * 1e6 / N,
+                    lookupMs * 1e6 / N, iterateMs * 1e6 / N, double(bytes) / N,
+                    static_cast<unsigned long long>(checksum % 1000));
+    };
+
+    {
+        uint64_t found = 0, sum = 0;
+        size_t bytes = 0;
+        double insertMs = bestMs([&] {
+            StdMap m;
+            for (uint64_t k : keys) m.emplace(k, k);
+            bytes = g_countedBytes;
+        });
+        StdMap m;
+        for (uint64_t k : keys) m.emplace(k, k);
+        double lookupMs = bestMs([&] {
+            found = 0;
+            for (uint64_t q : queries) found += m.count(q);
+        });
+        double iterateMs = bestMs([&] {
+            sum = 0;
+            for (const auto& kv : m) sum += kv.second;
+        });
+        report("std::map", insertMs, lookupMs, iterateMs, bytes, found + sum);
+    }
+    {
+        uint64_t found = 0, sum = 0;
+        size_t bytes = 0;
+        double insertMs = bestMs([&] {
+            StdUnordered m;
+            for (uint64_t k : keys) m.emplace(k, k);
+            bytes = g_countedBytes;
+        });
+        StdUnordered m;
+        for (uint64_t k : keys) m.emplace(k, k);
+        double lookupMs = bestMs([&] {
+            found = 0;
+            for (uint64_t q : queries) found += m.count(q);
+        });
+        double iterateMs = bestMs([&] {
+            sum = 0;
+            for (const auto& kv : m) sum += kv.second;
+        });
+        report("std::unordered_map", insertMs, lookupMs, iterateMs, bytes, found + sum);
+    }
+    {
+        uint64_t found = 0, sum = 0;
+        size_t bytes = 0;
+        double insertMs = bestMs([&] {
+            FlatHashMap<uint64_t, uint64_t> m;
+            for (uint64_t k : keys) m.try_emplace(k, k);
+            bytes = m.memoryBytes();
+        });
+        FlatHashMap<uint64_t, uint64_t> m;
+        for (uint64_t k : keys) m.try_emplace(k, k);
+        double lookupMs = bestMs([&] {
+            found = 0;
+            for (uint64_t q : queries) found += m.contains(q);
+        });
+        double iterateMs = bestMs([&] {
+            sum = 0;
+            for (const auto& kv : m) sum += kv.second;
+        });
+        report("FlatHashMap", insertMs, lookupMs, iterateMs, bytes, found + sum);
+    }
+    {
+        uint64_t found = 0, sum = 0;
+        size_t bytes = 0;
+        std::vector<std::pair<uint64_t, uint64_t>> items;
+        items.reserve(N);
+        for (uint64_t k : keys) items.emplace_back(k, k);
+        double insertMs = bestMs([&] {
+            FlatMap<uint64_t, uint64_t> m(items);
+            bytes = m.memoryBytes();
+        });
+        FlatMap<uint64_t, uint64_t> m(items);
+        double lookupMs = bestMs([&] {
+            found = 0;
+            for (uint64_t q : queries) found += m.contains(q);
+        });
+        double iterateMs = bestMs([&] {
+            sum = 0;
+            for (uint64_t v : m.values()) sum += v;
+        });
+        report("FlatMap (bulk build)", insertMs, lookupMs, iterateMs, bytes, found + sum);
+    }
+    std::cout << "  (FlatMap's insert column is one bulk sort; single inserts into it are O(n).\n"
+              << "   Node containers also pay malloc's per-node header, not counted here.)\n";
+
+    // Symbol lookup with string keys
+    {
+        std::vector<std::string> names;
+        for (size_t i = 0; i < 200000; ++i) names.push_back("SYM" + std::to_string(gen() % 100000000));
+        std::unordered_map<std::string, size_t> stdNames;
+        FlatHashMap<std::string, size_t> flatNames;
+        for (size_t i = 0; i < names.size(); ++i) {
+            stdNames.emplace(names[i], i);
+            flatNames.try_emplace(names[i], i);
+        }
+        size_t a = 0, b = 0;
+        double stdMs = bestMs([&] {
+            a = 0;
+            for (const auto& name : names) a += stdNames.find(name)->second;
+        });
+        double flatMs = bestMs([&] {
+            b = 0;
+            for (const auto& name : names) b += flatNames.find(name)->second;
+        });
+        std::printf("\nString symbol lookup (%zu names): unordered_map %.1f ns, FlatHashMap %.1f ns (%s)\n",
+                    names.size(), stdMs * 1e6 / names.size(), flatMs * 1e6 / names.size(),
+                    a == b ? "same results" : "MISMATCH");
+    }
+
+    // Concurrent session table: 90% lookups, 10% upserts
+    {
+        constexpr size_t kThreads = 4, kOps = 400000, kKeys = 1 << 16;
+        auto run = [&](auto&& lookup, auto&& upsert) {
+            return bestMs([&] {
+                std::vector<std::thread> threads;
+                for (size_t t = 0; t < kThreads; ++t) {
+                    threads.emplace_back([&, t] {
+                        std::mt19937_64 local(t);
+                        for (size_t i = 0; i < kOps; ++i) {
+                            uint64_t key = local() % kKeys;
+                            if (i % 10 == 0) {
+                                upsert(key);
+                            } else {
+                                lookup(key);
+                            }
+                        }
+                    });
+                }
+                for (auto& thread : threads) thread.join();
+            });
+        };
+
+        std::unordered_map<uint64_t, uint64_t> locked;
+        std::shared_mutex lockedMutex;
+        double globalMs = run(
+            [&](uint64_t key) {
+                std::shared_lock<std::shared_mutex> lock(lockedMutex);
+                volatile bool found = locked.count(key) != 0;
+                (void)found;
+            },
+            [&](uint64_t key) {
+                std::unique_lock<std::shared_mutex> lock(lockedMutex);
+                locked[key] = key;
+            });
+
+        ConcurrentFlatMap<uint64_t, uint64_t> sharded(64);
+        double shardedMs = run(
+            [&](uint64_t key) {
+                uint64_t value;
+                volatile bool found = sharded.find(key, value);
+                (void)found;
+            },
+            [&](uint64_t key) { sharded.insert_or_assign(key, key); });
+
+        double ops = double(kThreads * kOps);
+        std::printf("Concurrent 90/10 read/write, %zu threads: unordered_map + one shared_mutex %.1f Mops/s, "
+                    "ConcurrentFlatMap (64 shards) %.1f Mops/s\n",
+                    kThreads, ops / globalMs / 1e3, ops / shardedMs / 1e3);
+    }
+}
+
 // =============================================================================
 // MAIN FUNCTION
 // =============================================================================
@@ -732,6 +1503,8 @@ int main() {
     demonstrateUtilities();
     demonstratePerformance();
     demonstrateRealWorldExamples();
+    demonstrateFlatContainers();
+    demonstrateFlatContainerPerformance();
     
     std::cout << "\n========== SUMMARY ==========\n";
     std::cout << "STL provides:\n";
@@ -740,6 +1513,7 @@ int main() {
     std::cout << "3. Iterators - Uniform way to traverse containers\n";
     std::cout << "4. Function Objects - Customizable behavior\n";
     std::cout << "5. Utilities - Helper functions and classes\n";
+    std::cout << "6. Flat containers - Contiguous storage when node containers are too slow\n";
     std::cout << "\nMaster the STL for efficient and elegant C++ programming!\n";
     
     return 0;
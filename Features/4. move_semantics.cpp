@@ -5,6 +5,15 @@
 #include <utility>
 #include <algorithm>
 #include <chrono>
+#include <memory_resource>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
 
 /*
  * COMPREHENSIVE C++ MOVE SEMANTICS DEMONSTRATION
@@ -237,15 +246,28 @@ void demonstratePerfectForwarding() {
 // 3. MOVE-AWARE CONTAINER
 // =============================================================================
 
+// Storage comes from a std::pmr::memory_resource (the default resource
+// unless one is passed in), so the same container can run on the heap, on
+// a stack buffer, or on a pool/arena (see 5. allocators.cpp)
 template<typename T>
 class MoveAwareVector {
 private:
     T* data;
     size_t size;
     size_t capacity;
+    std::pmr::memory_resource* resource;
+    
+    T* allocate(size_t n) {
+        return n ? static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T))) : nullptr;
+    }
+    
+    void deallocate() {
+        if (data) resource->deallocate(data, capacity * sizeof(T), alignof(T));
+        data = nullptr;
+    }
     
     void reallocate(size_t new_capacity) {
-        T* new_data = static_cast<T*>(std::malloc(new_capacity * sizeof(T)));
+        T* new_data = allocate(new_capacity);
         
         // Move construct elements to new location
         for (size_t i = 0; i < size; ++i) {
@@ -253,28 +275,30 @@ private:
             data[i].~T();  // Destroy old object
         }
         
-        std::free(data);
+        deallocate();
         data = new_data;
         capacity = new_capacity;
         std::cout << "Reallocated to capacity " << capacity << " using move semantics\n";
     }
 
 public:
-    MoveAwareVector() : data(nullptr), size(0), capacity(0) {}
-    
-    // Copy constructor
-    MoveAwareVector(const MoveAwareVector& other) 
-        : size(other.size), capacity(other.capacity) {
-        data = static_cast<T*>(std::malloc(capacity * sizeof(T)));
+    explicit MoveAwareVector(std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : data(nullptr), size(0), capacity(0), resource(mr) {}
+    
+    // Copy constructor (like std::pmr containers, copies use the default resource)
+    MoveAwareVector(const MoveAwareVector& other,
+                    std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : size(other.size), capacity(other.capacity), resource(mr) {
+        data = allocate(capacity);
         for (size_t i = 0; i < size; ++i) {
             new (data + i) T(other.data[i]);  // Copy construct
         }
         std::cout << "MoveAwareVector copied\n";
     }
     
-    // Move constructor
+    // Move constructor: steals the buffer together with its resource
     MoveAwareVector(MoveAwareVector&& other) noexcept
-        : data(other.data), size(other.size), capacity(other.capacity) {
+        : data(other.data), size(other.size), capacity(other.capacity), resource(other.resource) {
         other.data = nullptr;
         other.size = 0;
         other.capacity = 0;
@@ -285,11 +309,11 @@ public:
     MoveAwareVector& operator=(const MoveAwareVector& other) {
         if (this != &other) {
             clear();
-            std::free(data);
+            deallocate();
             
             size = other.size;
             capacity = other.capacity;
-            data = static_cast<T*>(std::malloc(capacity * sizeof(T)));
+            data = allocate(capacity);
             
             for (size_t i = 0; i < size; ++i) {
                 new (data + i) T(other.data[i]);
@@ -299,19 +323,33 @@ public:
         return *this;
     }
     
-    // Move assignment
+    // Move assignment: buffers can only be stolen from the same resource,
+    // otherwise elements are moved one by one into our own storage
     MoveAwareVector& operator=(MoveAwareVector&& other) noexcept {
         if (this != &other) {
             clear();
-            std::free(data);
-            
-            data = other.data;
-            size = other.size;
-            capacity = other.capacity;
             
-            other.data = nullptr;
-            other.size = 0;
-            other.capacity = 0;
+            if (*resource == *other.resource) {
+                deallocate();
+                data = other.data;
+                size = other.size;
+                capacity = other.capacity;
+                
+                other.data = nullptr;
+                other.size = 0;
+                other.capacity = 0;
+            } else {
+                if (capacity < other.size) {
+                    deallocate();
+                    data = allocate(other.size);
+                    capacity = other.size;
+                }
+                for (size_t i = 0; i < other.size; ++i) {
+                    new (data + i) T(std::move(other.data[i]));
+                }
+                size = other.size;
+                other.clear();
+            }
             std::cout << "MoveAwareVector move assigned\n";
         }
         return *this;
@@ -319,9 +357,11 @@ public:
     
     ~MoveAwareVector() {
         clear();
-        std::free(data);
+        deallocate();
     }
     
+    std::pmr::memory_resource* get_resource() const { return resource; }
+    
     void push_back(const T& value) {
         if (size >= capacity) {
             reallocate(capacity == 0 ? 1 : capacity * 2);
@@ -387,6 +427,360 @@ void demonstrateMoveAwareContainer() {
     
     std::cout << "vec size after move: " << vec.getSize() << std::endl;
     std::cout << "vec2 size: " << vec2.getSize() << std::endl;
+    
+    std::cout << "\n--- Custom memory resource ---\n";
+    
+    // Same container, storage from a stack buffer instead of the heap
+    alignas(std::max_align_t) char buffer[1024];
+    std::pmr::monotonic_buffer_resource stack_resource(buffer, sizeof(buffer),
+                                                       std::pmr::null_memory_resource());
+    MoveAwareVector<int> small(&stack_resource);
+    for (int i = 0; i < 8; ++i) small.push_back(i);
+    std::cout << "8 ints stored in a stack buffer, size: " << small.getSize() << std::endl;
+}
+
+// MoveAwareVector shows the mechanics. SmallVector is the version for hot
+// paths:
+// - The first N elements live inside the object, so a vector that stays
+//   small never touches the heap.
+// - The growth factor is a policy.
+// - Relocation uses memcpy for types that may be moved bit by bit.
+// - No logging.
+// Once it spills, heap storage comes from a std::pmr::memory_resource,
+// just as in MoveAwareVector.
+
+// A type is trivially relocatable when "move-construct into new storage,
+// then destroy the source" is equivalent to memcpy. Every trivially
+// copyable type qualifies. Other types opt in with a specialization. Note
+// that libstdc++'s std::string does not qualify: its small-string buffer
+// points into the object itself.
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+// Capacity grows to max(required, capacity * Num / Den). 3/2 lets freed
+// blocks be reused by later growth; 2/1 reallocates less often. Saturates
+// at SIZE_MAX instead of wrapping; the container clamps to its max_size().
+template<size_t Num, size_t Den>
+struct GrowthFactor {
+    static_assert(Num > Den, "growth factor must be greater than 1");
+    static size_t next(size_t capacity, size_t required) {
+        size_t grown = capacity > (SIZE_MAX - Den) / Num ? SIZE_MAX : capacity * Num / Den + 1;
+        return std::max(required, grown);
+    }
+};
+
+template<typename T, size_t N = 8, typename Growth = GrowthFactor<3, 2>>
+class SmallVector {
+private:
+    T* data_;
+    size_t size_ = 0;
+    size_t capacity_ = N;
+    std::pmr::memory_resource* resource_;
+    alignas(T) unsigned char inline_[sizeof(T) * (N ? N : 1)];
+
+    T* inlineData() { return reinterpret_cast<T*>(inline_); }
+    bool isInline() const { return data_ == reinterpret_cast<const T*>(inline_); }
+
+    // Moves count elements to uninitialized storage, then ends the source
+    // objects' lifetimes. Strong guarantee: every element is built in `to`
+    // before any source is destroyed, and elements whose move may throw
+    // are copied (move_if_noexcept), so on an exception the partial copies
+    // are destroyed and `from` is untouched.
+    static void relocate(T* from, size_t count, T* to) {
+        if constexpr (is_trivially_relocatable<T>::value) {
+            if (count) std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+        } else {
+            size_t built = 0;
+            try {
+                for (; built < count; ++built) new (to + built) T(std::move_if_noexcept(from[built]));
+            } catch (...) {
+                while (built) to[--built].~T();
+                throw;
+            }
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (size_t i = 0; i < count; ++i) from[i].~T();
+            }
+        }
+    }
+
+    void releaseHeap() {
+        if (!isInline()) deallocate(data_, capacity_);
+        data_ = inlineData();
+        capacity_ = N;
+    }
+
+    void adopt(T* newData, size_t newCapacity) {
+        releaseHeap();
+        data_ = newData;
+        capacity_ = newCapacity;
+    }
+
+    // On failure newData is freed and the vector is unchanged
+    void moveStorage(T* newData, size_t newCapacity) {
+        try {
+            relocate(data_, size_, newData);
+        } catch (...) {
+            deallocate(newData, newCapacity);
+            throw;
+        }
+        adopt(newData, newCapacity);
+    }
+
+    T* allocate(size_t n) {
+        if (n > max_size()) throw std::length_error("SmallVector: capacity exceeds max_size()");
+        return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) { resource_->deallocate(p, n * sizeof(T), alignof(T)); }
+
+    // Builds the new element in the new block before relocating the old
+    // ones, so arguments that refer to existing elements stay valid
+    template<typename... Args>
+    T& emplaceGrow(Args&&... args) {
+        if (size_ == max_size()) throw std::length_error("SmallVector: capacity exceeds max_size()");
+        size_t newCapacity = std::min(Growth::next(capacity_, size_ + 1), max_size());
+        T* newData = allocate(newCapacity);
+        try {
+            new (newData + size_) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(newData, newCapacity);
+            throw;
+        }
+        try {
+            relocate(data_, size_, newData);
+        } catch (...) {
+            newData[size_].~T();
+            deallocate(newData, newCapacity);
+            throw;
+        }
+        adopt(newData, newCapacity);
+        return data_[size_++];
+    }
+
+    // Takes other's elements, stealing its heap block when allowed
+    void takeFrom(SmallVector& other) {
+        if (!other.isInline() && *resource_ == *other.resource_) {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            size_ = other.size_;
+        } else {
+            if (other.size_ > N) {
+                data_ = allocate(other.size_);
+                capacity_ = other.size_;
+            }
+            try {
+                relocate(other.data_, other.size_, data_);
+            } catch (...) {
+                releaseHeap();  // other keeps its elements; this is left empty
+                throw;
+            }
+            size_ = other.size_;
+            other.releaseHeap();
+        }
+        other.data_ = other.inlineData();
+        other.capacity_ = N;
+        other.size_ = 0;
+    }
+
+public:
+    explicit SmallVector(std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : data_(inlineData()), resource_(mr) {}
+
+    SmallVector(std::initializer_list<T> items, std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : SmallVector(mr) {
+        reserve(items.size());
+        for (const T& item : items) new (data_ + size_++) T(item);
+    }
+
+    SmallVector(const SmallVector& other, std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : SmallVector(mr) {
+        reserve(other.size_);
+        for (size_t i = 0; i < other.size_; ++i) new (data_ + size_++) T(other.data_[i]);
+    }
+
+    // Inline elements cannot be stolen; they are relocated one by one
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : data_(inlineData()), resource_(other.resource_) {
+        takeFrom(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            for (size_t i = 0; i < other.size_; ++i) new (data_ + size_++) T(other.data_[i]);
+        }
+        return *this;
+    }
+
+    // May allocate when the resources differ, so not noexcept
+    SmallVector& operator=(SmallVector&& other) {
+        if (this != &other) {
+            clear();
+            releaseHeap();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        clear();
+        releaseHeap();
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) return emplaceGrow(std::forward<Args>(args)...);
+        new (data_ + size_) T(std::forward<Args>(args)...);
+        return data_[size_++];
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() { data_[--size_].~T(); }
+
+    void clear() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < size_; ++i) data_[i].~T();
+        }
+        size_ = 0;
+    }
+
+    // Throws std::length_error past max_size(); strong guarantee otherwise
+    void reserve(size_t n) {
+        if (n > capacity_) moveStorage(allocate(n), n);
+    }
+
+    // reserve() that reports failure instead of throwing: allocation,
+    // max_size() and element relocation failures all leave the vector
+    // unchanged
+    bool try_reserve(size_t n) noexcept {
+        try {
+            reserve(n);
+        } catch (...) {
+            return false;
+        }
+        return true;
+    }
+
+    // Returns to inline storage when the elements fit, otherwise trims the
+    // heap block to size()
+    void shrink_to_fit() {
+        if (isInline() || size_ == capacity_) return;
+        if (size_ <= N) {
+            T* heap = data_;
+            size_t heapCapacity = capacity_;
+            relocate(heap, size_, inlineData());
+            deallocate(heap, heapCapacity);
+            data_ = inlineData();
+            capacity_ = N;
+        } else {
+            moveStorage(allocate(size_), size_);
+        }
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+    bool is_inline() const { return isInline(); }
+    static constexpr size_t inline_capacity() { return N; }
+    static constexpr size_t max_size() { return SIZE_MAX / sizeof(T); }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    T* begin() { return data_; }
+    T* end() { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    T& operator[](size_t index) { return data_[index]; }
+    const T& operator[](size_t index) const { return data_[index]; }
+    T& back() { return data_[size_ - 1]; }
+};
+
+// Counts element copies and moves, to check that emplace_back and growth never copy
+struct CopyCounter {
+    static inline int copies = 0;
+    static inline int moves = 0;
+    int value;
+    explicit CopyCounter(int v) : value(v) {}
+    CopyCounter(const CopyCounter& other) : value(other.value) { ++copies; }
+    CopyCounter(CopyCounter&& other) noexcept : value(other.value) { ++moves; }
+};
+
+// Move may throw, so relocation copies it instead; the copy fails on demand
+struct FragileCopy {
+    static inline int copiesLeft = 1000;
+    int value;
+    explicit FragileCopy(int v) : value(v) {}
+    FragileCopy(const FragileCopy& other) : value(other.value) {
+        if (--copiesLeft < 0) throw std::runtime_error("copy failed");
+    }
+    FragileCopy(FragileCopy&& other) : value(other.value) {}
+};
+
+void demonstrateSmallVector() {
+    std::cout << "\n========== SMALL VECTOR ==========\n";
+
+    std::cout << "\n--- Inline storage ---\n";
+    SmallVector<int, 8> ids;
+    for (int i = 0; i < 8; ++i) ids.push_back(i);
+    std::cout << "8 ints: inline = " << (ids.is_inline() ? "yes" : "no") << ", capacity " << ids.capacity() << std::endl;
+    ids.push_back(8);
+    std::cout << "9th int spills to the heap: inline = " << (ids.is_inline() ? "yes" : "no")
+              << ", capacity " << ids.capacity() << std::endl;
+    ids.pop_back();
+    ids.shrink_to_fit();
+    std::cout << "After pop_back + shrink_to_fit: inline = " << (ids.is_inline() ? "yes" : "no") << std::endl;
+
+    std::cout << "\n--- emplace_back and growth never copy ---\n";
+    SmallVector<CopyCounter, 2> counted;
+    for (int i = 0; i < 10; ++i) counted.emplace_back(i);
+    std::cout << "10 emplace_backs through 3 reallocations: " << CopyCounter::copies << " copies, "
+              << CopyCounter::moves << " moves" << std::endl;
+
+    std::cout << "\n--- Trivially relocatable elements ---\n";
+    SmallVector<std::unique_ptr<std::string>, 1> owners;
+    for (int i = 0; i < 4; ++i) owners.push_back(std::make_unique<std::string>("owner" + std::to_string(i)));
+    std::cout << "unique_ptrs relocated with memcpy, last = " << *owners.back() << std::endl;
+
+    std::cout << "\n--- try_reserve ---\n";
+    // No heap at all: the inline buffer is the whole capacity
+    SmallVector<int, 4> bounded(std::pmr::null_memory_resource());
+    for (int i = 0; i < 4; ++i) bounded.push_back(i);
+    std::cout << "try_reserve(4): " << (bounded.try_reserve(4) ? "ok" : "failed")
+              << ", try_reserve(5) on a null resource: " << (bounded.try_reserve(5) ? "ok" : "failed")
+              << ", size still " << bounded.size() << std::endl;
+    try {
+        bounded.reserve(SmallVector<int, 4>::max_size() + 1);
+    } catch (const std::length_error& e) {
+        std::cout << "reserve(max_size() + 1) throws length_error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\n--- Strong guarantee when relocation throws ---\n";
+    SmallVector<FragileCopy, 2> fragile;
+    fragile.emplace_back(1);
+    fragile.emplace_back(2);
+    FragileCopy::copiesLeft = 1;  // Growth copies 2 elements: the second copy throws
+    try {
+        fragile.emplace_back(3);
+    } catch (const std::runtime_error& e) {
+        std::cout << "emplace_back during growth failed (" << e.what() << "): size " << fragile.size()
+                  << ", elements " << fragile[0].value << ", " << fragile[1].value
+                  << ", inline = " << (fragile.is_inline() ? "yes" : "no") << std::endl;
+    }
+    std::cout << "try_reserve(16) with failing copies: " << (fragile.try_reserve(16) ? "ok" : "failed")
+              << ", size still " << fragile.size() << std::endl;
+    FragileCopy::copiesLeft = 1000;
+
+    std::cout << "\n--- Moving ---\n";
+    SmallVector<std::string, 4> names{"ada", "grace", "linus"};
+    SmallVector<std::string, 4> taken = std::move(names);
+    std::cout << "Inline elements are moved one by one: taken.size() = " << taken.size()
+              << ", names.size() = " << names.size() << std::endl;
 }
 
 // =============================================================================
@@ -528,6 +922,115 @@ void demonstratePerformance() {
               << "x faster\n";
 }
 
+// Forwards to the default resource and counts the allocations
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t bytes = 0;
+
+private:
+    void* do_allocate(size_t n, size_t alignment) override {
+        ++allocations;
+        bytes += n;
+        return std::pmr::new_delete_resource()->allocate(n, alignment);
+    }
+    void do_deallocate(void* p, size_t n, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, n, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Same payload as std::unique_ptr, but not marked trivially relocatable
+struct BoxedInt {
+    std::unique_ptr<int> value;
+    explicit BoxedInt(int v) : value(std::make_unique<int>(v)) {}
+};
+
+template<typename F>
+double bestMs(F&& body, int runs = 3) {
+    double best = 1e300;
+    for (int r = 0; r < runs; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+void demonstrateSmallVectorPerformance() {
+    std::cout << "\n========== SMALL VECTOR PERFORMANCE ==========\n";
+
+    // Short-lived vectors of 1..8 elements, the common case
+    {
+        const size_t kVectors = 1'000'000;
+        std::vector<int> lengths(kVectors);
+        std::mt19937 gen(42);
+        for (auto& length : lengths) length = 1 + static_cast<int>(gen() % 8);
+
+        CountingResource stdCounter, smallCounter;
+        long long stdSum = 0, smallSum = 0;
+        double stdMs = bestMs([&] {
+            stdSum = 0;
+            for (int length : lengths) {
+                std::pmr::vector<int> v(&stdCounter);
+                for (int i = 0; i < length; ++i) v.push_back(i);
+                for (int x : v) stdSum += x;
+            }
+        });
+        double smallMs = bestMs([&] {
+            smallSum = 0;
+            for (int length : lengths) {
+                SmallVector<int, 8> v(&smallCounter);
+                for (int i = 0; i < length; ++i) v.push_back(i);
+                for (int x : v) smallSum += x;
+            }
+        });
+        std::printf("\n%zu vectors of 1..8 ints (best of 3):\n", kVectors);
+        std::printf("  std::pmr::vector<int>  %7.1f ms  %9zu allocations\n", stdMs, stdCounter.allocations / 3);
+        std::printf("  SmallVector<int, 8>    %7.1f ms  %9zu allocations%s\n", smallMs, smallCounter.allocations / 3,
+                    stdSum == smallSum ? "" : "  (MISMATCH)");
+    }
+
+    // Growing without reserve: relocation cost per element type
+    {
+        const int kElements = 1 << 20;
+        double stdMs = bestMs([&] {
+            std::vector<std::unique_ptr<int>> v;
+            for (int i = 0; i < kElements; ++i) v.push_back(std::make_unique<int>(i));
+        });
+        double memcpyMs = bestMs([&] {
+            SmallVector<std::unique_ptr<int>, 0> v;
+            for (int i = 0; i < kElements; ++i) v.push_back(std::make_unique<int>(i));
+        });
+        double moveMs = bestMs([&] {
+            SmallVector<BoxedInt, 0> v;
+            for (int i = 0; i < kElements; ++i) v.emplace_back(i);
+        });
+        std::printf("\nGrowing to %d owning pointers without reserve (includes the allocations):\n", kElements);
+        std::printf("  std::vector<unique_ptr>                 %7.1f ms\n", stdMs);
+        std::printf("  SmallVector<unique_ptr> (memcpy)        %7.1f ms\n", memcpyMs);
+        std::printf("  SmallVector<BoxedInt> (move + destroy)  %7.1f ms\n", moveMs);
+    }
+
+    // Growth factor: reallocation count vs bytes requested
+    {
+        const int kElements = 1 << 20;
+        CountingResource doubling, oneAndHalf;
+        {
+            SmallVector<int, 8, GrowthFactor<2, 1>> v(&doubling);
+            for (int i = 0; i < kElements; ++i) v.push_back(i);
+        }
+        {
+            SmallVector<int, 8, GrowthFactor<3, 2>> v(&oneAndHalf);
+            for (int i = 0; i < kElements; ++i) v.push_back(i);
+        }
+        std::printf("\nGrowth policy for %d ints: 2x -> %zu reallocations, %.1f MB requested; "
+                    "1.5x -> %zu reallocations, %.1f MB requested\n",
+                    kElements, doubling.allocations, doubling.bytes / 1e6, oneAndHalf.allocations,
+                    oneAndHalf.bytes / 1e6);
+    }
+}
+
 // =============================================================================
 // 7. COMMON PITFALLS AND BEST PRACTICES
 // =============================================================================
@@ -622,9 +1125,11 @@ int main() {
     demonstrateRvalueReferences();
     demonstratePerfectForwarding();
     demonstrateMoveAwareContainer();
+    demonstrateSmallVector();
     demonstrateRVO();
     demonstrateSTLMoveSemantics();
     demonstratePerformance();
+    demonstrateSmallVectorPerformance();
     demonstratePitfalls();
     demonstrateMoveInAlgorithms();
     
@@ -0,0 +1,612 @@
+#include <iostream>
+#include <memory_resource>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <list>
+#include <deque>
+#include <array>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+#include <algorithm>
+
+/*
+ * PER-THREAD POOL AND ARENA ALLOCATORS WITH std::pmr
+ *
+ * A general-purpose allocator is shared by every thread, so node-based
+ * containers, task queues and thread pools that allocate on every operation
+ * end up contending on it. This file shows:
+ * 1. FixedBlockPool: fixed-size blocks carved from per-thread slabs, with a
+ *    lock-free cross-thread free path (remote free list per owner)
+ * 2. MonotonicArena: per-thread bump allocation, everything released at once
+ * 3. PoolResource / ArenaResource: std::pmr::memory_resource adapters so any
+ *    pmr container (or your own container) can use them
+ * 4. AllocationStats: bytes in use and high-water mark, sharded per thread
+ */
+
+// =============================================================================
+// 1. THREAD SLOTS AND STATISTICS
+// =============================================================================
+
+// Gives each live thread a small index so allocators can keep per-thread
+// state in plain arrays. Threads beyond kMaxThreads share one extra slot.
+class ThreadSlot {
+public:
+    static constexpr size_t kMaxThreads = 64;
+    static constexpr size_t kSharedSlot = kMaxThreads;
+
+    static size_t current() {
+        static thread_local Holder holder;
+        return holder.index;
+    }
+
+private:
+    static inline std::atomic<bool> in_use_[kMaxThreads] = {};
+
+    struct Holder {
+        size_t index = kSharedSlot;
+
+        Holder() {
+            for (size_t i = 0; i < kMaxThreads; ++i) {
+                bool expected = false;
+                if (in_use_[i].compare_exchange_strong(expected, true)) {
+                    index = i;
+                    return;
+                }
+            }
+        }
+
+        ~Holder() {
+            if (index != kSharedSlot) in_use_[index].store(false, std::memory_order_release);
+        }
+    };
+};
+
+// Bytes in use and high-water mark without a shared hot counter: each slot
+// accumulates locally and folds into the global total every kFlushBytes.
+// The high-water mark is taken at every flush and every bytes_in_use()
+// query, so it is exact to within one flush quantum per thread.
+class AllocationStats {
+public:
+    static constexpr int64_t kFlushBytes = 16 * 1024;
+
+    void on_allocate(size_t slot, size_t bytes) {
+        Local& local = locals_[slot];
+        local.allocations.fetch_add(1, std::memory_order_relaxed);
+        add(local, static_cast<int64_t>(bytes));
+    }
+
+    void on_deallocate(size_t slot, size_t bytes) {
+        add(locals_[slot], -static_cast<int64_t>(bytes));
+    }
+
+    int64_t bytes_in_use() const {
+        int64_t total = flushed_.load(std::memory_order_relaxed);
+        for (const Local& local : locals_) total += local.pending.load(std::memory_order_relaxed);
+        raise_high_water(total);
+        return total;
+    }
+
+    int64_t high_water_mark() const {
+        return std::max(high_water_.load(std::memory_order_relaxed), bytes_in_use());
+    }
+
+    size_t allocations() const {
+        size_t total = 0;
+        for (const Local& local : locals_) total += local.allocations.load(std::memory_order_relaxed);
+        return total;
+    }
+
+private:
+    struct alignas(64) Local {
+        std::atomic<int64_t> pending{0};
+        std::atomic<size_t> allocations{0};
+    };
+
+    std::array<Local, ThreadSlot::kMaxThreads + 1> locals_;
+    std::atomic<int64_t> flushed_{0};
+    mutable std::atomic<int64_t> high_water_{0};
+
+    void raise_high_water(int64_t total) const {
+        int64_t high = high_water_.load(std::memory_order_relaxed);
+        while (total > high && !high_water_.compare_exchange_weak(high, total,
+                                                                 std::memory_order_relaxed)) {}
+    }
+
+    void add(Local& local, int64_t delta) {
+        int64_t pending = local.pending.fetch_add(delta, std::memory_order_relaxed) + delta;
+        if (pending >= kFlushBytes || pending <= -kFlushBytes) {
+            local.pending.fetch_sub(pending, std::memory_order_relaxed);
+            int64_t total = flushed_.fetch_add(pending, std::memory_order_relaxed) + pending;
+            raise_high_water(total);
+        }
+    }
+};
+
+// =============================================================================
+// 2. FIXED-SIZE BLOCK POOL
+// =============================================================================
+
+// Blocks are carved from 64 KiB slabs aligned to their own size, so the
+// owning heap of any block is found by masking its address. Frees from the
+// owning thread go onto a plain local free list; frees from other threads
+// are pushed onto the owner's lock-free remote list, which the owner takes
+// in one exchange() when its local list runs dry (no ABA: only the owner pops).
+class FixedBlockPool {
+public:
+    static constexpr size_t kSlabSize = 64 * 1024;
+    static constexpr size_t kBlockAlignment = alignof(std::max_align_t);
+
+    explicit FixedBlockPool(size_t block_size, AllocationStats* stats = nullptr)
+        : block_size_(round_up(std::max(block_size, sizeof(Block)), kBlockAlignment)),
+          stats_(stats) {}
+
+    FixedBlockPool(const FixedBlockPool&) = delete;
+    FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+
+    ~FixedBlockPool() {
+        for (Heap& heap : heaps_) {
+            for (void* slab : heap.slabs) std::free(slab);
+        }
+    }
+
+    size_t block_size() const { return block_size_; }
+
+    void* allocate() {
+        size_t slot = ThreadSlot::current();
+        Heap& heap = heaps_[slot];
+
+        std::unique_lock<std::mutex> lock(shared_heap_mutex_, std::defer_lock);
+        if (slot == ThreadSlot::kSharedSlot) lock.lock();
+
+        if (!heap.local_free) {
+            heap.local_free = heap.remote_free.exchange(nullptr, std::memory_order_acquire);
+            if (!heap.local_free) carve_slab(heap);
+        }
+
+        Block* block = heap.local_free;
+        heap.local_free = block->next;
+        if (stats_) stats_->on_allocate(slot, block_size_);
+        return block;
+    }
+
+    void deallocate(void* ptr) {
+        size_t slot = ThreadSlot::current();
+        Block* block = static_cast<Block*>(ptr);
+        Heap* owner = slab_of(ptr)->owner;
+        if (stats_) stats_->on_deallocate(slot, block_size_);
+
+        if (owner == &heaps_[slot]) {
+            std::unique_lock<std::mutex> lock(shared_heap_mutex_, std::defer_lock);
+            if (slot == ThreadSlot::kSharedSlot) lock.lock();
+            block->next = owner->local_free;
+            owner->local_free = block;
+            return;
+        }
+
+        // Cross-thread free: MPSC push onto the owner's remote list
+        Block* head = owner->remote_free.load(std::memory_order_relaxed);
+        do {
+            block->next = head;
+        } while (!owner->remote_free.compare_exchange_weak(head, block, std::memory_order_release,
+                                                           std::memory_order_relaxed));
+    }
+
+private:
+    struct Block {
+        Block* next;
+    };
+
+    struct Heap;
+
+    struct SlabHeader {
+        Heap* owner;
+    };
+
+    struct alignas(64) Heap {
+        Block* local_free = nullptr;            // Owning thread only
+        std::vector<void*> slabs;               // Owning thread only
+        alignas(64) std::atomic<Block*> remote_free{nullptr};
+    };
+
+    const size_t block_size_;
+    AllocationStats* stats_;
+    std::array<Heap, ThreadSlot::kMaxThreads + 1> heaps_;
+    std::mutex shared_heap_mutex_;  // Only for threads that did not get a slot
+
+    static size_t round_up(size_t n, size_t alignment) {
+        return (n + alignment - 1) & ~(alignment - 1);
+    }
+
+    static SlabHeader* slab_of(void* ptr) {
+        return reinterpret_cast<SlabHeader*>(reinterpret_cast<uintptr_t>(ptr) & ~(kSlabSize - 1));
+    }
+
+    void carve_slab(Heap& heap) {
+        void* slab = std::aligned_alloc(kSlabSize, kSlabSize);
+        if (!slab) throw std::bad_alloc();
+        heap.slabs.push_back(slab);
+        static_cast<SlabHeader*>(slab)->owner = &heap;
+
+        char* begin = static_cast<char*>(slab) + round_up(sizeof(SlabHeader), kBlockAlignment);
+        char* end = static_cast<char*>(slab) + kSlabSize;
+        Block* head = nullptr;
+        for (char* p = end - block_size_; p >= begin; p -= block_size_) {
+            Block* block = reinterpret_cast<Block*>(p);
+            block->next = head;
+            head = block;
+        }
+        heap.local_free = head;
+    }
+};
+
+// =============================================================================
+// 3. MONOTONIC ARENA
+// =============================================================================
+
+// Per-thread bump allocation out of large chunks. Individual frees (from any
+// thread) are no-ops; release() returns everything at once. Ideal for
+// per-request or per-frame scratch data with a clear end of life.
+class MonotonicArena {
+public:
+    static constexpr size_t kChunkSize = 256 * 1024;
+
+    explicit MonotonicArena(AllocationStats* stats = nullptr) : stats_(stats) {}
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() { release(); }
+
+    void* allocate(size_t bytes, size_t alignment) {
+        size_t slot = ThreadSlot::current();
+        Heap& heap = heaps_[slot];
+
+        std::unique_lock<std::mutex> lock(shared_heap_mutex_, std::defer_lock);
+        if (slot == ThreadSlot::kSharedSlot) lock.lock();
+
+        char* p = align_up(heap.cursor, alignment);
+        if (!heap.cursor || p + bytes > heap.end) {
+            size_t chunk = std::max(kChunkSize, bytes + alignment);
+            char* memory = static_cast<char*>(::operator new(chunk));
+            heap.chunks.push_back(memory);
+            heap.cursor = memory;
+            heap.end = memory + chunk;
+            p = align_up(heap.cursor, alignment);
+        }
+
+        heap.cursor = p + bytes;
+        heap.bytes_allocated += bytes;
+        if (stats_) stats_->on_allocate(slot, bytes);
+        return p;
+    }
+
+    // Not thread-safe: call once no thread uses memory from this arena
+    void release() {
+        for (size_t slot = 0; slot < heaps_.size(); ++slot) {
+            Heap& heap = heaps_[slot];
+            for (char* chunk : heap.chunks) ::operator delete(chunk);
+            heap.chunks.clear();
+            heap.cursor = heap.end = nullptr;
+            if (stats_ && heap.bytes_allocated) stats_->on_deallocate(slot, heap.bytes_allocated);
+            heap.bytes_allocated = 0;
+        }
+    }
+
+private:
+    struct alignas(64) Heap {
+        char* cursor = nullptr;
+        char* end = nullptr;
+        size_t bytes_allocated = 0;
+        std::vector<char*> chunks;
+    };
+
+    AllocationStats* stats_;
+    std::array<Heap, ThreadSlot::kMaxThreads + 1> heaps_;
+    std::mutex shared_heap_mutex_;
+
+    static char* align_up(char* p, size_t alignment) {
+        uintptr_t value = reinterpret_cast<uintptr_t>(p);
+        return reinterpret_cast<char*>((value + alignment - 1) & ~(alignment - 1));
+    }
+};
+
+// =============================================================================
+// 4. std::pmr ADAPTERS
+// =============================================================================
+
+// Size-class front end over FixedBlockPool: 16, 32, ... 1024 bytes.
+// Larger or over-aligned requests go to the upstream resource.
+class PoolResource : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kMinBlock = 16;
+    static constexpr size_t kNumClasses = 7;
+    static constexpr size_t kMaxBlock = kMinBlock << (kNumClasses - 1);
+
+    explicit PoolResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream) {
+        for (size_t i = 0; i < kNumClasses; ++i) {
+            pools_[i] = std::make_unique<FixedBlockPool>(kMinBlock << i, &stats_);
+        }
+    }
+
+    const AllocationStats& stats() const { return stats_; }
+
+private:
+    std::array<std::unique_ptr<FixedBlockPool>, kNumClasses> pools_;
+    std::pmr::memory_resource* upstream_;
+    AllocationStats stats_;
+
+    static size_t class_index(size_t bytes) {
+        size_t index = 0;
+        for (size_t size = kMinBlock; size < bytes; size <<= 1) ++index;
+        return index;
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (bytes > kMaxBlock || alignment > FixedBlockPool::kBlockAlignment) {
+            stats_.on_allocate(ThreadSlot::current(), bytes);
+            return upstream_->allocate(bytes, alignment);
+        }
+        return pools_[class_index(bytes)]->allocate();
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        if (bytes > kMaxBlock || alignment > FixedBlockPool::kBlockAlignment) {
+            stats_.on_deallocate(ThreadSlot::current(), bytes);
+            upstream_->deallocate(ptr, bytes, alignment);
+            return;
+        }
+        pools_[class_index(bytes)]->deallocate(ptr);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+class ArenaResource : public std::pmr::memory_resource {
+public:
+    ArenaResource() : arena_(&stats_) {}
+
+    void release() { arena_.release(); }
+    const AllocationStats& stats() const { return stats_; }
+
+private:
+    AllocationStats stats_;
+    MonotonicArena arena_;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        return arena_.allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+void printStats(const char* label, const AllocationStats& stats) {
+    std::cout << label << ": in use " << stats.bytes_in_use() << " bytes, high-water "
+              << stats.high_water_mark() << " bytes, " << stats.allocations() << " allocations\n";
+}
+
+// =============================================================================
+// 5. DEMONSTRATIONS
+// =============================================================================
+
+void demonstratePoolResource() {
+    std::cout << "\n========== POOL RESOURCE WITH PMR CONTAINERS ==========\n";
+
+    PoolResource pool;
+    {
+        std::pmr::list<std::pmr::string> names(&pool);
+        for (int i = 0; i < 1000; ++i) {
+            names.emplace_back("a string long enough to need a heap buffer #" + std::to_string(i));
+        }
+        std::pmr::vector<int> numbers(&pool);
+        for (int i = 0; i < 100; ++i) numbers.push_back(i);
+
+        std::cout << "list nodes and strings share the pool (strings inherit the allocator)\n";
+        printStats("After filling", pool.stats());
+    }
+    printStats("After destruction", pool.stats());
+}
+
+// Same shape as the Node in smart_pointers.cpp, but nodes come from the pool
+struct ListNode {
+    std::string data;
+    std::shared_ptr<ListNode> next;
+
+    explicit ListNode(std::string d) : data(std::move(d)) {}
+};
+
+void demonstratePooledSharedNodes() {
+    std::cout << "\n========== POOLED shared_ptr NODES ==========\n";
+
+    PoolResource pool;
+    std::pmr::polymorphic_allocator<ListNode> alloc(&pool);
+    {
+        // allocate_shared puts the control block and the node in one pool block
+        std::shared_ptr<ListNode> head;
+        for (int i = 0; i < 5; ++i) {
+            auto node = std::allocate_shared<ListNode>(alloc, "node" + std::to_string(i));
+            node->next = head;
+            head = node;
+        }
+        std::cout << "List:";
+        for (auto n = head; n; n = n->next) std::cout << " " << n->data;
+        std::cout << "\n";
+        printStats("Pool with 5 nodes", pool.stats());
+    }
+    printStats("After list released", pool.stats());
+}
+
+void demonstrateCrossThreadFree() {
+    std::cout << "\n========== CROSS-THREAD FREE ==========\n";
+
+    AllocationStats stats;
+    FixedBlockPool pool(64, &stats);
+    const int num_blocks = 100000;
+
+    // Producer allocates, consumer frees: blocks travel back to the
+    // producer's heap through its remote free list, without a lock
+    std::vector<void*> handoff(num_blocks);
+    std::thread producer([&] {
+        for (int i = 0; i < num_blocks; ++i) handoff[i] = pool.allocate();
+    });
+    producer.join();
+    printStats("After producer", stats);
+
+    std::thread consumer([&] {
+        for (void* block : handoff) pool.deallocate(block);
+    });
+    consumer.join();
+    printStats("After consumer freed everything", stats);
+}
+
+void demonstrateArena() {
+    std::cout << "\n========== MONOTONIC ARENA FOR REQUEST SCRATCH ==========\n";
+
+    ArenaResource arena;
+    for (int request = 0; request < 3; ++request) {
+        std::pmr::vector<std::pmr::string> tokens(&arena);
+        for (int i = 0; i < 200; ++i) {
+            tokens.emplace_back("token-with-some-payload-" + std::to_string(i));
+        }
+        std::cout << "Request " << request << " parsed " << tokens.size() << " tokens, ";
+        printStats("arena", arena.stats());
+        tokens = std::pmr::vector<std::pmr::string>(&arena);
+        arena.release();  // One call frees everything the request allocated
+    }
+    printStats("After last release", arena.stats());
+}
+
+// A task queue whose nodes come from the pool: pmr containers make the
+// queue storage allocator-aware without changing the queue's logic
+void demonstratePooledTaskQueue() {
+    std::cout << "\n========== POOL-BACKED TASK QUEUE ==========\n";
+
+    struct Task {
+        int id;
+        std::pmr::string payload;
+    };
+
+    PoolResource pool;
+    std::pmr::deque<Task> queue(&pool);
+    std::mutex mutex;
+    std::atomic<bool> done{false};
+    std::atomic<int> processed{0};
+
+    std::thread worker([&] {
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (queue.empty()) {
+                if (done.load()) return;
+                lock.unlock();
+                std::this_thread::yield();
+                continue;
+            }
+            Task task = std::move(queue.front());
+            queue.pop_front();
+            lock.unlock();
+            processed.fetch_add(1);
+        }
+    });
+
+    for (int i = 0; i < 10000; ++i) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(Task{i, std::pmr::string("payload that does not fit in SSO " +
+                                                 std::to_string(i), &pool)});
+    }
+    done.store(true);
+    worker.join();
+
+    std::cout << "Processed " << processed.load() << " tasks\n";
+    printStats("Task queue pool", pool.stats());
+}
+
+void benchmarkAllocatorScaling() {
+    std::cout << "\n========== ALLOCATOR SCALING ==========\n";
+
+    const int rounds = 2000;
+    const int batch = 64;
+
+    auto run = [&](int num_threads, auto&& alloc, auto&& free) {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&] {
+                void* blocks[batch];
+                for (int r = 0; r < rounds; ++r) {
+                    for (int i = 0; i < batch; ++i) blocks[i] = alloc();
+                    for (int i = 0; i < batch; ++i) free(blocks[i]);
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+        double seconds = std::chrono::duration<double>(
+            std::chrono::high_resolution_clock::now() - start).count();
+        return static_cast<double>(num_threads) * rounds * batch / seconds / 1e6;
+    };
+
+    for (int threads : {1, 2, 4, 8}) {
+        double heap_rate = run(threads, [] { return ::operator new(64); },
+                               [](void* p) { ::operator delete(p); });
+
+        std::pmr::synchronized_pool_resource synchronized;
+        double sync_rate = run(threads, [&] { return synchronized.allocate(64); },
+                               [&](void* p) { synchronized.deallocate(p, 64); });
+
+        PoolResource pool;
+        double pool_rate = run(threads, [&] { return pool.allocate(64); },
+                               [&](void* p) { pool.deallocate(p, 64); });
+
+        std::cout << threads << " threads: new/delete " << heap_rate
+                  << " M ops/s, synchronized_pool_resource " << sync_rate
+                  << " M ops/s, PoolResource " << pool_rate << " M ops/s\n";
+    }
+}
+
+int main() {
+    std::cout << "PER-THREAD POOL AND ARENA ALLOCATORS\n";
+    std::cout << "====================================\n";
+
+    demonstratePoolResource();
+    demonstratePooledSharedNodes();
+    demonstrateCrossThreadFree();
+    demonstrateArena();
+    demonstratePooledTaskQueue();
+    benchmarkAllocatorScaling();
+
+    std::cout << "\n========== SUMMARY ==========\n";
+    std::cout << "1. Fixed-size pools make node allocation a pointer pop\n";
+    std::cout << "2. Per-thread heaps remove allocator contention\n";
+    std::cout << "3. Cross-thread frees go to the owner's lock-free remote list\n";
+    std::cout << "4. Monotonic arenas trade individual frees for one bulk release\n";
+    std::cout << "5. std::pmr::memory_resource lets any container use them\n";
+    std::cout << "6. Sharded counters give in-use and high-water stats cheaply\n";
+
+    return 0;
+}
+
+/*
+How to build and run (Linux):
+
+  g++ -std=c++17 -Wall -Wextra -O2 -pthread "Features/5. allocators.cpp" -o allocators_demo
+  ./allocators_demo
+
+What you'll see:
+  - pmr containers whose nodes and strings come from the pool, with
+    in-use bytes returning to zero when they are destroyed
+  - Blocks allocated on one thread and freed on another
+  - An arena recycled between "requests" with a single release()
+  - Allocation throughput for new/delete, synchronized_pool_resource and
+    PoolResource as the thread count grows
+*/